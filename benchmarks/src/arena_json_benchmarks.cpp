@@ -0,0 +1,80 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Compares parsing and destroying a json with parsing and destroying an arena_json
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/arena_json.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_document(std::size_t count)
+    {
+        std::string s = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s.append(R"({"id":)");
+            s.append(std::to_string(i));
+            s.append(R"(,"name":"A name long enough to be stored on the heap","price":)");
+            s.append(std::to_string(i % 100));
+            s.append(R"(.25,"tags":["first","second","third"],"location":{"latitude":51.5,"longitude":-0.12}})");
+        }
+        s.push_back(']');
+        return s;
+    }
+
+    struct timings
+    {
+        double parse = 0;
+        double destroy = 0;
+    };
+
+    template <class Doc, class Parse>
+    timings measure(const std::string& s, std::size_t iterations, Parse parse)
+    {
+        timings t;
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Doc> docs;
+            docs.push_back(parse(s));
+            auto parsed = std::chrono::steady_clock::now();
+            docs.clear();
+            auto destroyed = std::chrono::steady_clock::now();
+            t.parse += std::chrono::duration<double,std::milli>(parsed - start).count();
+            t.destroy += std::chrono::duration<double,std::milli>(destroyed - parsed).count();
+        }
+        t.parse /= iterations;
+        t.destroy /= iterations;
+        return t;
+    }
+
+    void run(const std::string& name, std::size_t count, std::size_t iterations)
+    {
+        std::string s = make_document(count);
+
+        timings j = measure<json>(s, iterations, [](const std::string& text) {return json::parse(text);});
+        timings a = measure<arena_json>(s, iterations, [](const std::string& text) {return arena_json::parse(text);});
+
+        std::cout << name << " (" << s.size()/1024 << " KB, " << iterations << " iterations)\n";
+        std::cout << "    json:       parse " << j.parse << " ms, destroy " << j.destroy << " ms\n";
+        std::cout << "    arena_json: parse " << a.parse << " ms, destroy " << a.destroy << " ms\n";
+    }
+}
+
+int main()
+{
+    run("small", 10, 20000);
+    run("medium", 1000, 200);
+    run("large", 100000, 5);
+}
@@ -0,0 +1,81 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Measures decoding CBOR and MessagePack into a json, with and without the decoder
+// reserving room for the announced lengths of arrays and maps
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_document(std::size_t count)
+    {
+        json doc(json_object_arg);
+        json readings(json_array_arg);
+        readings.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json reading(json_object_arg);
+            reading.try_emplace("id", i);
+            reading.try_emplace("value", 0.5 + static_cast<double>(i % 1000));
+            reading.try_emplace("position", json(json_array_arg, {json(i % 90), json(i % 180)}));
+            readings.push_back(std::move(reading));
+        }
+        doc.try_emplace("samples", std::vector<double>(count, 1.5));
+        doc.try_emplace("readings", std::move(readings));
+        return doc;
+    }
+
+    template <class Reader>
+    double measure(const std::vector<uint8_t>& data, std::size_t max_length_hint, std::size_t iterations)
+    {
+        double total = 0;
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            json_decoder<json> decoder;
+            decoder.max_length_hint(max_length_hint);
+            Reader reader(data, decoder);
+            reader.read();
+            json j = decoder.get_result();
+            auto end = std::chrono::steady_clock::now();
+            total += std::chrono::duration<double,std::milli>(end - start).count();
+        }
+        return total/iterations;
+    }
+
+    void run(const std::string& name, std::size_t count, std::size_t iterations)
+    {
+        json doc = make_document(count);
+
+        std::vector<uint8_t> cbor_data;
+        cbor::encode_cbor(doc, cbor_data);
+        std::vector<uint8_t> msgpack_data;
+        msgpack::encode_msgpack(doc, msgpack_data);
+
+        std::size_t hint = json_decoder<json>::default_max_length_hint;
+        double cbor_ignored = measure<cbor::cbor_bytes_reader>(cbor_data, 0, iterations);
+        double cbor_reserved = measure<cbor::cbor_bytes_reader>(cbor_data, hint, iterations);
+        double msgpack_ignored = measure<msgpack::msgpack_bytes_reader>(msgpack_data, 0, iterations);
+        double msgpack_reserved = measure<msgpack::msgpack_bytes_reader>(msgpack_data, hint, iterations);
+
+        std::cout << name << " (" << cbor_data.size()/1024 << " KB CBOR, " << iterations << " iterations)\n";
+        std::cout << "    cbor:    lengths ignored " << cbor_ignored << " ms, reserved " << cbor_reserved << " ms\n";
+        std::cout << "    msgpack: lengths ignored " << msgpack_ignored << " ms, reserved " << msgpack_reserved << " ms\n";
+    }
+}
+
+int main()
+{
+    run("small", 100, 2000);
+    run("medium", 10000, 50);
+    run("large", 500000, 3);
+}
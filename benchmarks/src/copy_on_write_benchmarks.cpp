@@ -0,0 +1,76 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Measures handing copies of a parsed document to several readers, and modifying one member
+// of each copy, with json and with copy_on_write_policy
+
+#include <jsoncons/json.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>>;
+
+    std::string make_input(std::size_t count)
+    {
+        json doc(json_object_arg);
+        json records(json_array_arg);
+        records.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json record(json_object_arg);
+            record.try_emplace("id", i);
+            record.try_emplace("name", "record " + std::to_string(i));
+            record.try_emplace("position", json(json_array_arg, {json(i % 90), json(i % 180)}));
+            records.push_back(std::move(record));
+        }
+        doc.try_emplace("version", 1);
+        doc.try_emplace("records", std::move(records));
+        return doc.to_string();
+    }
+
+    template <class Json>
+    void run(const std::string& name, const std::string& input, std::size_t consumers)
+    {
+        Json doc = Json::parse(input);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Json> copies;
+        for (std::size_t i = 0; i < consumers; ++i)
+        {
+            copies.push_back(doc);
+        }
+        auto copied = std::chrono::steady_clock::now();
+
+        std::size_t total = 0;
+        for (const auto& copy : copies)
+        {
+            total += copy.at("records").size();
+        }
+        auto read = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < consumers; ++i)
+        {
+            copies[i]["version"] = i;
+        }
+        auto modified = std::chrono::steady_clock::now();
+
+        std::cout << name << ": copy " << std::chrono::duration<double,std::milli>(copied - start).count() << " ms, "
+                  << "read " << std::chrono::duration<double,std::milli>(read - copied).count() << " ms, "
+                  << "modify " << std::chrono::duration<double,std::milli>(modified - read).count() << " ms"
+                  << " (" << total << " records)\n";
+    }
+}
+
+int main()
+{
+    std::string input = make_input(100000);
+    std::cout << "Document of " << input.size()/1024 << " KB, 16 copies\n";
+    run<json>("json", input, 16);
+    run<cow_json>("copy_on_write_policy", input, 16);
+}
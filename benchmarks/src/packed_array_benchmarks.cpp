@@ -0,0 +1,111 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Measures decoding a CBOR typed array and a JSON array of doubles, summing the numbers,
+// and the memory taken by the decoded array, as an array of json values and as a packed array
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    double sum_of(const json& j)
+    {
+        double sum = 0;
+        if (j.storage_kind() == json_storage_kind::packed_array_value)
+        {
+            for (double x : j.as_typed_array_view().data(double_array_arg))
+            {
+                sum += x;
+            }
+        }
+        else
+        {
+            for (const auto& item : j.array_range())
+            {
+                sum += item.as<double>();
+            }
+        }
+        return sum;
+    }
+
+    void report(const std::string& name, const json& j,
+                std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point decoded,
+                std::chrono::steady_clock::time_point summed,
+                double sum)
+    {
+        std::size_t bytes = j.storage_kind() == json_storage_kind::packed_array_value
+            ? j.size()*sizeof(double) : j.size()*sizeof(json);
+        std::cout << name << ": decode " << std::chrono::duration<double,std::milli>(decoded - start).count() << " ms, "
+                  << "sum " << std::chrono::duration<double,std::milli>(summed - decoded).count() << " ms, "
+                  << "elements " << bytes/1024 << " KB (" << sum << ")\n";
+    }
+
+    void run_cbor(const std::vector<double>& values)
+    {
+        std::vector<uint8_t> typed;
+        cbor::cbor_options options;
+        options.use_typed_arrays(true);
+        cbor::encode_cbor(values, typed, options);
+
+        std::vector<uint8_t> untyped;
+        cbor::encode_cbor(values, untyped);
+
+        auto start = std::chrono::steady_clock::now();
+        json j = cbor::decode_cbor<json>(untyped);
+        auto decoded = std::chrono::steady_clock::now();
+        double sum = sum_of(j);
+        auto summed = std::chrono::steady_clock::now();
+        report("CBOR array", j, start, decoded, summed, sum);
+
+        start = std::chrono::steady_clock::now();
+        j = cbor::decode_cbor<json>(typed);
+        decoded = std::chrono::steady_clock::now();
+        sum = sum_of(j);
+        summed = std::chrono::steady_clock::now();
+        report("CBOR typed array", j, start, decoded, summed, sum);
+    }
+
+    void run_json(const std::vector<double>& values)
+    {
+        std::string input;
+        encode_json(values, input);
+
+        auto start = std::chrono::steady_clock::now();
+        json j = json::parse(input);
+        auto decoded = std::chrono::steady_clock::now();
+        double sum = sum_of(j);
+        auto summed = std::chrono::steady_clock::now();
+        report("JSON array", j, start, decoded, summed, sum);
+
+        json_options options;
+        options.min_packed_array_length(16);
+        start = std::chrono::steady_clock::now();
+        j = json::parse(input, options);
+        decoded = std::chrono::steady_clock::now();
+        sum = sum_of(j);
+        summed = std::chrono::steady_clock::now();
+        report("JSON array, min_packed_array_length(16)", j, start, decoded, summed, sum);
+    }
+}
+
+int main()
+{
+    std::vector<double> values;
+    values.reserve(1000000);
+    for (std::size_t i = 0; i < 1000000; ++i)
+    {
+        values.push_back(static_cast<double>(i) * 0.5);
+    }
+    std::cout << values.size() << " doubles\n";
+    run_cbor(values);
+    run_json(values);
+}
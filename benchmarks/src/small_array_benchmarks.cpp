@@ -0,0 +1,81 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Compares parsing and destroying GeoJSON-like coordinates with json and with small_array_policy
+
+#include <jsoncons/json.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using small_array_json = basic_json<char,small_array_policy<sorted_policy,2>>;
+
+    std::string make_document(std::size_t count)
+    {
+        std::string s = R"({"type":"LineString","coordinates":[)";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s.push_back('[');
+            s.append(std::to_string(100 + i % 80));
+            s.append(".25,");
+            s.append(std::to_string(i % 60));
+            s.append(".5]");
+        }
+        s.append("]}");
+        return s;
+    }
+
+    struct timings
+    {
+        double parse = 0;
+        double destroy = 0;
+    };
+
+    template <class Json>
+    timings measure(const std::string& s, std::size_t iterations)
+    {
+        timings t;
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<Json> docs;
+            docs.push_back(Json::parse(s));
+            auto parsed = std::chrono::steady_clock::now();
+            docs.clear();
+            auto destroyed = std::chrono::steady_clock::now();
+            t.parse += std::chrono::duration<double,std::milli>(parsed - start).count();
+            t.destroy += std::chrono::duration<double,std::milli>(destroyed - parsed).count();
+        }
+        t.parse /= iterations;
+        t.destroy /= iterations;
+        return t;
+    }
+
+    void run(const std::string& name, std::size_t count, std::size_t iterations)
+    {
+        std::string s = make_document(count);
+
+        timings j = measure<json>(s, iterations);
+        timings a = measure<small_array_json>(s, iterations);
+
+        std::cout << name << " (" << s.size()/1024 << " KB, " << iterations << " iterations)\n";
+        std::cout << "    json:                     parse " << j.parse << " ms, destroy " << j.destroy << " ms\n";
+        std::cout << "    small_array_policy<..,2>: parse " << a.parse << " ms, destroy " << a.destroy << " ms\n";
+    }
+}
+
+int main()
+{
+    run("small", 100, 20000);
+    run("medium", 10000, 200);
+    run("large", 1000000, 3);
+}
@@ -0,0 +1,70 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Compares the scalar unicode_traits::validate with the vectorized detail::fast_validate
+
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_text(std::size_t length, const std::string& unit)
+    {
+        std::string s;
+        s.reserve(length + unit.size());
+        while (s.size() < length)
+        {
+            s.append(unit);
+        }
+        return s;
+    }
+
+    template <class F>
+    double measure(const std::string& s, std::size_t iterations, F f)
+    {
+        std::size_t valid = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            if (f(s))
+            {
+                ++valid;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (valid != iterations)
+        {
+            std::cerr << "unexpected validation failure\n";
+        }
+        return static_cast<double>(s.size()) * static_cast<double>(iterations) / seconds / (1024.0 * 1024.0 * 1024.0);
+    }
+
+    void run(const std::string& name, const std::string& s, std::size_t iterations)
+    {
+        double scalar = measure(s, iterations, [](const std::string& text) 
+        {
+            return unicode_traits::validate(text.data(), text.size()).ec == unicode_traits::conv_errc();
+        });
+        double fast = measure(s, iterations, [](const std::string& text) 
+        {
+            return jsoncons::detail::fast_validate(text.data(), text.size()).ec == unicode_traits::conv_errc();
+        });
+        std::cout << name << ": scalar " << scalar << " GB/s, fast_validate " << fast << " GB/s\n";
+    }
+}
+
+int main()
+{
+    const std::size_t length = 1024 * 1024;
+    run("ascii", make_text(length, "The quick brown fox jumps over the lazy dog. "), 200);
+    run("latin", make_text(length, "Fran\xC3\xA7ois a \xC3\xA9t\xC3\xA9 \xC3\xA0 la plage. "), 200);
+    run("cjk", make_text(length, "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87\xE7\xAB\xA0"), 200);
+    run("emoji", make_text(length, "\xF0\x9F\x98\x80\xF0\x9F\x8E\x89 ok "), 200);
+    run("short strings", make_text(24, "key_name"), 2000000);
+}
@@ -0,0 +1,76 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+// Measures building and looking up members of objects with many members, json and ojson
+
+#include <jsoncons/json.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct timings
+    {
+        double build = 0;
+        double lookup = 0;
+    };
+
+    template <class Json>
+    timings measure(const std::vector<std::string>& keys, std::size_t iterations)
+    {
+        timings t;
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            Json doc;
+            for (std::size_t j = 0; j < keys.size(); ++j)
+            {
+                doc.insert_or_assign(keys[j], j);
+            }
+            auto built = std::chrono::steady_clock::now();
+            for (const auto& key : keys)
+            {
+                found += doc.at(key).template as<std::size_t>() < keys.size() ? 1 : 0;
+            }
+            auto looked_up = std::chrono::steady_clock::now();
+            t.build += std::chrono::duration<double,std::milli>(built - start).count();
+            t.lookup += std::chrono::duration<double,std::milli>(looked_up - built).count();
+        }
+        if (found != keys.size()*iterations)
+        {
+            std::cout << "Unexpected lookup count\n";
+        }
+        t.build /= iterations;
+        t.lookup /= iterations;
+        return t;
+    }
+
+    void run(std::size_t count, std::size_t iterations)
+    {
+        std::vector<std::string> keys;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            keys.push_back("setting." + std::to_string(i*7919 % 100003));
+        }
+
+        timings j = measure<json>(keys, iterations);
+        timings o = measure<ojson>(keys, iterations);
+
+        std::cout << count << " members (" << iterations << " iterations)\n";
+        std::cout << "    json:  build " << j.build << " ms, lookup " << j.lookup << " ms\n";
+        std::cout << "    ojson: build " << o.build << " ms, lookup " << o.lookup << " ms\n";
+    }
+}
+
+int main()
+{
+    run(10, 100000);
+    run(100, 10000);
+    run(1000, 1000);
+    run(10000, 20);
+}
@@ -0,0 +1,328 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_JSON_HPP
+#define JSONCONS_ARENA_JSON_HPP
+
+#include <algorithm> // std::max
+#include <cstddef>
+#include <cstdint>
+#include <istream> // std::basic_istream
+#include <limits> // std::numeric_limits
+#include <memory> // std::unique_ptr
+#include <new> // std::bad_alloc
+#include <scoped_allocator>
+#include <type_traits>
+#include <utility> // std::move
+#include <jsoncons/allocator_set.hpp>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_options.hpp>
+
+namespace jsoncons {
+
+    // json_arena
+    // A monotonic arena. Allocations are carved out of blocks obtained from operator new, are never
+    // freed one at a time, and are all released together when the arena is released or destroyed.
+
+    class json_arena
+    {
+        struct block_header
+        {
+            block_header* next;
+        };
+
+        block_header* blocks_;
+        char* current_;
+        char* end_;
+        std::size_t next_block_size_;
+        std::size_t bytes_used_;
+        std::size_t bytes_reserved_;
+
+        static constexpr std::size_t max_block_size = 1024*1024;
+
+        // Noncopyable and nonmoveable, allocators refer to it
+        json_arena(const json_arena&) = delete;
+        json_arena& operator=(const json_arena&) = delete;
+    public:
+        explicit json_arena(std::size_t initial_block_size = 4096) noexcept
+            : blocks_(nullptr), current_(nullptr), end_(nullptr),
+              next_block_size_((std::max)(initial_block_size, std::size_t(256))),
+              bytes_used_(0), bytes_reserved_(0)
+        {
+        }
+
+        ~json_arena() noexcept
+        {
+            release();
+        }
+
+        void* allocate(std::size_t size, std::size_t alignment)
+        {
+            std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(current_) % alignment) % alignment;
+            if (current_ == nullptr || std::size_t(end_ - current_) < size + padding)
+            {
+                add_block(size + alignment);
+                padding = (alignment - reinterpret_cast<std::uintptr_t>(current_) % alignment) % alignment;
+            }
+            char* p = current_ + padding;
+            current_ = p + size;
+            bytes_used_ += size;
+            return p;
+        }
+
+        // Frees every block at once
+        void release() noexcept
+        {
+            while (blocks_ != nullptr)
+            {
+                block_header* next = blocks_->next;
+                ::operator delete(blocks_);
+                blocks_ = next;
+            }
+            current_ = end_ = nullptr;
+            bytes_used_ = 0;
+            bytes_reserved_ = 0;
+        }
+
+        // Number of bytes handed out by allocate
+        std::size_t bytes_used() const noexcept
+        {
+            return bytes_used_;
+        }
+
+        // Number of bytes obtained from operator new
+        std::size_t bytes_reserved() const noexcept
+        {
+            return bytes_reserved_;
+        }
+
+    private:
+        void add_block(std::size_t min_size)
+        {
+            // Blocks double in size up to max_block_size, a larger request gets a block of its own size.
+            // A first block larger than max_block_size is followed by blocks of max_block_size.
+            std::size_t size = (std::max)(next_block_size_, min_size);
+            if (size > (std::numeric_limits<std::size_t>::max)() - sizeof(block_header))
+            {
+                JSONCONS_THROW(std::bad_alloc());
+            }
+            void* p = ::operator new(sizeof(block_header) + size);
+            block_header* block = static_cast<block_header*>(p);
+            block->next = blocks_;
+            blocks_ = block;
+            current_ = reinterpret_cast<char*>(block + 1);
+            end_ = current_ + size;
+            bytes_reserved_ += sizeof(block_header) + size;
+            next_block_size_ = next_block_size_ < max_block_size/2 ? next_block_size_*2 : std::size_t(max_block_size);
+        }
+    };
+
+    // arena_allocator
+    // A stateful allocator that allocates from a json_arena and never deallocates. Allocators
+    // compare equal when they refer to the same arena. A default constructed allocator, as returned by
+    // get_allocator() for a scalar basic_json, refers to no arena and throws std::bad_alloc if asked to allocate.
+
+    template <class T>
+    class arena_allocator
+    {
+        template <class U> friend class arena_allocator;
+
+        json_arena* arena_;
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <class U>
+        struct rebind
+        {
+            using other = arena_allocator<U>;
+        };
+
+        arena_allocator() noexcept
+            : arena_(nullptr)
+        {
+        }
+
+        explicit arena_allocator(json_arena& arena) noexcept
+            : arena_(std::addressof(arena))
+        {
+        }
+
+        arena_allocator(const arena_allocator&) noexcept = default;
+
+        template <class U>
+        arena_allocator(const arena_allocator<U>& other) noexcept
+            : arena_(other.arena_)
+        {
+        }
+
+        arena_allocator& operator=(const arena_allocator&) noexcept = default;
+
+        T* allocate(size_type n)
+        {
+            if (arena_ == nullptr || n > (std::numeric_limits<size_type>::max)()/sizeof(T))
+            {
+                JSONCONS_THROW(std::bad_alloc());
+            }
+            return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_type) noexcept
+        {
+        }
+
+        // The arena, or null for a default constructed allocator
+        json_arena* arena() const noexcept
+        {
+            return arena_;
+        }
+
+        template <class U>
+        friend bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+        {
+            return lhs.arena() == rhs.arena();
+        }
+
+        template <class U>
+        friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    // basic_arena_json
+    // Owns an arena and a basic_json value whose arrays, objects, member names, long strings
+    // and byte strings are all allocated from it. The decoder builds the value directly in the arena,
+    // and destroying the document releases the arena's blocks without visiting the value.
+
+    template <class CharT,class Policy=sorted_policy>
+    class basic_arena_json
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = std::scoped_allocator_adaptor<arena_allocator<char>>;
+        using value_type = basic_json<CharT,Policy,allocator_type>;
+        using string_view_type = jsoncons::basic_string_view<CharT>;
+    private:
+        std::unique_ptr<json_arena> arena_;
+        value_type* root_;
+
+        basic_arena_json(std::size_t initial_block_size, std::nullptr_t)
+            : arena_(new json_arena(initial_block_size)), root_(nullptr)
+        {
+        }
+    public:
+        // An empty object
+        explicit basic_arena_json(std::size_t initial_block_size = 4096)
+            : arena_(new json_arena(initial_block_size)), root_(nullptr)
+        {
+            reset(value_type(json_object_arg, semantic_tag::none, get_allocator()));
+        }
+
+        // The root is never copied out of the arena
+        basic_arena_json(const basic_arena_json&) = delete;
+        basic_arena_json& operator=(const basic_arena_json&) = delete;
+
+        basic_arena_json(basic_arena_json&& other) noexcept
+            : arena_(std::move(other.arena_)), root_(other.root_)
+        {
+            other.root_ = nullptr;
+        }
+
+        basic_arena_json& operator=(basic_arena_json&& other) noexcept
+        {
+            std::swap(arena_, other.arena_);
+            std::swap(root_, other.root_);
+            return *this;
+        }
+
+        // The root is not destroyed, everything it refers to is in the arena
+        ~basic_arena_json() noexcept = default;
+
+        template <class Source>
+        static
+        typename std::enable_if<extension_traits::is_sequence_of<Source,char_type>::value,basic_arena_json>::type
+        parse(const Source& source,
+              const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            // A parsed value usually takes about as much memory as its text, so one block suffices for most documents
+            basic_arena_json doc(source.size()*sizeof(char_type), nullptr);
+            doc.reset(value_type::parse(combine_allocators(doc.get_allocator()), source, options));
+            return doc;
+        }
+
+        static basic_arena_json parse(const char_type* source,
+            const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            return parse(string_view_type(source), options);
+        }
+
+        static basic_arena_json parse(std::basic_istream<char_type>& is,
+            const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            basic_arena_json doc(4096, nullptr);
+            doc.reset(value_type::parse(combine_allocators(doc.get_allocator()), is, options));
+            return doc;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(arena_allocator<char>(*arena_));
+        }
+
+        value_type& root()
+        {
+            return *root_;
+        }
+
+        const value_type& root() const
+        {
+            return *root_;
+        }
+
+        value_type& operator*()
+        {
+            return *root_;
+        }
+
+        const value_type& operator*() const
+        {
+            return *root_;
+        }
+
+        value_type* operator->()
+        {
+            return root_;
+        }
+
+        const value_type* operator->() const
+        {
+            return root_;
+        }
+
+        const json_arena& arena() const
+        {
+            return *arena_;
+        }
+
+    private:
+        // Moves value into arena memory, value must have been allocated from this arena
+        void reset(value_type&& value)
+        {
+            void* p = arena_->allocate(sizeof(value_type), alignof(value_type));
+            root_ = ::new(p) value_type(std::move(value));
+        }
+    };
+
+    using arena_json = basic_arena_json<char,sorted_policy>;
+    using arena_ojson = basic_arena_json<char,order_preserving_policy>;
+    using warena_json = basic_arena_json<wchar_t,sorted_policy>;
+    using warena_ojson = basic_arena_json<wchar_t,order_preserving_policy>;
+
+} // namespace jsoncons
+
+#endif
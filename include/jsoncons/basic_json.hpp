@@ -21,6 +21,7 @@
 #include <utility> // std::move
 #include <type_traits> // std::enable_if
 #include <istream> // std::basic_istream
+#include <unordered_set> // std::unordered_set
 #include <jsoncons/json_fwd.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/config/version.hpp>
@@ -37,8 +38,12 @@
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/byte_string.hpp>
 #include <jsoncons/json_error.hpp>
+#include <jsoncons/json_memory_stats.hpp>
 #include <jsoncons/allocator_set.hpp>
 #include <jsoncons/detail/heap_string.hpp>
+#include <jsoncons/detail/small_vector.hpp>
+#include <jsoncons/detail/cow_vector.hpp>
+#include <jsoncons/detail/packed_array.hpp>
 #if defined(JSONCONS_HAS_POLYMORPHIC_ALLOCATOR)
 #include <memory_resource> // std::poymorphic_allocator
 #endif
@@ -47,12 +52,12 @@ namespace jsoncons {
 
     namespace extension_traits {
 
-        template <class Container>
+        template <class Container,class Json>
         using 
-        container_array_iterator_type_t = decltype(Container::array_iterator_type);
-        template <class Container>
+        container_array_iterator_type_t = typename Container::template array_iterator_type<Json>;
+        template <class Container,class Json>
         using 
-        container_const_array_iterator_type_t = decltype(Container::const_array_iterator_type);
+        container_const_array_iterator_type_t = typename Container::template const_array_iterator_type<Json>;
         template <class Container>
         using 
         container_object_iterator_type_t = decltype(Container::object_iterator_type);
@@ -279,6 +284,76 @@ namespace jsoncons {
         using member_key = std::basic_string<CharT, CharTraits, Allocator>;
     };
 
+    // small_array_policy
+    // Adapts a policy, such as sorted_policy or order_preserving_policy, to keep the elements of arrays 
+    // of up to N elements in the array's own allocation instead of a separate buffer
+
+    template <class Policy, std::size_t N = 4>
+    struct small_array_policy : public Policy
+    {
+        template <class T,class Allocator>
+        using sequence_container = jsoncons::detail::small_vector<T,Allocator,N>;
+
+        template <class Json>
+        using array = json_array<Json,sequence_container>;
+
+        // The elements are inline in the array, so its iterator types are named without instantiating it
+        template <class Json>
+        using array_iterator_type = Json*;
+
+        template <class Json>
+        using const_array_iterator_type = const Json*;
+    };
+
+    // nan_boxed_policy
+    // Adapts a policy, such as sorted_policy or order_preserving_policy, to keep the elements of arrays 
+    // as NaN-boxed 8 byte words when that takes less memory, see basic_json shrink_to_fit and json_decoder
+
+    template <class Policy>
+    struct nan_boxed_policy : public Policy
+    {
+        static constexpr bool nan_boxed_arrays = true;
+    };
+
+namespace detail {
+
+    // The object type Object with its members kept in SequenceContainer
+    template <class Object,template<typename,typename> class SequenceContainer>
+    struct rebind_sequence_container
+    {
+    };
+
+    template <class KeyT,class Json,template<typename,typename> class C,template<typename,typename> class SequenceContainer>
+    struct rebind_sequence_container<sorted_json_object<KeyT,Json,C>,SequenceContainer>
+    {
+        using type = sorted_json_object<KeyT,Json,SequenceContainer>;
+    };
+
+    template <class KeyT,class Json,template<typename,typename> class C,template<typename,typename> class SequenceContainer>
+    struct rebind_sequence_container<order_preserving_json_object<KeyT,Json,C>,SequenceContainer>
+    {
+        using type = order_preserving_json_object<KeyT,Json,SequenceContainer>;
+    };
+
+} // namespace detail
+
+    // copy_on_write_policy
+    // Adapts a policy, such as sorted_policy or order_preserving_policy, so that copies of an array or
+    // object share its elements, and the elements are copied when a copy is first modified
+
+    template <class Policy>
+    struct copy_on_write_policy : public Policy
+    {
+        template <class T,class Allocator>
+        using sequence_container = jsoncons::detail::cow_vector<T,Allocator>;
+
+        template <class KeyT,class Json>
+        using object = typename jsoncons::detail::rebind_sequence_container<typename Policy::template object<KeyT,Json>,sequence_container>::type;
+
+        template <class Json>
+        using array = json_array<Json,sequence_container>;
+    };
+
     template<class Policy, class KeyT,class Json, class Enable=void>
     struct object_iterator_typedefs
     {
@@ -309,8 +384,8 @@ namespace jsoncons {
 
     template<class Policy, class KeyT,class Json>
     struct array_iterator_typedefs<Policy, KeyT, Json, typename std::enable_if<
-        !extension_traits::is_detected<extension_traits::container_array_iterator_type_t, Policy>::value ||
-        !extension_traits::is_detected<extension_traits::container_const_array_iterator_type_t, Policy>::value>::type>
+        !extension_traits::is_detected<extension_traits::container_array_iterator_type_t, Policy, Json>::value ||
+        !extension_traits::is_detected<extension_traits::container_const_array_iterator_type_t, Policy, Json>::value>::type>
     {
         using array_iterator_type = typename Policy::template array<Json>::iterator;
         using const_array_iterator_type = typename Policy::template array<Json>::const_iterator;
@@ -318,8 +393,8 @@ namespace jsoncons {
 
     template<class Policy,class KeyT,class Json>
     struct array_iterator_typedefs<Policy, KeyT, Json, typename std::enable_if<
-        extension_traits::is_detected<extension_traits::container_array_iterator_type_t, Policy>::value &&
-        extension_traits::is_detected<extension_traits::container_const_array_iterator_type_t, Policy>::value>::type>
+        extension_traits::is_detected<extension_traits::container_array_iterator_type_t, Policy, Json>::value &&
+        extension_traits::is_detected<extension_traits::container_const_array_iterator_type_t, Policy, Json>::value>::type>
     {
         using array_iterator_type = typename Policy::template array_iterator_type<Json>;
         using const_array_iterator_type = typename Policy::template const_array_iterator_type<Json>;
@@ -452,6 +527,86 @@ namespace jsoncons {
         using array_range_type = range<array_iterator, const_array_iterator>;
         using const_array_range_type = range<const_array_iterator, const_array_iterator>;
 
+        // const_array_value_iterator
+        // Iterates over the elements of an array by value. An element of a packed array is read in place,
+        // and an element of any other array is returned as a json_const_pointer to it.
+
+        class const_array_value_iterator
+        {
+            class arrow_proxy
+            {
+                basic_json value_;
+            public:
+                explicit arrow_proxy(basic_json&& value)
+                    : value_(std::move(value))
+                {
+                }
+
+                const basic_json* operator->() const
+                {
+                    return std::addressof(value_);
+                }
+            };
+
+            const basic_json* array_;
+            std::size_t index_;
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = basic_json;
+            using difference_type = std::ptrdiff_t;
+            using pointer = arrow_proxy;
+            using reference = basic_json;
+
+            const_array_value_iterator() noexcept
+                : array_(nullptr), index_(0)
+            {
+            }
+
+            const_array_value_iterator(const basic_json* array, std::size_t index) noexcept
+                : array_(array), index_(index)
+            {
+            }
+
+            reference operator*() const
+            {
+                if (array_->storage_kind() == json_storage_kind::packed_array_value)
+                {
+                    return array_->cast<packed_array_storage>().value().value_at(index_);
+                }
+                return basic_json(json_const_pointer_arg, std::addressof(array_->cast<array_storage>().value()[index_]));
+            }
+
+            pointer operator->() const
+            {
+                return arrow_proxy(**this);
+            }
+
+            const_array_value_iterator& operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+
+            const_array_value_iterator operator++(int) noexcept
+            {
+                const_array_value_iterator temp(*this);
+                ++index_;
+                return temp;
+            }
+
+            bool operator==(const const_array_value_iterator& other) const noexcept
+            {
+                return array_ == other.array_ && index_ == other.index_;
+            }
+
+            bool operator!=(const const_array_value_iterator& other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        using const_array_value_range_type = range<const_array_value_iterator, const_array_value_iterator>;
+
     private:
 
         static constexpr uint8_t major_type_shift = 0x04;
@@ -764,6 +919,11 @@ namespace jsoncons {
             {
                 return ptr_->length();
             }
+
+            std::size_t allocated_bytes() const
+            {
+                return heap_string_factory_type::allocation_size(ptr_->length());
+            }
         
             allocator_type get_allocator() const
             {
@@ -885,6 +1045,11 @@ namespace jsoncons {
                 return ptr_->length();
             }
 
+            std::size_t allocated_bytes() const
+            {
+                return heap_string_factory_type::allocation_size(ptr_->length());
+            }
+
             uint64_t ext_tag() const
             {
                 return ptr_->extra();
@@ -1051,6 +1216,158 @@ namespace jsoncons {
             }
         };
 
+        // packed_array_storage
+        // An array of numbers of one type, such as a CBOR typed array, or an array with its elements
+        // kept as NaN-boxed words, in a packed_array.
+        class packed_array_storage final
+        {
+        public:
+            uint8_t storage_kind_:4;
+            uint8_t small_string_length_:4;
+            semantic_tag tag_;
+        private:
+            using packed_array_type = jsoncons::detail::packed_array<basic_json>;
+            using packed_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<packed_array_type>;
+            using pointer = typename std::allocator_traits<packed_allocator>::pointer;
+
+            pointer ptr_;
+
+            template <typename... Args>
+            void create(packed_allocator alloc, Args&& ... args)
+            {
+                ptr_ = std::allocator_traits<packed_allocator>::allocate(alloc, 1);
+                JSONCONS_TRY
+                {
+                    std::allocator_traits<packed_allocator>::construct(alloc, extension_traits::to_plain_pointer(ptr_), 
+                        std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    std::allocator_traits<packed_allocator>::deallocate(alloc, ptr_,1);
+                    JSONCONS_RETHROW;
+                }
+            }
+
+            void destroy() noexcept
+            {
+                packed_allocator alloc(ptr_->get_allocator());
+                std::allocator_traits<packed_allocator>::destroy(alloc, extension_traits::to_plain_pointer(ptr_));
+                std::allocator_traits<packed_allocator>::deallocate(alloc, ptr_,1);
+            }
+        public:
+            template <class... Args>
+            packed_array_storage(semantic_tag tag, const Allocator& alloc, Args&&... args)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::packed_array_value)), small_string_length_(0), tag_(tag)
+            {
+                create(packed_allocator(alloc), std::forward<Args>(args)..., alloc);
+            }
+
+            packed_array_storage(const packed_array_storage& other)
+                : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_)
+            {
+                create(packed_allocator(other.get_allocator()), *(other.ptr_));
+            }
+
+            packed_array_storage(packed_array_storage&& other) noexcept
+                : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_),
+                  ptr_(nullptr)
+            {
+                std::swap(other.ptr_, ptr_);
+
+                other.storage_kind_ = static_cast<uint8_t>(json_storage_kind::null_value);
+                other.small_string_length_ = 0;
+                other.tag_ = semantic_tag::none;
+            }
+
+            packed_array_storage(const packed_array_storage& other, const Allocator& alloc)
+                : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_)
+            {
+                create(packed_allocator(alloc), *(other.ptr_), alloc);
+            }
+
+            packed_array_storage(packed_array_storage&& other, const Allocator& alloc)
+                : storage_kind_(other.storage_kind_), small_string_length_(0), tag_(other.tag_)
+            {
+                if (other.get_allocator() == alloc)
+                {
+                    ptr_ = other.ptr_;
+                    other.ptr_ = nullptr;
+
+                    other.storage_kind_ = static_cast<uint8_t>(json_storage_kind::null_value);
+                    other.tag_ = semantic_tag::none;
+                }
+                else
+                {
+                    create(packed_allocator(alloc), *(other.ptr_), alloc);
+                }
+            }
+
+            ~packed_array_storage() noexcept
+            {
+                if (ptr_ != nullptr)
+                {
+                    destroy();
+                }
+            }
+
+            void assign(const packed_array_storage& other)
+            {
+                assign(std::integral_constant<bool,std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value>(), other);
+            }
+
+            void assign(std::true_type, const packed_array_storage& other)
+            {
+                pointer old = ptr_;
+                create(packed_allocator(other.get_allocator()), *(other.ptr_));
+                std::swap(old, ptr_);
+                destroy();
+                ptr_ = old;
+                tag_ = other.tag_;
+            }
+
+            void assign(std::false_type, const packed_array_storage& other)
+            {
+                auto alloc = get_allocator();
+                pointer old = ptr_;
+                create(packed_allocator(alloc), *(other.ptr_), alloc);
+                std::swap(old, ptr_);
+                destroy();
+                ptr_ = old;
+                tag_ = other.tag_;
+            }
+
+            void assign(packed_array_storage&& other)
+            {
+                swap(other);
+            }
+
+            void swap(packed_array_storage& other)
+            {
+                std::swap(ptr_, other.ptr_);
+                std::swap(tag_, other.tag_);
+            }
+
+            semantic_tag tag() const
+            {
+                return tag_;
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->get_allocator();
+            }
+
+            packed_array_type& value()
+            {
+                return *ptr_;
+            }
+
+            const packed_array_type& value() const
+            {
+                return *ptr_;
+            }
+        };
+
         // object_storage
         class object_storage final
         {
@@ -1231,6 +1548,229 @@ namespace jsoncons {
             }
         };
 
+        // string_view_storage
+        // Refers to characters owned by someone else, such as the buffer passed to parse_insitu.
+        // The characters must be followed by a null terminator and outlive the value.
+        class string_view_storage final
+        {
+        public:
+            uint8_t storage_kind_:4;
+            uint8_t small_string_length_:4;
+            semantic_tag tag_;
+        private:
+            uint32_t length_;
+            const char_type* data_;
+        public:
+            static constexpr std::size_t max_length = (std::numeric_limits<uint32_t>::max)();
+
+            string_view_storage(semantic_tag tag, const char_type* data, std::size_t length)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::string_view_value)), small_string_length_(0), tag_(tag),
+                  length_(static_cast<uint32_t>(length)), data_(data)
+            {
+                JSONCONS_ASSERT(length <= max_length);
+            }
+
+            std::size_t length() const
+            {
+                return length_;
+            }
+
+            const char_type* data() const
+            {
+                return data_;
+            }
+
+            const char_type* c_str() const
+            {
+                return data_;
+            }
+        };
+
+        // raw_number_storage
+        // The text of a number, kept by a parse with lazy_number and converted when the value is read.
+        // The text is ASCII, so it is stored as char whatever the char_type. Text of up to max_length 
+        // characters is kept inside the value, longer text in a heap string whose pointer is kept in 
+        // the same bytes, at an offset aligned for it.
+        class alignas(typename jsoncons::detail::heap_string_factory<char,null_type,Allocator>::pointer) raw_number_storage final
+        {
+            using heap_string_factory_type = jsoncons::detail::heap_string_factory<char,null_type,Allocator>;
+            using pointer = typename heap_string_factory_type::pointer;
+        public:
+            uint8_t storage_kind_:4;
+            uint8_t small_string_length_:4;
+            semantic_tag tag_;
+        private:
+            static constexpr size_t capacity = 2*sizeof(uint64_t) - 2*sizeof(uint8_t);
+            static constexpr uint8_t heap_length = 0x0f; // small_string_length_ of text kept on the heap
+            static constexpr size_t pointer_offset = sizeof(uint64_t) - 2*sizeof(uint8_t);
+            static_assert((2*sizeof(uint8_t) + pointer_offset) % alignof(pointer) == 0 && pointer_offset + sizeof(pointer) <= capacity,
+                          "The heap string pointer must fit, aligned, in the text bytes");
+
+            char data_[capacity];
+        public:
+            static constexpr size_t max_length = capacity;
+
+            raw_number_storage(semantic_tag tag, const char_type* p, std::size_t length, const Allocator& alloc)
+                : storage_kind_(static_cast<uint8_t>(json_storage_kind::raw_number_value)), 
+                  small_string_length_(static_cast<uint8_t>(length <= max_length ? length : heap_length)), tag_(tag)
+            {
+                if (length <= max_length)
+                {
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        data_[i] = static_cast<char>(p[i]);
+                    }
+                }
+                else
+                {
+                    ::new(pointer_address()) pointer(create(p, length, alloc));
+                }
+            }
+
+            raw_number_storage(const raw_number_storage& other)
+                : storage_kind_(other.storage_kind_), small_string_length_(other.small_string_length_), tag_(other.tag_)
+            {
+                if (other.is_heap())
+                {
+                    ::new(pointer_address()) pointer(create(other.data(), other.length(), other.heap_ptr()->get_allocator()));
+                }
+                else
+                {
+                    std::memcpy(data_, other.data_, capacity);
+                }
+            }
+
+            raw_number_storage(const raw_number_storage& other, const Allocator& alloc)
+                : storage_kind_(other.storage_kind_), small_string_length_(other.small_string_length_), tag_(other.tag_)
+            {
+                if (other.is_heap())
+                {
+                    ::new(pointer_address()) pointer(create(other.data(), other.length(), alloc));
+                }
+                else
+                {
+                    std::memcpy(data_, other.data_, capacity);
+                }
+            }
+
+            raw_number_storage(raw_number_storage&& other) noexcept
+                : storage_kind_(other.storage_kind_), small_string_length_(other.small_string_length_), tag_(other.tag_)
+            {
+                if (other.is_heap())
+                {
+                    ::new(pointer_address()) pointer(other.release());
+                }
+                else
+                {
+                    std::memcpy(data_, other.data_, capacity);
+                }
+            }
+
+            raw_number_storage(raw_number_storage&& other, const Allocator& alloc)
+                : storage_kind_(other.storage_kind_), small_string_length_(other.small_string_length_), tag_(other.tag_)
+            {
+                if (!other.is_heap())
+                {
+                    std::memcpy(data_, other.data_, capacity);
+                }
+                else if (other.heap_ptr()->get_allocator() == alloc)
+                {
+                    ::new(pointer_address()) pointer(other.release());
+                }
+                else
+                {
+                    ::new(pointer_address()) pointer(create(other.data(), other.length(), alloc));
+                }
+            }
+
+            raw_number_storage& operator=(const raw_number_storage&) = delete;
+            raw_number_storage& operator=(raw_number_storage&&) = delete;
+
+            ~raw_number_storage() noexcept
+            {
+                if (is_heap())
+                {
+                    heap_string_factory_type::destroy(heap_ptr());
+                    heap_ptr().~pointer();
+                }
+            }
+
+            std::size_t length() const
+            {
+                return is_heap() ? heap_ptr()->length() : small_string_length_;
+            }
+
+            const char* data() const
+            {
+                return is_heap() ? heap_ptr()->data() : data_;
+            }
+
+            // Bytes allocated for text kept on the heap
+            std::size_t allocated_bytes() const
+            {
+                return is_heap() ? heap_string_factory_type::allocation_size(heap_ptr()->length()) : 0;
+            }
+
+            bool is_integer() const
+            {
+                const char* p = data();
+                return std::find_if(p, p+length(), [](char c){return c == '.' || c == 'e' || c == 'E';}) == p+length();
+            }
+
+            bool is_negative() const
+            {
+                return length() > 0 && data()[0] == '-';
+            }
+        private:
+            bool is_heap() const
+            {
+                return small_string_length_ == heap_length;
+            }
+
+            void* pointer_address()
+            {
+                return data_ + pointer_offset;
+            }
+
+            pointer& heap_ptr()
+            {
+                return *jsoncons::detail::launder_cast<pointer*>(data_ + pointer_offset);
+            }
+
+            const pointer& heap_ptr() const
+            {
+                return *jsoncons::detail::launder_cast<const pointer*>(data_ + pointer_offset);
+            }
+
+            // Gives up the heap string, leaving an empty inline text that the destructor has nothing to free
+            pointer release() noexcept
+            {
+                pointer ptr = heap_ptr();
+                heap_ptr().~pointer();
+                small_string_length_ = 0;
+                storage_kind_ = static_cast<uint8_t>(json_storage_kind::null_value);
+                tag_ = semantic_tag::none;
+                return ptr;
+            }
+
+            static pointer create(const char* p, std::size_t length, const Allocator& alloc)
+            {
+                return heap_string_factory_type::create(p, length, null_type(), alloc);
+            }
+
+            template <class ChT>
+            static pointer create(const ChT* p, std::size_t length, const Allocator& alloc)
+            {
+                std::string text;
+                text.reserve(length);
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    text.push_back(static_cast<char>(p[i]));
+                }
+                return create(text.data(), length, alloc);
+            }
+        };
+
         template <class ParentType>
         class proxy 
         {
@@ -1329,6 +1869,11 @@ namespace jsoncons {
                 return evaluate().array_range();
             }
 
+            const_array_value_range_type array_value_range() const
+            {
+                return evaluate().array_value_range();
+            }
+
             std::size_t size() const noexcept
             {
                 if (!parent_.contains(key_))
@@ -1553,6 +2098,21 @@ namespace jsoncons {
                 return evaluate().as_byte_string_view();
             }
 
+            typed_array_view as_typed_array_view() const 
+            {
+                return evaluate().as_typed_array_view();
+            }
+
+            json_memory_stats memory_stats() const
+            {
+                return evaluate().memory_stats();
+            }
+
+            std::size_t memory_usage() const
+            {
+                return evaluate().memory_usage();
+            }
+
             template <class SAllocator=std::allocator<char_type>>
             std::basic_string<char_type,char_traits_type,SAllocator> as_string() const 
             {
@@ -2219,9 +2779,12 @@ namespace jsoncons {
             long_string_storage long_string_stor_;
             byte_string_storage byte_string_stor_;
             array_storage array_stor_;
+            packed_array_storage packed_array_stor_;
             object_storage object_stor_;
             empty_object_storage empty_object_stor_;
             json_const_pointer_storage json_const_pointer_stor_;
+            string_view_storage string_view_stor_;
+            raw_number_storage raw_number_stor_;
         };
 
         void destroy()
@@ -2237,9 +2800,15 @@ namespace jsoncons {
                 case json_storage_kind::array_value:
                     destroy_var<array_storage>();
                     break;
+                case json_storage_kind::packed_array_value:
+                    destroy_var<packed_array_storage>();
+                    break;
                 case json_storage_kind::object_value:
                     destroy_var<object_storage>();
                     break;
+                case json_storage_kind::raw_number_value:
+                    destroy_var<raw_number_storage>();
+                    break;
                 default:
                     break;
             }
@@ -2392,6 +2961,16 @@ namespace jsoncons {
             return array_stor_;
         }
 
+        packed_array_storage& cast(identity<packed_array_storage>)
+        {
+            return packed_array_stor_;
+        }
+
+        const packed_array_storage& cast(identity<packed_array_storage>) const
+        {
+            return packed_array_stor_;
+        }
+
         json_const_pointer_storage& cast(identity<json_const_pointer_storage>) 
         {
             return json_const_pointer_stor_;
@@ -2402,6 +2981,26 @@ namespace jsoncons {
             return json_const_pointer_stor_;
         }
 
+        string_view_storage& cast(identity<string_view_storage>)
+        {
+            return string_view_stor_;
+        }
+
+        const string_view_storage& cast(identity<string_view_storage>) const
+        {
+            return string_view_stor_;
+        }
+
+        raw_number_storage& cast(identity<raw_number_storage>)
+        {
+            return raw_number_stor_;
+        }
+
+        const raw_number_storage& cast(identity<raw_number_storage>) const
+        {
+            return raw_number_stor_;
+        }
+
         template <class TypeL, class TypeR>
         void swap_l_r(basic_json& other)
         {
@@ -2435,6 +3034,11 @@ namespace jsoncons {
             cast<array_storage>().swap(other.cast<array_storage>());
         }
 
+        void swap_l_r(identity<packed_array_storage>,identity<packed_array_storage>,basic_json& other)
+        {
+            cast<packed_array_storage>().swap(other.cast<packed_array_storage>());
+        }
+
         void swap_l_r(identity<object_storage>,identity<object_storage>,basic_json& other)
         {
             cast<object_storage>().swap(other.cast<object_storage>());
@@ -2456,8 +3060,11 @@ namespace jsoncons {
                 case json_storage_kind::long_string_value  : swap_l_r<TypeL, long_string_storage>(other); break;
                 case json_storage_kind::byte_string_value  : swap_l_r<TypeL, byte_string_storage>(other); break;
                 case json_storage_kind::array_value        : swap_l_r<TypeL, array_storage>(other); break;
+                case json_storage_kind::packed_array_value : swap_l_r<TypeL, packed_array_storage>(other); break;
                 case json_storage_kind::object_value       : swap_l_r<TypeL, object_storage>(other); break;
                 case json_storage_kind::json_const_pointer : swap_l_r<TypeL, json_const_pointer_storage>(other); break;
+                case json_storage_kind::string_view_value  : swap_l_r<TypeL, string_view_storage>(other); break;
+                case json_storage_kind::raw_number_value   : swap_l_r<TypeL, raw_number_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -2504,9 +3111,18 @@ namespace jsoncons {
                 case json_storage_kind::array_value:
                     construct<array_storage>(other.cast<array_storage>());
                     break;
+                case json_storage_kind::packed_array_value:
+                    construct<packed_array_storage>(other.cast<packed_array_storage>());
+                    break;
                 case json_storage_kind::json_const_pointer:
                     construct<json_const_pointer_storage>(other.cast<json_const_pointer_storage>());
                     break;
+                case json_storage_kind::string_view_value:
+                    construct<string_view_storage>(other.cast<string_view_storage>());
+                    break;
+                case json_storage_kind::raw_number_value:
+                    construct<raw_number_storage>(other.cast<raw_number_storage>());
+                    break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -2526,17 +3142,24 @@ namespace jsoncons {
                 case json_storage_kind::double_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     uninitialized_copy(other);
                     break;
                 case json_storage_kind::long_string_value:
                     construct<long_string_storage>(other.cast<long_string_storage>(),alloc);
                     break;
+                case json_storage_kind::raw_number_value:
+                    construct<raw_number_storage>(other.cast<raw_number_storage>(),alloc);
+                    break;
                 case json_storage_kind::byte_string_value:
                     construct<byte_string_storage>(other.cast<byte_string_storage>(),alloc);
                     break;
                 case json_storage_kind::array_value:
                     construct<array_storage>(other.cast<array_storage>(),alloc);
                     break;
+                case json_storage_kind::packed_array_value:
+                    construct<packed_array_storage>(other.cast<packed_array_storage>(),alloc);
+                    break;
                 case json_storage_kind::object_value:
                     construct<object_storage>(other.cast<object_storage>(),alloc);
                     break;
@@ -2559,18 +3182,25 @@ namespace jsoncons {
                 case json_storage_kind::bool_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     uninitialized_copy(other);
                     break;
                     
                 case json_storage_kind::long_string_value:
                     construct<long_string_storage>(std::move(other.cast<long_string_storage>()));
                     break;
+                case json_storage_kind::raw_number_value:
+                    construct<raw_number_storage>(std::move(other.cast<raw_number_storage>()));
+                    break;
                 case json_storage_kind::byte_string_value:
                     construct<byte_string_storage>(std::move(other.cast<byte_string_storage>()));
                     break;
                 case json_storage_kind::array_value:
                     construct<array_storage>(std::move(other.cast<array_storage>()));
                     break;
+                case json_storage_kind::packed_array_value:
+                    construct<packed_array_storage>(std::move(other.cast<packed_array_storage>()));
+                    break;
                 case json_storage_kind::object_value:
                     construct<object_storage>(std::move(other.cast<object_storage>()));
                     break;
@@ -2601,17 +3231,24 @@ namespace jsoncons {
                 case json_storage_kind::bool_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     uninitialized_copy(other);
                     break;
                 case json_storage_kind::long_string_value:
                     construct<long_string_storage>(std::move(other.cast<long_string_storage>()), alloc);
                     break;
+                case json_storage_kind::raw_number_value:
+                    construct<raw_number_storage>(std::move(other.cast<raw_number_storage>()), alloc);
+                    break;
                 case json_storage_kind::byte_string_value:
                     construct<byte_string_storage>(std::move(other.cast<byte_string_storage>()), alloc);
                     break;
                 case json_storage_kind::array_value:
                     construct<array_storage>(std::move(other.cast<array_storage>()), alloc);
                     break;
+                case json_storage_kind::packed_array_value:
+                    construct<packed_array_storage>(std::move(other.cast<packed_array_storage>()), alloc);
+                    break;
                 case json_storage_kind::object_value:
                     construct<object_storage>(std::move(other.cast<object_storage>()), alloc);
                     break;
@@ -2649,6 +3286,11 @@ namespace jsoncons {
             cast<array_storage>().assign(other.cast<array_storage>());
         }
 
+        void copy_assignment_l_r(identity<packed_array_storage>,identity<packed_array_storage>,const basic_json& other)
+        {
+            cast<packed_array_storage>().assign(other.cast<packed_array_storage>());
+        }
+
         void copy_assignment_l_r(identity<object_storage>,identity<object_storage>,const basic_json& other)
         {
             cast<object_storage>().assign(other.cast<object_storage>());
@@ -2668,9 +3310,12 @@ namespace jsoncons {
                 case json_storage_kind::double_value:        copy_assignment_l_r<double_storage,TypeR>(other);break;
                 case json_storage_kind::short_string_value:  copy_assignment_l_r<short_string_storage,TypeR>(other);break;
                 case json_storage_kind::json_const_pointer:  copy_assignment_l_r<json_const_pointer_storage,TypeR>(other);break;
+                case json_storage_kind::string_view_value:   copy_assignment_l_r<string_view_storage,TypeR>(other);break;
+                case json_storage_kind::raw_number_value:    copy_assignment_l_r<raw_number_storage,TypeR>(other);break;
                 case json_storage_kind::long_string_value:   copy_assignment_l_r<long_string_storage,TypeR>(other);break;
                 case json_storage_kind::byte_string_value:   copy_assignment_l_r<byte_string_storage,TypeR>(other);break;
                 case json_storage_kind::array_value:         copy_assignment_l_r<array_storage,TypeR>(other);break;
+                case json_storage_kind::packed_array_value:  copy_assignment_l_r<packed_array_storage,TypeR>(other);break;
                 case json_storage_kind::object_value:        copy_assignment_l_r<object_storage,TypeR>(other);break;
                 default:
                     JSONCONS_UNREACHABLE();
@@ -2691,6 +3336,8 @@ namespace jsoncons {
                 case json_storage_kind::double_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
+                case json_storage_kind::raw_number_value:
                     destroy();
                     uninitialized_copy(other);
                     break;
@@ -2703,6 +3350,9 @@ namespace jsoncons {
                 case json_storage_kind::array_value:
                     copy_assignment_r<array_storage>(other);
                     break;
+                case json_storage_kind::packed_array_value:
+                    copy_assignment_r<packed_array_storage>(other);
+                    break;
                 case json_storage_kind::object_value:
                     copy_assignment_r<object_storage>(other);
                     break;
@@ -2740,6 +3390,11 @@ namespace jsoncons {
             cast<array_storage>().assign(std::move(other.cast<array_storage>()));
         }
 
+        void move_assignment_l_r(identity<packed_array_storage>,identity<packed_array_storage>,basic_json&& other)
+        {
+            cast<packed_array_storage>().assign(std::move(other.cast<packed_array_storage>()));
+        }
+
         void move_assignment_l_r(identity<object_storage>,identity<object_storage>,basic_json&& other)
         {
             cast<object_storage>().assign(std::move(other.cast<object_storage>()));
@@ -2759,9 +3414,12 @@ namespace jsoncons {
                 case json_storage_kind::double_value:        move_assignment_l_r<double_storage,TypeR>(std::move(other));break;
                 case json_storage_kind::short_string_value:  move_assignment_l_r<short_string_storage,TypeR>(std::move(other));break;
                 case json_storage_kind::json_const_pointer:  move_assignment_l_r<json_const_pointer_storage,TypeR>(std::move(other));break;
+                case json_storage_kind::string_view_value:   move_assignment_l_r<string_view_storage,TypeR>(std::move(other));break;
+                case json_storage_kind::raw_number_value:    move_assignment_l_r<raw_number_storage,TypeR>(std::move(other));break;
                 case json_storage_kind::long_string_value:   move_assignment_l_r<long_string_storage,TypeR>(std::move(other));break;
                 case json_storage_kind::byte_string_value:   move_assignment_l_r<byte_string_storage,TypeR>(std::move(other));break;
                 case json_storage_kind::array_value:         move_assignment_l_r<array_storage,TypeR>(std::move(other));break;
+                case json_storage_kind::packed_array_value:  move_assignment_l_r<packed_array_storage,TypeR>(std::move(other));break;
                 case json_storage_kind::object_value:        move_assignment_l_r<object_storage,TypeR>(std::move(other));break;
                 default:
                     JSONCONS_UNREACHABLE();
@@ -2782,9 +3440,14 @@ namespace jsoncons {
                 case json_storage_kind::double_value:
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::json_const_pointer:
+                case json_storage_kind::string_view_value:
                     destroy();
                     uninitialized_copy(std::move(other));
                     break;
+                case json_storage_kind::raw_number_value:
+                    destroy();
+                    uninitialized_move(std::move(other));
+                    break;
                 case json_storage_kind::long_string_value:
                     move_assignment_r<long_string_storage>(std::move(other));
                     break;
@@ -2794,6 +3457,9 @@ namespace jsoncons {
                 case json_storage_kind::array_value:
                     move_assignment_r<array_storage>(std::move(other));
                     break;
+                case json_storage_kind::packed_array_value:
+                    move_assignment_r<packed_array_storage>(std::move(other));
+                    break;
                 case json_storage_kind::object_value:
                     move_assignment_r<object_storage>(std::move(other));
                     break;
@@ -2875,16 +3541,25 @@ namespace jsoncons {
                     return json_type::double_value;
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return json_type::string_value;
                 case json_storage_kind::byte_string_value:
                     return json_type::byte_string_value;
                 case json_storage_kind::array_value:
+                case json_storage_kind::packed_array_value:
                     return json_type::array_value;
                 case json_storage_kind::empty_object_value:
                 case json_storage_kind::object_value:
                     return json_type::object_value;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->type();
+                case json_storage_kind::raw_number_value:
+                    // The text is the parser's, an integer of at most 14 characters fits in an int64 or uint64
+                    if (!cast<raw_number_storage>().is_integer())
+                    {
+                        return json_type::double_value;
+                    }
+                    return cast<raw_number_storage>().is_negative() ? json_type::int64_value : json_type::uint64_value;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -2912,6 +3587,8 @@ namespace jsoncons {
             {
                 case json_storage_kind::array_value:
                     return cast<array_storage>().value().size();
+                case json_storage_kind::packed_array_value:
+                    return cast<packed_array_storage>().value().size();
                 case json_storage_kind::empty_object_value:
                     return 0;
                 case json_storage_kind::object_value:
@@ -2931,6 +3608,8 @@ namespace jsoncons {
                     return string_view_type(cast<short_string_storage>().data(),cast<short_string_storage>().length());
                 case json_storage_kind::long_string_value:
                     return string_view_type(cast<long_string_storage>().data(),cast<long_string_storage>().length());
+                case json_storage_kind::string_view_value:
+                    return string_view_type(cast<string_view_storage>().data(),cast<string_view_storage>().length());
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->as_string_view();
                 default:
@@ -2948,6 +3627,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     value_converter<jsoncons::string_view, byte_string_type> converter;
                     byte_string_type v = converter.convert(as_string_view(),tag(), ec);
@@ -2979,12 +3659,41 @@ namespace jsoncons {
             }
         }
 
+        typed_array_view as_typed_array_view() const
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::packed_array_value:
+                    if (cast<packed_array_storage>().value().is_nan_boxed())
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a packed array of numbers"));
+                    }
+                    return cast<packed_array_storage>().value().view();
+                case json_storage_kind::json_const_pointer:
+                    return cast<json_const_pointer_storage>().value()->as_typed_array_view();
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a packed array"));
+            }
+        }
+
         int compare(const basic_json& rhs) const noexcept
         {
             if (this == &rhs)
             {
                 return 0;
             }
+            if (storage_kind() == json_storage_kind::raw_number_value)
+            {
+                return materialize_number().compare(rhs);
+            }
+            if (rhs.storage_kind() == json_storage_kind::raw_number_value)
+            {
+                return compare(rhs.materialize_number());
+            }
+            if (storage_kind() == json_storage_kind::packed_array_value || rhs.storage_kind() == json_storage_kind::packed_array_value)
+            {
+                return compare_packed(rhs);
+            }
             switch (storage_kind())
             {
                 case json_storage_kind::json_const_pointer:
@@ -3101,6 +3810,7 @@ namespace jsoncons {
                     break;
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     switch (tag())
                     {
                         case semantic_tag::bigint:
@@ -3108,7 +3818,8 @@ namespace jsoncons {
                         case semantic_tag::bigfloat:
                         {
                             // same text -> equal
-                            if (rhs.storage_kind() == json_storage_kind::short_string_value || rhs.storage_kind() == json_storage_kind::long_string_value)
+                            if (rhs.storage_kind() == json_storage_kind::short_string_value || rhs.storage_kind() == json_storage_kind::long_string_value || 
+                                rhs.storage_kind() == json_storage_kind::string_view_value)
                             {
                                 int compareString = as_string_view().compare(rhs.as_string_view());
                                 if (compareString == 0)
@@ -3130,6 +3841,8 @@ namespace jsoncons {
                                     return as_string_view().compare(rhs.as_string_view());
                                 case json_storage_kind::long_string_value:
                                     return as_string_view().compare(rhs.as_string_view());
+                                case json_storage_kind::string_view_value:
+                                    return as_string_view().compare(rhs.as_string_view());
                                 case json_storage_kind::json_const_pointer:
                                     return compare(*(rhs.cast<json_const_pointer_storage>().value()));
                                 default:
@@ -3211,8 +3924,11 @@ namespace jsoncons {
                 case json_storage_kind::long_string_value: swap_l<long_string_storage>(other); break;
                 case json_storage_kind::byte_string_value: swap_l<byte_string_storage>(other); break;
                 case json_storage_kind::array_value: swap_l<array_storage>(other); break;
+                case json_storage_kind::packed_array_value: swap_l<packed_array_storage>(other); break;
                 case json_storage_kind::object_value: swap_l<object_storage>(other); break;
                 case json_storage_kind::json_const_pointer: swap_l<json_const_pointer_storage>(other); break;
+                case json_storage_kind::string_view_value: swap_l<string_view_storage>(other); break;
+                case json_storage_kind::raw_number_value: swap_l<raw_number_storage>(other); break;
                 default:
                     JSONCONS_UNREACHABLE();
                     break;
@@ -3227,6 +3943,9 @@ namespace jsoncons {
               const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
         {
             json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_parser<char_type> parser(options);
 
             auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
@@ -3253,6 +3972,9 @@ namespace jsoncons {
               const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
         {
             json_decoder<basic_json> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_parser<char_type,TempAllocator> parser(options, alloc_set.get_temp_allocator());
 
             auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
@@ -3272,6 +3994,38 @@ namespace jsoncons {
             return decoder.get_result();
         }
 
+        // Parses s destructively: strings are unescaped and null terminated in place, and the result
+        // refers to them instead of copying them, so s must outlive the result and not be modified.
+        template <class Traits, class SAllocator>
+        static basic_json parse_insitu(std::basic_string<char_type,Traits,SAllocator>& s,
+            const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
+            basic_json_parser<char_type> parser(options);
+
+            auto r = unicode_traits::detect_encoding_from_bom(s.data(), s.size());
+            if (!(r.encoding == unicode_traits::encoding_kind::utf8 || r.encoding == unicode_traits::encoding_kind::undetected))
+            {
+                JSONCONS_THROW(ser_error(json_errc::illegal_unicode_character,parser.line(),parser.column()));
+            }
+            std::size_t offset = (r.ptr - s.data());
+            char_type* data = &s[0] + offset;
+            std::size_t length = s.size() - offset;
+            decoder.insitu_buffer(data, length);
+            parser.update(data, length);
+            parser.parse_some(decoder);
+            parser.finish_parse(decoder);
+            parser.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error, "Failed to parse json string"));
+            }
+            return decoder.get_result();
+        }
+
         static basic_json parse(const char_type* source, 
             const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
         {
@@ -3304,6 +4058,9 @@ namespace jsoncons {
             const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
             json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_reader<char_type,stream_source<char_type>,Allocator> reader(is, decoder, options);
             reader.read_next();
             reader.check_done();
@@ -3319,7 +4076,10 @@ namespace jsoncons {
             const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
             json_decoder<basic_json> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
-            basic_json_reader<char_type,stream_source<char_type>,Allocator> reader(is, decoder, options, alloc_set.get_temp_allocator());
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
+            basic_json_reader<char_type,stream_source<char_type>,TempAllocator> reader(is, decoder, options, alloc_set.get_temp_allocator());
             reader.read_next();
             reader.check_done();
             if (!decoder.is_valid())
@@ -3336,6 +4096,9 @@ namespace jsoncons {
                                 const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
             json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_reader<char_type,iterator_source<InputIt>,Allocator> reader(iterator_source<InputIt>(std::forward<InputIt>(first),
                 std::forward<InputIt>(last)), decoder, options);
             reader.read_next();
@@ -3352,7 +4115,10 @@ namespace jsoncons {
                                 const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>())
         {
             json_decoder<basic_json> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
-            basic_json_reader<char_type,iterator_source<InputIt>,Allocator> reader(iterator_source<InputIt>(std::forward<InputIt>(first),
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
+            basic_json_reader<char_type,iterator_source<InputIt>,TempAllocator> reader(iterator_source<InputIt>(std::forward<InputIt>(first),
                 std::forward<InputIt>(last)), 
                 decoder, options, alloc_set.get_temp_allocator());
             reader.read_next();
@@ -3369,6 +4135,9 @@ namespace jsoncons {
             std::function<bool(json_errc,const ser_context&)> err_handler)
         {
             json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_reader<char_type,stream_source<char_type>> reader(is, decoder, options, err_handler);
             reader.read_next();
             reader.check_done();
@@ -3390,6 +4159,9 @@ namespace jsoncons {
                                 std::function<bool(json_errc,const ser_context&)> err_handler)
         {
             json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_reader<char_type,iterator_source<InputIt>> reader(iterator_source<InputIt>(std::forward<InputIt>(first),std::forward<InputIt>(last)), decoder, options, err_handler);
             reader.read_next();
             reader.check_done();
@@ -3408,6 +4180,9 @@ namespace jsoncons {
               std::function<bool(json_errc,const ser_context&)> err_handler)
         {
             json_decoder<basic_json> decoder;
+            decoder.max_interned_keys(options.max_interned_keys());
+            decoder.max_length_hint(options.max_length_hint());
+            decoder.min_packed_array_length(options.min_packed_array_length());
             basic_json_parser<char_type> parser(options,err_handler);
 
             auto r = unicode_traits::detect_encoding_from_bom(source.data(), source.size());
@@ -3612,6 +4387,60 @@ namespace jsoncons {
             }
         }
 
+        // Refers to s without copying it. s must be followed by a null terminator and outlive the value.
+        basic_json(string_view_arg_t, const string_view_type& s, 
+                   semantic_tag tag = semantic_tag::none, 
+                   const Allocator& alloc = Allocator())
+        {
+            if (s.length() <= string_view_storage::max_length)
+            {
+                construct<string_view_storage>(tag, s.data(), s.length());
+            }
+            else
+            {
+                construct<long_string_storage>(tag, s.data(), s.length(), alloc);
+            }
+        }
+
+        // Keeps the text of a number, as produced by the parser, and converts it when the value is read. 
+        // Integers too long to keep inline are converted now, to int64, uint64 or a bigint string, which 
+        // writes the same text. Other numbers keep their text, on the heap if it is too long to keep inline.
+        basic_json(number_text_arg_t, const string_view_type& s, 
+                   semantic_tag tag = semantic_tag::none, 
+                   const Allocator& alloc = Allocator())
+        {
+            if (s.length() <= raw_number_storage::max_length)
+            {
+                construct<raw_number_storage>(tag, s.data(), s.length(), alloc);
+                return;
+            }
+            auto is_integer = std::find_if(s.begin(), s.end(), [](char_type c){return c == '.' || c == 'e' || c == 'E';}) == s.end();
+            if (is_integer)
+            {
+                if (s[0] == '-')
+                {
+                    int64_t val;
+                    if (jsoncons::detail::to_integer_unchecked(s.data(), s.length(), val))
+                    {
+                        construct<int64_storage>(val, tag);
+                        return;
+                    }
+                }
+                else
+                {
+                    uint64_t val;
+                    if (jsoncons::detail::to_integer_unchecked(s.data(), s.length(), val))
+                    {
+                        construct<uint64_storage>(val, tag);
+                        return;
+                    }
+                }
+                construct<long_string_storage>(semantic_tag::bigint, s.data(), s.length(), alloc);
+                return;
+            }
+            construct<raw_number_storage>(tag, s.data(), s.length(), alloc);
+        }
+
         basic_json(const array& val, semantic_tag tag = semantic_tag::none)
         {
             construct<array_storage>(val, tag);
@@ -3622,6 +4451,25 @@ namespace jsoncons {
             construct<array_storage>(std::move(val), tag);
         }
 
+        template <class T>
+        basic_json(packed_array_arg_t, const jsoncons::span<const T>& data, 
+                   semantic_tag tag = semantic_tag::none, const Allocator& alloc = Allocator())
+        {
+            construct<packed_array_storage>(tag, alloc, data.data(), data.size());
+        }
+
+        basic_json(packed_array_arg_t, half_arg_t, const jsoncons::span<const uint16_t>& data, 
+                   semantic_tag tag = semantic_tag::none, const Allocator& alloc = Allocator())
+        {
+            construct<packed_array_storage>(tag, alloc, half_arg, data.data(), data.size());
+        }
+
+        basic_json(nan_boxed_array_arg_t, array&& elements, 
+                   semantic_tag tag = semantic_tag::none, const Allocator& alloc = Allocator())
+        {
+            construct<packed_array_storage>(tag, alloc, nan_boxed_array_arg, std::move(elements));
+        }
+
         basic_json(const object& val, semantic_tag tag = semantic_tag::none)
         {
             construct<object_storage>(val, tag);
@@ -4136,6 +4984,10 @@ namespace jsoncons {
                 {
                     return cast<array_storage>().get_allocator();
                 }
+                case json_storage_kind::packed_array_value:
+                {
+                    return cast<packed_array_storage>().get_allocator();
+                }
                 case json_storage_kind::object_value:
                 {
                     return cast<object_storage>().get_allocator();
@@ -4214,6 +5066,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return true;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_string();
@@ -4251,12 +5104,15 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return jsoncons::detail::is_base10(as_string_view().data(), as_string_view().length());
                 case json_storage_kind::int64_value:
                 case json_storage_kind::uint64_value:
                     return true;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_bignum();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().is_bignum();
                 default:
                     return false;
             }
@@ -4294,6 +5150,7 @@ namespace jsoncons {
             switch (storage_kind())
             {
                 case json_storage_kind::array_value:
+                case json_storage_kind::packed_array_value:
                     return true;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_array();
@@ -4312,6 +5169,8 @@ namespace jsoncons {
                     return as_integer<uint64_t>() <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_int64();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().is_int64();
                 default:
                     return false;
             }
@@ -4327,6 +5186,8 @@ namespace jsoncons {
                     return as_integer<int64_t>() >= 0;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_uint64();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().is_uint64();
                 default:
                     return false;
             }
@@ -4353,6 +5214,8 @@ namespace jsoncons {
                     return true;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->is_double();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().is_double();
                 default:
                     return false;
             }
@@ -4366,9 +5229,11 @@ namespace jsoncons {
                 case json_storage_kind::uint64_value:
                 case json_storage_kind::half_value:
                 case json_storage_kind::double_value:
+                case json_storage_kind::raw_number_value:
                     return true;
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     return tag() == semantic_tag::bigint ||
                            tag() == semantic_tag::bigdec ||
                            tag() == semantic_tag::bigfloat;
@@ -4390,8 +5255,12 @@ namespace jsoncons {
                     return cast<short_string_storage>().length() == 0;
                 case json_storage_kind::long_string_value:
                     return cast<long_string_storage>().length() == 0;
+                case json_storage_kind::string_view_value:
+                    return cast<string_view_storage>().length() == 0;
                 case json_storage_kind::array_value:
                     return cast<array_storage>().value().empty();
+                case json_storage_kind::packed_array_value:
+                    return cast<packed_array_storage>().value().empty();
                 case json_storage_kind::empty_object_value:
                     return true;
                 case json_storage_kind::object_value:
@@ -4409,6 +5278,8 @@ namespace jsoncons {
             {
                 case json_storage_kind::array_value:
                     return cast<array_storage>().value().capacity();
+                case json_storage_kind::packed_array_value:
+                    return cast<packed_array_storage>().value().size();
                 case json_storage_kind::object_value:
                     return cast<object_storage>().value().capacity();
                 case json_storage_kind::json_const_pointer:
@@ -4418,6 +5289,21 @@ namespace jsoncons {
             }
         }
 
+        // Returns the memory owned by this value and the values it contains, by storage kind
+        json_memory_stats memory_stats() const
+        {
+            json_memory_stats stats;
+            std::unordered_set<const void*> shared;
+            add_memory_stats(stats, shared);
+            return stats;
+        }
+
+        // Returns the bytes taken by this value and the heap memory it owns
+        std::size_t memory_usage() const
+        {
+            return sizeof(basic_json) + memory_stats().heap_bytes();
+        }
+
         template<class U=Allocator>
         void create_object_implicitly()
         {
@@ -4440,6 +5326,9 @@ namespace jsoncons {
             {
                 switch (storage_kind())
                 {
+                    case json_storage_kind::packed_array_value:
+                        unpack_array();
+                        JSONCONS_FALLTHROUGH;
                     case json_storage_kind::array_value:
                         cast<array_storage>().value().reserve(n);
                         break;
@@ -4464,6 +5353,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::packed_array_value:
+                    unpack_array();
+                    JSONCONS_FALLTHROUGH;
                 case json_storage_kind::array_value:
                     cast<array_storage>().value().resize(n);
                     break;
@@ -4477,6 +5369,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::packed_array_value:
+                    unpack_array();
+                    JSONCONS_FALLTHROUGH;
                 case json_storage_kind::array_value:
                     cast<array_storage>().value().resize(n, val);
                     break;
@@ -4504,6 +5399,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     switch (tag())
                     {
@@ -4554,6 +5450,8 @@ namespace jsoncons {
                     return cast<uint64_storage>().value() != 0;
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->as_bool();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().as_bool();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a bool"));
             }
@@ -4566,6 +5464,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     IntegerType val;
                     auto result = jsoncons::detail::to_integer(as_string_view().data(), as_string_view().length(), val);
@@ -4587,6 +5486,8 @@ namespace jsoncons {
                     return static_cast<IntegerType>(cast<bool_storage>().value() ? 1 : 0);
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->template as_integer<IntegerType>();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().template as_integer<IntegerType>();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an integer"));
             }
@@ -4604,6 +5505,8 @@ namespace jsoncons {
                     return as_integer<uint64_t>() <= static_cast<uint64_t>((extension_traits::integer_limits<IntegerType>::max)());
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->template is_integer<IntegerType>();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().template is_integer<IntegerType>();
                 default:
                     return false;
             }
@@ -4617,6 +5520,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     IntegerType val;
                     auto result = jsoncons::detail::to_integer(as_string_view().data(), as_string_view().length(), val);
@@ -4628,6 +5532,8 @@ namespace jsoncons {
                     return as_integer<uint64_t>() <= static_cast<uint64_t>((extension_traits::integer_limits<IntegerType>::max)());
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->template is_integer<IntegerType>();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().template is_integer<IntegerType>();
                 default:
                     return false;
             }
@@ -4645,6 +5551,8 @@ namespace jsoncons {
                     return as_integer<uint64_t>() <= (extension_traits::integer_limits<IntegerType>::max)();
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->template is_integer<IntegerType>();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().template is_integer<IntegerType>();
                 default:
                     return false;
             }
@@ -4658,6 +5566,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     IntegerType val;
                     auto result = jsoncons::detail::to_integer(as_string_view().data(), as_string_view().length(), val);
@@ -4669,6 +5578,8 @@ namespace jsoncons {
                     return as_integer<uint64_t>() <= (extension_traits::integer_limits<IntegerType>::max)();
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->template is_integer<IntegerType>();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().template is_integer<IntegerType>();
                 default:
                     return false;
             }
@@ -4680,6 +5591,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     jsoncons::detail::chars_to to_double;
                     // to_double() throws std::invalid_argument if conversion fails
@@ -4695,6 +5607,8 @@ namespace jsoncons {
                     return static_cast<double>(cast<uint64_storage>().value());
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->as_double();
+                case json_storage_kind::raw_number_value:
+                    return materialize_number().as_double();
                 default:
                     JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Not a double"));
             }
@@ -4716,6 +5630,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                 {
                     return string_type2(as_string_view().data(),as_string_view().length(),alloc);
                 }
@@ -4730,6 +5645,7 @@ namespace jsoncons {
                     return s;
                 }
                 case json_storage_kind::array_value:
+                case json_storage_kind::packed_array_value:
                 {
                     string_type2 s(alloc);
                     {
@@ -4758,6 +5674,8 @@ namespace jsoncons {
                     return cast<short_string_storage>().c_str();
                 case json_storage_kind::long_string_value:
                     return cast<long_string_storage>().c_str();
+                case json_storage_kind::string_view_value:
+                    return cast<string_view_storage>().c_str();
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->as_cstring();
                 default:
@@ -4815,6 +5733,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::packed_array_value:
+                    unpack_array();
+                    JSONCONS_FALLTHROUGH;
                 case json_storage_kind::array_value:
                     if (i >= cast<array_storage>().value().size())
                     {
@@ -4838,6 +5759,12 @@ namespace jsoncons {
                         JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
                     }
                     return cast<array_storage>().value().operator[](i);
+                case json_storage_kind::packed_array_value:
+                    if (i >= cast<packed_array_storage>().value().size())
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+                    }
+                    return cast<packed_array_storage>().value().elements().operator[](i);
                 case json_storage_kind::object_value:
                     return cast<object_storage>().value().at(i);
                 case json_storage_kind::json_const_pointer:
@@ -4950,6 +5877,10 @@ namespace jsoncons {
             {
             case json_storage_kind::array_value:
                 cast<array_storage>().value().shrink_to_fit();
+                nan_box_array(jsoncons::detail::is_nan_boxed_policy<policy_type>());
+                break;
+            case json_storage_kind::packed_array_value:
+                cast<packed_array_storage>().value().shrink_to_fit();
                 break;
             case json_storage_kind::object_value:
                 cast<object_storage>().value().shrink_to_fit();
@@ -4966,6 +5897,12 @@ namespace jsoncons {
             case json_storage_kind::array_value:
                 cast<array_storage>().value().clear();
                 break;
+            case json_storage_kind::packed_array_value:
+            {
+                basic_json temp(json_array_arg, tag(), cast<packed_array_storage>().get_allocator());
+                swap(temp);
+                break;
+            }
             case json_storage_kind::object_value:
                 cast<object_storage>().value().clear();
                 break;
@@ -5006,6 +5943,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 return cast<array_storage>().value().erase(pos);
             default:
@@ -5017,6 +5957,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 return cast<array_storage>().value().erase(first, last);
             default:
@@ -5323,6 +6266,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 return cast<array_storage>().value().insert(pos, std::forward<T>(val));
                 break;
@@ -5336,6 +6282,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 return cast<array_storage>().value().insert(pos, first, last);
                 break;
@@ -5383,6 +6332,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 return cast<array_storage>().value().emplace(pos, std::forward<Args>(args)...);
                 break;
@@ -5396,6 +6348,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 return cast<array_storage>().value().emplace_back(std::forward<Args>(args)...);
             default:
@@ -5413,6 +6368,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 cast<array_storage>().value().push_back(std::forward<T>(val));
                 break;
@@ -5425,6 +6383,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 cast<array_storage>().value().push_back(std::move(val));
                 break;
@@ -5944,6 +6905,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+            case json_storage_kind::packed_array_value:
+                unpack_array();
+                JSONCONS_FALLTHROUGH;
             case json_storage_kind::array_value:
                 cast<array_storage>().value().remove_range(from_index, to_index);
                 break;
@@ -6041,6 +7005,9 @@ namespace jsoncons {
         {
             switch (storage_kind())
             {
+                case json_storage_kind::packed_array_value:
+                    unpack_array();
+                    JSONCONS_FALLTHROUGH;
                 case json_storage_kind::array_value:
                     return array_range_type(cast<array_storage>().value().begin(),
                         cast<array_storage>().value().end());
@@ -6056,6 +7023,11 @@ namespace jsoncons {
                 case json_storage_kind::array_value:
                     return const_array_range_type(cast<array_storage>().value().begin(),
                         cast<array_storage>().value().end());
+                case json_storage_kind::packed_array_value:
+                {
+                    const array& elements = cast<packed_array_storage>().value().elements();
+                    return const_array_range_type(elements.begin(), elements.end());
+                }
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->array_range();
                 default:
@@ -6063,6 +7035,22 @@ namespace jsoncons {
             }
         }
 
+        // Unlike array_range() const, does not build the elements of a packed array
+        const_array_value_range_type array_value_range() const
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::array_value:
+                case json_storage_kind::packed_array_value:
+                    return const_array_value_range_type(const_array_value_iterator(this, 0),
+                        const_array_value_iterator(this, size()));
+                case json_storage_kind::json_const_pointer:
+                    return cast<json_const_pointer_storage>().value()->array_value_range();
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+        }
+
     private:
 
         void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
@@ -6072,6 +7060,7 @@ namespace jsoncons {
             {
                 case json_storage_kind::short_string_value:
                 case json_storage_kind::long_string_value:
+                case json_storage_kind::string_view_value:
                     visitor.string_value(as_string_view(), tag(), context, ec);
                     break;
                 case json_storage_kind::byte_string_value:
@@ -6136,13 +7125,267 @@ namespace jsoncons {
                     }
                     break;
                 }
+                case json_storage_kind::packed_array_value:
+                {
+                    const auto& packed = cast<packed_array_storage>().value();
+                    if (packed.is_nan_boxed())
+                    {
+                        bool more = visitor.begin_array(packed.size(), tag(), context, ec);
+                        for (std::size_t i = 0; more && i < packed.size(); ++i)
+                        {
+                            packed.value_at(i).dump_noflush(visitor, ec);
+                        }
+                        if (more)
+                        {
+                            visitor.end_array(context, ec);
+                        }
+                        break;
+                    }
+                    typed_array_view v = packed.view();
+                    switch (v.type())
+                    {
+                        case typed_array_type::uint8_value:
+                            visitor.typed_array(v.data(uint8_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::uint16_value:
+                            visitor.typed_array(v.data(uint16_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::uint32_value:
+                            visitor.typed_array(v.data(uint32_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::uint64_value:
+                            visitor.typed_array(v.data(uint64_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::int8_value:
+                            visitor.typed_array(v.data(int8_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::int16_value:
+                            visitor.typed_array(v.data(int16_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::int32_value:
+                            visitor.typed_array(v.data(int32_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::int64_value:
+                            visitor.typed_array(v.data(int64_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::half_value:
+                            visitor.typed_array(half_arg, v.data(half_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::float_value:
+                            visitor.typed_array(v.data(float_array_arg), tag(), context, ec);
+                            break;
+                        case typed_array_type::double_value:
+                            visitor.typed_array(v.data(double_array_arg), tag(), context, ec);
+                            break;
+                    }
+                    break;
+                }
                 case json_storage_kind::json_const_pointer:
                     return cast<json_const_pointer_storage>().value()->dump_noflush(visitor, ec);
+                case json_storage_kind::raw_number_value:
+                {
+                    const raw_number_storage& stor = cast<raw_number_storage>();
+                    if (stor.length() <= raw_number_storage::max_length)
+                    {
+                        char_type buffer[raw_number_storage::max_length];
+                        std::copy(stor.data(), stor.data() + stor.length(), buffer);
+                        visitor.number_value(string_view_type(buffer, stor.length()), tag(), context, ec);
+                    }
+                    else
+                    {
+                        std::basic_string<char_type> buffer(stor.data(), stor.data() + stor.length());
+                        visitor.number_value(string_view_type(buffer.data(), buffer.length()), tag(), context, ec);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        // The int64, uint64 or double value of raw number text
+        basic_json materialize_number() const
+        {
+            const raw_number_storage& stor = cast<raw_number_storage>();
+            if (stor.is_integer())
+            {
+                if (stor.is_negative())
+                {
+                    int64_t val;
+                    if (jsoncons::detail::to_integer_unchecked(stor.data(), stor.length(), val))
+                    {
+                        return basic_json(val, tag());
+                    }
+                }
+                else
+                {
+                    uint64_t val;
+                    if (jsoncons::detail::to_integer_unchecked(stor.data(), stor.length(), val))
+                    {
+                        return basic_json(val, tag());
+                    }
+                }
+            }
+            return basic_json(jsoncons::detail::number_text_to_double(stor.data(), stor.length()), tag());
+        }
+
+        // Compares as arrays are compared, when this value or rhs is a packed array
+        int compare_packed(const basic_json& rhs) const noexcept
+        {
+            if (storage_kind() == json_storage_kind::json_const_pointer)
+            {
+                return cast<json_const_pointer_storage>().value()->compare(rhs);
+            }
+            if (rhs.storage_kind() == json_storage_kind::json_const_pointer)
+            {
+                return compare(*(rhs.cast<json_const_pointer_storage>().value()));
+            }
+            json_storage_kind lhs_kind = storage_kind() == json_storage_kind::packed_array_value ? json_storage_kind::array_value : storage_kind();
+            json_storage_kind rhs_kind = rhs.storage_kind() == json_storage_kind::packed_array_value ? json_storage_kind::array_value : rhs.storage_kind();
+            if (lhs_kind != json_storage_kind::array_value || rhs_kind != json_storage_kind::array_value)
+            {
+                return static_cast<int>(lhs_kind) - static_cast<int>(rhs_kind);
+            }
+
+            std::size_t n = (std::min)(size(), rhs.size());
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                int diff;
+                if (storage_kind() == json_storage_kind::packed_array_value)
+                {
+                    basic_json val = cast<packed_array_storage>().value().value_at(i);
+                    diff = rhs.storage_kind() == json_storage_kind::packed_array_value 
+                        ? val.compare(rhs.cast<packed_array_storage>().value().value_at(i))
+                        : val.compare(rhs.cast<array_storage>().value()[i]);
+                }
+                else
+                {
+                    diff = cast<array_storage>().value()[i].compare(rhs.cast<packed_array_storage>().value().value_at(i));
+                }
+                if (diff != 0)
+                {
+                    return diff < 0 ? -1 : 1;
+                }
+            }
+            return size() == rhs.size() ? 0 : (size() < rhs.size() ? -1 : 1);
+        }
+
+        // Adds the memory owned by this value to stats. Memory that is shared, the elements of 
+        // copy_on_write_policy arrays and objects and the names of basic_shared_key members, is 
+        // counted once, shared holds the addresses of the shared memory counted so far.
+        void add_memory_stats(json_memory_stats& stats, std::unordered_set<const void*>& shared) const
+        {
+            switch (storage_kind())
+            {
+                case json_storage_kind::short_string_value:
+                    ++stats.short_strings;
+                    stats.short_string_bytes += cast<short_string_storage>().length()*sizeof(char_type);
+                    break;
+                case json_storage_kind::long_string_value:
+                    ++stats.long_strings;
+                    stats.long_string_bytes += cast<long_string_storage>().allocated_bytes();
+                    break;
+                case json_storage_kind::byte_string_value:
+                    ++stats.byte_strings;
+                    stats.byte_string_bytes += cast<byte_string_storage>().allocated_bytes();
+                    break;
+                case json_storage_kind::raw_number_value:
+                    ++stats.raw_numbers;
+                    stats.raw_number_bytes += cast<raw_number_storage>().allocated_bytes();
+                    break;
+                case json_storage_kind::array_value:
+                {
+                    const array& arr = cast<array_storage>().value();
+                    ++stats.arrays;
+                    stats.array_bytes += sizeof(array);
+                    if (arr.is_shared() && !arr.empty() && !shared.insert(std::addressof(*arr.begin())).second)
+                    {
+                        break;
+                    }
+                    std::size_t bytes = arr.allocated_bytes();
+                    stats.array_bytes += bytes;
+                    if (bytes > 0)
+                    {
+                        stats.slack_bytes += (arr.capacity() - arr.size())*sizeof(basic_json);
+                    }
+                    for (const auto& item : arr)
+                    {
+                        item.add_memory_stats(stats, shared);
+                    }
+                    break;
+                }
+                case json_storage_kind::packed_array_value:
+                {
+                    const auto& packed = cast<packed_array_storage>().value();
+                    ++stats.packed_arrays;
+                    stats.packed_array_bytes += sizeof(jsoncons::detail::packed_array<basic_json>) + packed.allocated_bytes();
+                    const array& others = packed.others();
+                    if (others.is_shared() && !others.empty() && !shared.insert(std::addressof(*others.begin())).second)
+                    {
+                        break;
+                    }
+                    stats.packed_array_bytes += others.allocated_bytes();
+                    for (const auto& item : others)
+                    {
+                        item.add_memory_stats(stats, shared);
+                    }
+                    break;
+                }
+                case json_storage_kind::object_value:
+                {
+                    const object& obj = cast<object_storage>().value();
+                    ++stats.objects;
+                    stats.object_bytes += sizeof(object);
+                    if (obj.is_shared() && !obj.empty() && !shared.insert(std::addressof(*obj.begin())).second)
+                    {
+                        break;
+                    }
+                    std::size_t bytes = obj.allocated_bytes();
+                    stats.object_bytes += bytes;
+                    if (bytes > 0)
+                    {
+                        stats.slack_bytes += (obj.capacity() - obj.size())*sizeof(key_value_type);
+                    }
+                    for (const auto& member : obj)
+                    {
+                        if (!jsoncons::detail::is_shared_string(member.key()) || shared.insert(member.key().data()).second)
+                        {
+                            stats.key_bytes += jsoncons::detail::string_allocated_bytes(member.key());
+                        }
+                        member.value().add_memory_stats(stats, shared);
+                    }
+                    break;
+                }
                 default:
                     break;
             }
         }
 
+        void nan_box_array(std::false_type)
+        {
+        }
+
+        // Replaces an array with a NaN-boxed packed array of its elements if that takes less memory
+        void nan_box_array(std::true_type)
+        {
+            array& elements = cast<array_storage>().value();
+            if (!elements.is_shared() && 
+                jsoncons::detail::packed_array<basic_json>::nan_boxing_saves_memory(elements.begin(), elements.end()))
+            {
+                basic_json temp(nan_boxed_array_arg, std::move(elements), tag(), cast<array_storage>().get_allocator());
+                swap(temp);
+            }
+        }
+
+        // Replaces a packed array with an array of its elements. References to elements obtained 
+        // through const member functions refer to the elements of the new array.
+        void unpack_array()
+        {
+            semantic_tag t = tag();
+            basic_json temp(cast<packed_array_storage>().value().release_elements(), t);
+            swap(temp);
+        }
+
         friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const basic_json& o)
         {
             o.dump(os);
@@ -29,6 +29,9 @@ namespace jsoncons {
         using char_type = typename Source::value_type;
 
         jsoncons::json_decoder<T> decoder;
+        decoder.max_interned_keys(options.max_interned_keys());
+        decoder.max_length_hint(options.max_length_hint());
+        decoder.min_packed_array_length(options.min_packed_array_length());
         basic_json_reader<char_type, string_source<char_type>> reader(s, decoder, options);
         reader.read();
         if (!decoder.is_valid())
@@ -63,6 +66,9 @@ namespace jsoncons {
                 const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_interned_keys(options.max_interned_keys());
+        decoder.max_length_hint(options.max_length_hint());
+        decoder.min_packed_array_length(options.min_packed_array_length());
         basic_json_reader<CharT, stream_source<CharT>> reader(is, decoder, options);
         reader.read();
         if (!decoder.is_valid())
@@ -98,6 +104,9 @@ namespace jsoncons {
         using char_type = typename std::iterator_traits<InputIt>::value_type;
 
         jsoncons::json_decoder<T> decoder;
+        decoder.max_interned_keys(options.max_interned_keys());
+        decoder.max_length_hint(options.max_length_hint());
+        decoder.min_packed_array_length(options.min_packed_array_length());
         basic_json_reader<char_type, iterator_source<InputIt>> reader(iterator_source<InputIt>(first,last), decoder, options);
         reader.read();
         if (!decoder.is_valid())
@@ -138,6 +147,9 @@ namespace jsoncons {
         using char_type = typename Source::value_type;
 
         json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        decoder.max_interned_keys(options.max_interned_keys());
+        decoder.max_length_hint(options.max_length_hint());
+        decoder.min_packed_array_length(options.min_packed_array_length());
 
         basic_json_reader<char_type, string_source<char_type>,TempAllocator> reader(s, decoder, options, alloc_set.get_temp_allocator());
         reader.read();
@@ -176,6 +188,9 @@ namespace jsoncons {
                 const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
     {
         json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        decoder.max_interned_keys(options.max_interned_keys());
+        decoder.max_length_hint(options.max_length_hint());
+        decoder.min_packed_array_length(options.min_packed_array_length());
 
         basic_json_reader<CharT, stream_source<CharT>,TempAllocator> reader(is, decoder, options, alloc_set.get_temp_allocator());
         reader.read();
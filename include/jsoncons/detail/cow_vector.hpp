@@ -0,0 +1,755 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_COW_VECTOR_HPP
+#define JSONCONS_DETAIL_COW_VECTOR_HPP
+
+#include <algorithm> // std::rotate, std::equal, std::lexicographical_compare
+#include <atomic>
+#include <cassert> // assert
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator_traits, std::pointer_traits
+#include <new> // placement new
+#include <stdexcept> // std::length_error, std::out_of_range
+#include <type_traits>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/extension_traits.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // cow_vector
+    // A sequence container with the interface of std::vector used by json_array and the json objects, that
+    // shares its elements with its copies. The elements are kept in a reference counted buffer, copying the
+    // container takes constant time, and the first modification of a container that shares its buffer
+    // copies the elements into a buffer of its own.
+    //
+    // A reference or iterator obtained through a non-const member function could be used to modify the
+    // elements later, so such a function also marks the buffer as not shareable, and copies of the container
+    // copy the elements, as std::vector does. The buffer becomes shareable again when it is replaced, when
+    // the container grows past its capacity, or is cleared. 
+    //
+    // A reference or iterator obtained through a const member function may refer to a buffer that is shared,
+    // or shared later, so a container that has handed one out and copies a shared buffer to modify it keeps
+    // its share of the old buffer, and the reference refers to the elements as they were when copied. The old 
+    // buffer is given up, and the buffer becomes shareable again, when the elements are next replaced or cleared.
+
+    template <class T, class Allocator>
+    class cow_vector
+    {
+    public:
+        using value_type = T;
+        using allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    private:
+        // The buffer starts with a header, followed by the elements
+        struct header
+        {
+            std::atomic<size_type> refs;
+            size_type size;
+            size_type capacity;
+
+            header(size_type n)
+                : refs(1), size(0), capacity(n)
+            {
+            }
+        };
+
+        using header_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<header>;
+        using header_allocator_traits = std::allocator_traits<header_allocator_type>;
+        using allocator_traits_type = std::allocator_traits<allocator_type>;
+
+        allocator_type alloc_;
+        header* block_;
+        bool shareable_;
+        // True if a const member function may have handed out a reference or iterator to the elements
+        mutable std::atomic<bool> refs_out_;
+        // The buffer shared when the elements were copied to be modified, kept for references handed out 
+        // before. Only set when the buffer is not shareable, so it is never needed for more than one.
+        header* retained_;
+    public:
+        cow_vector()
+            : alloc_(), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+        }
+
+        explicit cow_vector(const allocator_type& alloc)
+            : alloc_(alloc), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+        }
+
+        cow_vector(size_type n, const T& value, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+            resize(n, value);
+        }
+
+        template <class InputIt>
+        cow_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+        }
+
+        cow_vector(const std::initializer_list<T>& init, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+            append(init.begin(), init.end(), std::random_access_iterator_tag());
+        }
+
+        cow_vector(const cow_vector& other)
+            : alloc_(allocator_traits_type::select_on_container_copy_construction(other.alloc_)),
+              block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+            copy_from(other);
+        }
+
+        cow_vector(const cow_vector& other, const allocator_type& alloc)
+            : alloc_(alloc), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+            copy_from(other);
+        }
+
+        cow_vector(cow_vector&& other) noexcept
+            : alloc_(other.alloc_), block_(other.block_), shareable_(other.shareable_), 
+              refs_out_(other.refs_out_.load(std::memory_order_relaxed)), retained_(other.retained_)
+        {
+            other.block_ = nullptr;
+            other.shareable_ = true;
+            other.refs_out_.store(false, std::memory_order_relaxed);
+            other.retained_ = nullptr;
+        }
+
+        cow_vector(cow_vector&& other, const allocator_type& alloc)
+            : alloc_(alloc), block_(nullptr), shareable_(true), refs_out_(false), retained_(nullptr)
+        {
+            move_from(other);
+        }
+
+        ~cow_vector() noexcept
+        {
+            release();
+        }
+
+        cow_vector& operator=(const cow_vector& other)
+        {
+            if (this != &other)
+            {
+                release();
+                propagate_allocator(typename allocator_traits_type::propagate_on_container_copy_assignment(), other.alloc_);
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        // Copies or moves the elements one by one, which may allocate, only when the allocators are unequal and not propagated
+        cow_vector& operator=(cow_vector&& other) noexcept(allocator_traits_type::propagate_on_container_move_assignment::value ||
+                                                           extension_traits::is_stateless<allocator_type>::value)
+        {
+            if (this != &other)
+            {
+                release();
+                propagate_allocator(typename allocator_traits_type::propagate_on_container_move_assignment(), other.alloc_);
+                move_from(other);
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return block_ ? block_->size : 0;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return block_ ? block_->capacity : 0;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::min)(size_type(allocator_traits_type::max_size(alloc_)),
+                              size_type((std::numeric_limits<difference_type>::max)())/sizeof(T));
+        }
+
+        // The number of containers sharing the elements, 0 if there are none
+        size_type use_count() const noexcept
+        {
+            return block_ ? block_->refs.load(std::memory_order_acquire) : 0;
+        }
+
+        // Bytes allocated for the buffer, which may be shared with copies
+        std::size_t allocated_bytes() const noexcept
+        {
+            return block_ ? block_length(block_->capacity)*sizeof(header) : 0;
+        }
+
+        // False if a copy would copy the elements rather than share them
+        bool is_shareable() const noexcept
+        {
+            return shareable_;
+        }
+
+        T* data() {return leak();}
+        const T* data() const noexcept {return hand_out();}
+
+        iterator begin() {return leak();}
+        iterator end() {return leak() + size();}
+        const_iterator begin() const noexcept {return hand_out();}
+        const_iterator end() const noexcept {return hand_out() + size();}
+        const_iterator cbegin() const noexcept {return hand_out();}
+        const_iterator cend() const noexcept {return hand_out() + size();}
+        reverse_iterator rbegin() {return reverse_iterator(end());}
+        reverse_iterator rend() {return reverse_iterator(begin());}
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        T& operator[](size_type i) {return leak()[i];}
+        const T& operator[](size_type i) const {return hand_out()[i];}
+
+        T& at(size_type i)
+        {
+            if (i >= size())
+            {
+                JSONCONS_THROW(std::out_of_range("cow_vector index out of range"));
+            }
+            return leak()[i];
+        }
+
+        const T& at(size_type i) const
+        {
+            if (i >= size())
+            {
+                JSONCONS_THROW(std::out_of_range("cow_vector index out of range"));
+            }
+            return hand_out()[i];
+        }
+
+        T& front() {return leak()[0];}
+        const T& front() const {return hand_out()[0];}
+        T& back() {return leak()[size()-1];}
+        const T& back() const {return hand_out()[size()-1];}
+
+        void reserve(size_type n)
+        {
+            if (n > capacity())
+            {
+                reallocate(n);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (block_ && block_->size < block_->capacity)
+            {
+                reallocate(block_->size);
+            }
+        }
+
+        void clear() noexcept
+        {
+            if (block_)
+            {
+                if (is_shared())
+                {
+                    release();
+                }
+                else
+                {
+                    destroy_range(elements(block_), elements(block_) + block_->size);
+                    block_->size = 0;
+                }
+            }
+            release_retained();
+            shareable_ = true;
+            refs_out_.store(false, std::memory_order_relaxed);
+        }
+
+        // Unlike std::vector::emplace_back, returns nothing, since a reference to the new element
+        // would make the buffer unshareable
+        template <class... Args>
+        void emplace_back(Args&&... args)
+        {
+            if (block_ == nullptr || block_->size == block_->capacity || is_shared())
+            {
+                // Construct the new element before copying the old ones, args may refer to one of them
+                size_type count = size();
+                size_type new_capacity = count < capacity() ? capacity() : next_capacity(count + 1);
+                header* new_block = allocate(new_capacity);
+                JSONCONS_TRY
+                {
+                    allocator_traits_type::construct(alloc_, elements(new_block) + count, std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    deallocate(new_block);
+                    JSONCONS_RETHROW;
+                }
+                JSONCONS_TRY
+                {
+                    transfer_to(new_block, count);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    allocator_traits_type::destroy(alloc_, elements(new_block) + count);
+                    deallocate(new_block);
+                    JSONCONS_RETHROW;
+                }
+            }
+            else
+            {
+                allocator_traits_type::construct(alloc_, elements(block_) + block_->size, std::forward<Args>(args)...);
+            }
+            ++block_->size;
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back()
+        {
+            unshare();
+            --block_->size;
+            allocator_traits_type::destroy(alloc_, elements(block_) + block_->size);
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            size_type index = static_cast<size_type>(pos - cdata());
+            emplace_back(std::forward<Args>(args)...);
+            T* p = leak();
+            std::rotate(p + index, p + size() - 1, p + size());
+            return p + index;
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            size_type index = static_cast<size_type>(pos - cdata());
+            size_type old_size = size();
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+            T* p = leak();
+            std::rotate(p + index, p + old_size, p + size());
+            return p + index;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type index1 = static_cast<size_type>(first - cdata());
+            size_type index2 = static_cast<size_type>(last - cdata());
+            erase_range(index1, index2);
+            return leak() + index1;
+        }
+
+        void resize(size_type n)
+        {
+            if (n < size())
+            {
+                erase_range(n, size());
+            }
+            else
+            {
+                reserve(n);
+                while (size() < n)
+                {
+                    emplace_back();
+                }
+            }
+        }
+
+        void resize(size_type n, const T& value)
+        {
+            if (n < size())
+            {
+                erase_range(n, size());
+            }
+            else
+            {
+                reserve(n);
+                while (size() < n)
+                {
+                    emplace_back(value);
+                }
+            }
+        }
+
+        // Swaps the allocators if propagate_on_container_swap is true, otherwise they must be equal, as for std::vector
+        void swap(cow_vector& other) noexcept
+        {
+            assert(allocator_traits_type::propagate_on_container_swap::value || alloc_ == other.alloc_);
+            swap_allocator(typename allocator_traits_type::propagate_on_container_swap(), other);
+            std::swap(block_, other.block_);
+            std::swap(shareable_, other.shareable_);
+            bool refs_out = refs_out_.load(std::memory_order_relaxed);
+            refs_out_.store(other.refs_out_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.refs_out_.store(refs_out, std::memory_order_relaxed);
+            std::swap(retained_, other.retained_);
+        }
+
+        friend bool operator==(const cow_vector& lhs, const cow_vector& rhs)
+        {
+            return lhs.size() == rhs.size() && (lhs.block_ == rhs.block_ || std::equal(lhs.cdata(), lhs.cdata() + lhs.size(), rhs.cdata()));
+        }
+
+        friend bool operator!=(const cow_vector& lhs, const cow_vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const cow_vector& lhs, const cow_vector& rhs)
+        {
+            return std::lexicographical_compare(lhs.cdata(), lhs.cdata() + lhs.size(), rhs.cdata(), rhs.cdata() + rhs.size());
+        }
+
+    private:
+        static T* elements(header* block) noexcept
+        {
+            static_assert(alignof(T) <= alignof(header), "Elements must not need more alignment than the header");
+            return reinterpret_cast<T*>(block + 1);
+        }
+
+        const T* cdata() const noexcept
+        {
+            return block_ ? elements(block_) : nullptr;
+        }
+
+        // The elements, for a const member function that hands out references or iterators to them
+        const T* hand_out() const noexcept
+        {
+            if (block_ && !refs_out_.load(std::memory_order_relaxed))
+            {
+                refs_out_.store(true, std::memory_order_relaxed);
+            }
+            return cdata();
+        }
+
+        bool is_shared() const noexcept
+        {
+            return block_ && block_->refs.load(std::memory_order_acquire) > 1;
+        }
+
+        void propagate_allocator(std::true_type, const allocator_type& alloc) noexcept
+        {
+            alloc_ = alloc;
+        }
+
+        void propagate_allocator(std::false_type, const allocator_type&) noexcept
+        {
+        }
+
+        void swap_allocator(std::true_type, cow_vector& other) noexcept
+        {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+
+        void swap_allocator(std::false_type, cow_vector&) noexcept
+        {
+        }
+
+        // Gives the container a buffer of its own, to be modified through the returned pointer
+        T* leak()
+        {
+            unshare();
+            shareable_ = false;
+            return block_ ? elements(block_) : nullptr;
+        }
+
+        void unshare()
+        {
+            if (is_shared())
+            {
+                reallocate(block_->capacity);
+            }
+        }
+
+        size_type next_capacity(size_type min_capacity) const
+        {
+            if (min_capacity > max_size())
+            {
+                JSONCONS_THROW(std::length_error("cow_vector too long"));
+            }
+            size_type new_capacity = capacity() <= max_size()/2 ? capacity()*2 : max_size();
+            return (std::max)(new_capacity, min_capacity);
+        }
+
+        // Number of headers taken by a buffer for n elements
+        static size_type block_length(size_type n) noexcept
+        {
+            return 1 + (n*sizeof(T) + sizeof(header) - 1)/sizeof(header);
+        }
+
+        header* allocate(size_type n)
+        {
+            header_allocator_type alloc(alloc_);
+            header* block = extension_traits::to_plain_pointer(header_allocator_traits::allocate(alloc, block_length(n)));
+            ::new(block) header(n);
+            return block;
+        }
+
+        void deallocate(header* block) noexcept
+        {
+            header_allocator_type alloc(alloc_);
+            size_type length = block_length(block->capacity);
+            auto p = std::pointer_traits<typename header_allocator_traits::pointer>::pointer_to(*block);
+            block->~header();
+            header_allocator_traits::deallocate(alloc, p, length);
+        }
+
+        void destroy_range(T* first, T* last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                allocator_traits_type::destroy(alloc_, first);
+            }
+        }
+
+        // Gives up a share of block, destroying the elements if it was the last
+        void release_block(header* block) noexcept
+        {
+            if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                destroy_range(elements(block), elements(block) + block->size);
+                deallocate(block);
+            }
+        }
+
+        void release_retained() noexcept
+        {
+            if (retained_)
+            {
+                release_block(retained_);
+                retained_ = nullptr;
+            }
+        }
+
+        // Gives up this container's share of the buffer, and of the buffer retained for references
+        void release() noexcept
+        {
+            if (block_)
+            {
+                release_block(block_);
+                block_ = nullptr;
+            }
+            release_retained();
+            shareable_ = true;
+            refs_out_.store(false, std::memory_order_relaxed);
+        }
+
+        // Moves the first count elements into new_block, or copies them if the buffer is shared,
+        // and replaces the buffer. If copying throws, new_block is left to the caller.
+        void transfer_to(header* new_block, size_type count)
+        {
+            T* dest = elements(new_block);
+            if (is_shared())
+            {
+                size_type i = 0;
+                JSONCONS_TRY
+                {
+                    for (; i < count; ++i)
+                    {
+                        allocator_traits_type::construct(alloc_, dest + i, static_cast<const T&>(elements(block_)[i]));
+                    }
+                }
+                JSONCONS_CATCH(...)
+                {
+                    destroy_range(dest, dest + i);
+                    JSONCONS_RETHROW;
+                }
+            }
+            else if (block_)
+            {
+                T* src = elements(block_);
+                for (size_type i = 0; i < count; ++i)
+                {
+                    allocator_traits_type::construct(alloc_, dest + i, std::move(src[i]));
+                }
+            }
+            new_block->size = count;
+            if (is_shared() && refs_out_.load(std::memory_order_relaxed))
+            {
+                // Keeps this container's share of the old buffer for the references handed out. 
+                // retained_ is not set, since the old buffer was shareable.
+                retained_ = block_;
+                block_ = new_block;
+                shareable_ = false;
+                refs_out_.store(false, std::memory_order_relaxed);
+            }
+            else
+            {
+                release();
+                block_ = new_block;
+            }
+        }
+
+        void reallocate(size_type new_capacity)
+        {
+            header* new_block = allocate(new_capacity);
+            JSONCONS_TRY
+            {
+                transfer_to(new_block, size());
+            }
+            JSONCONS_CATCH(...)
+            {
+                deallocate(new_block);
+                JSONCONS_RETHROW;
+            }
+        }
+
+        void erase_range(size_type index1, size_type index2)
+        {
+            if (index1 != index2)
+            {
+                unshare();
+                T* p = elements(block_);
+                T* new_end = std::move(p + index2, p + block_->size, p + index1);
+                destroy_range(new_end, p + block_->size);
+                block_->size -= (index2 - index1);
+            }
+        }
+
+        void copy_from(const cow_vector& other)
+        {
+            if (other.block_ && other.shareable_ && alloc_ == other.alloc_)
+            {
+                other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+                block_ = other.block_;
+            }
+            else
+            {
+                append(other.cdata(), other.cdata() + other.size(), std::random_access_iterator_tag());
+            }
+        }
+
+        // *this must be empty
+        void move_from(cow_vector& other)
+        {
+            if (alloc_ == other.alloc_)
+            {
+                block_ = other.block_;
+                shareable_ = other.shareable_;
+                refs_out_.store(other.refs_out_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                retained_ = other.retained_;
+                other.block_ = nullptr;
+                other.shareable_ = true;
+                other.refs_out_.store(false, std::memory_order_relaxed);
+                other.retained_ = nullptr;
+            }
+            else
+            {
+                if (other.is_shared())
+                {
+                    append(other.cdata(), other.cdata() + other.size(), std::random_access_iterator_tag());
+                }
+                else
+                {
+                    append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                           std::random_access_iterator_tag());
+                }
+                other.clear();
+            }
+        }
+
+        template <class InputIt>
+        void append(InputIt first, InputIt last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+
+        template <class ForwardIt>
+        void append(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+        {
+            reserve(size() + static_cast<size_type>(std::distance(first, last)));
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+    };
+
+    // True if c shares its elements with a copy
+    template <class Container>
+    bool is_shared_container(const Container&) noexcept
+    {
+        return false;
+    }
+
+    template <class T, class Allocator>
+    bool is_shared_container(const cow_vector<T,Allocator>& c) noexcept
+    {
+        return c.use_count() > 1;
+    }
+
+    template <class Container>
+    using container_allocated_bytes_t = decltype(std::declval<const Container&>().allocated_bytes());
+
+    // Bytes allocated by c for its elements, not including memory the elements own
+    template <class Container>
+    typename std::enable_if<extension_traits::is_detected<container_allocated_bytes_t,Container>::value,std::size_t>::type
+    container_allocated_bytes(const Container& c) noexcept
+    {
+        return c.allocated_bytes();
+    }
+
+    template <class Container>
+    typename std::enable_if<!extension_traits::is_detected<container_allocated_bytes_t,Container>::value,std::size_t>::type
+    container_allocated_bytes(const Container& c) noexcept
+    {
+        return c.capacity()*sizeof(typename Container::value_type);
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,68 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_HPP
+#define JSONCONS_DETAIL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+
+namespace jsoncons {
+namespace detail {
+
+    // Final mixing step of MurmurHash3, spreads every input bit over the low bits used for bucket masks
+    inline uint64_t hash_mix(uint64_t h) noexcept
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // A fast non-cryptographic hash of a character sequence, consumes eight bytes at a time
+    template <class CharT>
+    std::size_t hash_chars(const CharT* s, std::size_t length) noexcept
+    {
+        const uint64_t k = 0x9e3779b97f4a7c15ULL;
+
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+        std::size_t n = length*sizeof(CharT);
+        uint64_t h = static_cast<uint64_t>(n)*k;
+
+        while (n >= 8)
+        {
+            uint64_t w;
+            std::memcpy(&w, p, 8);
+            h = (h ^ hash_mix(w))*k;
+            p += 8;
+            n -= 8;
+        }
+        if (n > 0)
+        {
+            uint64_t w = 0;
+            std::memcpy(&w, p, n);
+            h = (h ^ hash_mix(w))*k;
+        }
+        return static_cast<std::size_t>(hash_mix(h));
+    }
+
+    // Hash function object for strings and string views
+    struct string_hash
+    {
+        template <class String>
+        std::size_t operator()(const String& s) const noexcept
+        {
+            return hash_chars(s.data(), s.size());
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
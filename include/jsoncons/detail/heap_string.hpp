@@ -131,12 +131,16 @@ namespace detail {
 
     public:
 
-        static pointer create(const char_type* s, std::size_t length, Extra extra, const Allocator& alloc)
+        // Number of bytes allocated for a string of the given length
+        static std::size_t allocation_size(std::size_t length)
         {
-            std::size_t len = aligned_size(length*sizeof(char_type));
+            return (alignof(storage_type)-1) + aligned_size(length*sizeof(char_type));
+        }
 
+        static pointer create(const char_type* s, std::size_t length, Extra extra, const Allocator& alloc)
+        {
             std::size_t align = alignof(storage_type);
-            std::size_t mem_len = (align-1)+len;
+            std::size_t mem_len = allocation_size(length);
 
             byte_allocator_type byte_alloc(alloc);
             byte_pointer ptr = byte_alloc.allocate(mem_len);
@@ -0,0 +1,271 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_JSON_SCAN_HPP
+#define JSONCONS_DETAIL_JSON_SCAN_HPP
+
+/*
+Scanning of strict JSON tokens held in memory, shared by the tape builder and the
+on-demand reader. Positions are pointers into the text, and the end of the text
+counts as a token terminator.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/simd.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+
+namespace jsoncons { namespace detail {
+
+    // True if p is the end of the text, whitespace, or a character that may follow a value
+    inline
+    bool is_json_terminator(const char* p, const char* end) noexcept
+    {
+        if (p == end)
+        {
+            return true;
+        }
+        switch (*p)
+        {
+            case ' ': case '\t': case '\n': case '\r':
+            case ',': case ']': case '}':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    inline
+    int json_hex_value(char c) noexcept
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Reads the four hex digits at p, p must have at least four characters
+    inline
+    bool read_json_hex4(const char* p, uint32_t& cp) noexcept
+    {
+        cp = 0;
+        for (int k = 0; k < 4; ++k)
+        {
+            int h = json_hex_value(p[k]);
+            if (h < 0)
+            {
+                return false;
+            }
+            cp = (cp << 4) | static_cast<uint32_t>(h);
+        }
+        return true;
+    }
+
+    template <class CharContainer>
+    void append_utf8_codepoint(uint32_t cp, CharContainer& out)
+    {
+        if (cp < 0x80)
+        {
+            out.push_back(static_cast<char>(cp));
+        }
+        else if (cp < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    // unescape_json_string
+    // first points just past the opening quote. Appends the unescaped characters to out and
+    // validates them as UTF-8. On success sets last to the closing quote, on failure to the
+    // offending character, or to end if the string is not closed.
+
+    template <class CharContainer>
+    json_errc unescape_json_string(const char* first, const char* end, CharContainer& out, const char*& last)
+    {
+        const char* p = first;
+        for (;;)
+        {
+            const char* q = jsoncons::detail::find_string_special(p, end);
+            out.insert(out.end(), p, q);
+            if (JSONCONS_UNLIKELY(q == end))
+            {
+                last = end;
+                return json_errc::unexpected_eof;
+            }
+            if (*q == '\"')
+            {
+                last = q;
+                break;
+            }
+            if (JSONCONS_UNLIKELY(*q != '\\'))
+            {
+                last = q;
+                return json_errc::illegal_control_character;
+            }
+            ++q;
+            if (JSONCONS_UNLIKELY(q == end))
+            {
+                last = end;
+                return json_errc::unexpected_eof;
+            }
+            switch (*q)
+            {
+                case '\"': out.push_back('\"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/': out.push_back('/'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u':
+                {
+                    uint32_t cp;
+                    if (end - q < 5 || !read_json_hex4(q + 1, cp))
+                    {
+                        last = q;
+                        return json_errc::invalid_unicode_escape_sequence;
+                    }
+                    q += 4;
+                    if (cp >= 0xD800 && cp <= 0xDFFF)
+                    {
+                        // Only a high surrogate followed by an escaped low surrogate is accepted
+                        uint32_t low;
+                        if (cp > 0xDBFF || end - q < 7 || q[1] != '\\' || q[2] != 'u' ||
+                            !read_json_hex4(q + 3, low) || low < 0xDC00 || low > 0xDFFF)
+                        {
+                            last = q;
+                            return json_errc::expected_codepoint_surrogate_pair;
+                        }
+                        cp = 0x10000 + (((cp - 0xD800) << 10) | (low - 0xDC00));
+                        q += 6;
+                    }
+                    append_utf8_codepoint(cp, out);
+                    break;
+                }
+                default:
+                    last = q;
+                    return json_errc::illegal_escaped_character;
+            }
+            p = q + 1;
+        }
+
+        // Escape sequences are ASCII, so the raw text is valid UTF-8 if and only if the unescaped text is
+        auto result = jsoncons::detail::fast_validate(first, static_cast<std::size_t>(last - first));
+        if (JSONCONS_UNLIKELY(result.ec != unicode_traits::conv_errc()))
+        {
+            last = result.ptr;
+            return json_errc::illegal_codepoint;
+        }
+        return json_errc();
+    }
+
+    // scan_json_number
+    // Returns one past the end of the number that starts at first, or nullptr if the text
+    // at first is not a number. is_integer is set if there is no fraction or exponent.
+
+    inline
+    const char* scan_json_number(const char* first, const char* end, bool& is_integer)
+    {
+        const char* cur = first;
+        if (cur != end && *cur == '-')
+        {
+            ++cur;
+        }
+        if (cur == end || !(*cur >= '0' && *cur <= '9'))
+        {
+            return nullptr;
+        }
+        if (*cur == '0')
+        {
+            ++cur;
+        }
+        else
+        {
+            cur = jsoncons::detail::skip_digits(cur, end);
+        }
+        is_integer = true;
+        if (cur != end && *cur == '.')
+        {
+            ++cur;
+            if (cur == end || !(*cur >= '0' && *cur <= '9'))
+            {
+                return nullptr;
+            }
+            cur = jsoncons::detail::skip_digits(cur, end);
+            is_integer = false;
+        }
+        if (cur != end && (*cur == 'e' || *cur == 'E'))
+        {
+            ++cur;
+            if (cur != end && (*cur == '+' || *cur == '-'))
+            {
+                ++cur;
+            }
+            if (cur == end || !(*cur >= '0' && *cur <= '9'))
+            {
+                return nullptr;
+            }
+            cur = jsoncons::detail::skip_digits(cur, end);
+            is_integer = false;
+        }
+        return cur;
+    }
+
+    // json_text_position
+    // The line and column of the character at offset, counting line breaks as basic_json_parser does.
+    // As there, the column on a line that follows \r\n counts the \n.
+
+    inline
+    void json_text_position(const char* data, std::size_t offset, std::size_t& line, std::size_t& column)
+    {
+        line = 1;
+        std::size_t mark = 0;
+        for (std::size_t i = 0; i < offset; ++i)
+        {
+            if (data[i] == '\n')
+            {
+                ++line;
+                mark = i + 1;
+            }
+            else if (data[i] == '\r')
+            {
+                ++line;
+                if (i + 1 < offset && data[i + 1] == '\n')
+                {
+                    ++i;
+                    mark = i;
+                }
+                else
+                {
+                    mark = i + 1;
+                }
+            }
+        }
+        column = (offset - mark) + 1;
+    }
+
+}} // namespace detail namespace jsoncons
+
+#endif
@@ -0,0 +1,558 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_PACKED_ARRAY_HPP
+#define JSONCONS_DETAIL_PACKED_ARRAY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::allocator_traits, std::pointer_traits
+#include <type_traits> // std::true_type
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/extension_traits.hpp>
+#include <jsoncons/json_type.hpp>
+#include <jsoncons/tag_type.hpp>
+#include <jsoncons/typed_array_view.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // True for a policy, such as nan_boxed_policy, that keeps arrays as NaN-boxed packed arrays
+    template <class Policy,class Enable=void>
+    struct is_nan_boxed_policy : std::false_type
+    {
+    };
+
+    template <class Policy>
+    struct is_nan_boxed_policy<Policy,typename std::enable_if<Policy::nan_boxed_arrays>::type> : std::true_type
+    {
+    };
+
+    // packed_array
+    // The elements of a basic_json array of numbers of one type, such as a CBOR typed array, kept
+    // as a contiguous buffer of that type rather than as basic_json values. The elements are read
+    // through value_at, or as basic_json values through elements(), which builds an array of them
+    // the first time it is called and keeps it until the packed array is destroyed.
+
+    // A NaN-boxed packed array keeps the elements of any array as 64 bit words instead. A double
+    // without a semantic tag is its own bits, with NaNs made the positive quiet NaN. A word with 
+    // the bits of a negative quiet NaN, 0xfff8 in its top 13 bits, holds a kind in bits 48-50 and
+    // a payload in bits 0-47: a null, a bool, an integer that fits in 48 bits, or the index of an 
+    // element kept as a basic_json value in others().
+
+    // The allocator is passed to the constructors explicitly. allocator_type is private, so that a
+    // scoped allocator does not pass its inner allocator to them as well.
+
+    template <class Json>
+    class packed_array
+    {
+    public:
+        using array = typename Json::array;
+    private:
+        using allocator_type = typename Json::allocator_type;
+        // Elements are stored in a buffer of 64 bit words, which is aligned for all element types
+        using word_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint64_t>;
+        using word_pointer = typename std::allocator_traits<word_allocator_type>::pointer;
+        using array_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<array>;
+        using array_pointer = typename std::allocator_traits<array_allocator_type>::pointer;
+
+        static constexpr uint64_t box_mask = 0xfff8000000000000;
+        static constexpr uint64_t payload_mask = 0x0000ffffffffffff;
+        static constexpr uint64_t canonical_nan = 0x7ff8000000000000;
+        static constexpr int kind_shift = 48;
+
+        enum class box_kind : uint8_t {null_value, bool_value, int64_value, uint64_value, other_value};
+
+        allocator_type alloc_;
+        typed_array_type type_;
+        bool boxed_;
+        std::size_t size_;
+        word_pointer data_;
+        array others_;
+        mutable std::atomic<array*> elements_;
+    public:
+
+        template <class T>
+        packed_array(const T* data, std::size_t size, const allocator_type& alloc)
+            : alloc_(alloc), type_(typed_array_view(data, size).type()), boxed_(false), size_(size), 
+              data_(nullptr), others_(alloc), elements_(nullptr)
+        {
+            init(data);
+        }
+
+        packed_array(half_arg_t, const uint16_t* data, std::size_t size, const allocator_type& alloc)
+            : alloc_(alloc), type_(typed_array_type::half_value), boxed_(false), size_(size), 
+              data_(nullptr), others_(alloc), elements_(nullptr)
+        {
+            init(data);
+        }
+
+        // Moves the elements into a NaN-boxed packed array
+        packed_array(nan_boxed_array_arg_t, array&& elements, const allocator_type& alloc)
+            : alloc_(alloc), type_(typed_array_type::double_value), boxed_(true), size_(elements.size()), 
+              data_(nullptr), others_(alloc), elements_(nullptr)
+        {
+            if (size_ == 0)
+            {
+                return;
+            }
+            std::size_t count = 0;
+            for (const auto& item : elements)
+            {
+                if (!fits_in_word(item))
+                {
+                    ++count;
+                }
+            }
+            others_.reserve(count);
+            word_allocator_type alloc_words(get_allocator());
+            data_ = std::allocator_traits<word_allocator_type>::allocate(alloc_words, size_);
+
+            // No allocation from here, the elements that do not fit in a word are moved into reserved space
+            uint64_t* words = extension_traits::to_plain_pointer(data_);
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                if (fits_in_word(elements[i]))
+                {
+                    words[i] = to_word(elements[i]);
+                }
+                else
+                {
+                    words[i] = to_word(box_kind::other_value, others_.size());
+                    others_.emplace_back(std::move(elements[i]));
+                }
+            }
+        }
+
+        packed_array(const packed_array& other)
+            : packed_array(other, other.get_allocator())
+        {
+        }
+
+        packed_array(const packed_array& other, const allocator_type& alloc)
+            : alloc_(alloc), type_(other.type_), boxed_(other.boxed_), size_(other.size_), data_(nullptr), 
+              others_(other.others_, alloc), elements_(nullptr)
+        {
+            init(other.bytes());
+        }
+
+        packed_array& operator=(const packed_array&) = delete;
+
+        ~packed_array() noexcept
+        {
+            clear_elements();
+            if (data_ != nullptr)
+            {
+                word_allocator_type alloc(get_allocator());
+                std::allocator_traits<word_allocator_type>::deallocate(alloc, data_, word_count());
+            }
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        // True if val is kept in its word in a NaN-boxed packed array, rather than in others()
+        static bool fits_in_word(const Json& val) noexcept
+        {
+            if (val.tag() != semantic_tag::none)
+            {
+                return false;
+            }
+            switch (val.storage_kind())
+            {
+                case json_storage_kind::null_value:
+                case json_storage_kind::bool_value:
+                case json_storage_kind::double_value:
+                    return true;
+                case json_storage_kind::int64_value:
+                {
+                    int64_t n = val.template as<int64_t>();
+                    return n >= -(int64_t(1) << 47) && n < (int64_t(1) << 47);
+                }
+                case json_storage_kind::uint64_value:
+                    return val.template as<uint64_t>() <= payload_mask;
+                default:
+                    return false;
+            }
+        }
+
+        // True if the elements take less memory NaN-boxed, as a word each and a basic_json for 
+        // each element that does not fit in its word, than as a basic_json each
+        template <class Iterator>
+        static bool nan_boxing_saves_memory(Iterator first, Iterator last)
+        {
+            std::size_t size = 0;
+            std::size_t count = 0;
+            for (Iterator it = first; it != last; ++it)
+            {
+                ++size;
+                if (!fits_in_word(*it))
+                {
+                    ++count;
+                }
+            }
+            return size > 0 && 2*count < size;
+        }
+
+        static std::size_t element_size(typed_array_type type)
+        {
+            switch (type)
+            {
+                case typed_array_type::uint8_value:
+                case typed_array_type::int8_value:
+                    return 1;
+                case typed_array_type::uint16_value:
+                case typed_array_type::int16_value:
+                case typed_array_type::half_value:
+                    return 2;
+                case typed_array_type::uint32_value:
+                case typed_array_type::int32_value:
+                case typed_array_type::float_value:
+                    return 4;
+                default:
+                    return 8;
+            }
+        }
+
+        // The type of the numbers, if not NaN-boxed
+        typed_array_type type() const noexcept
+        {
+            return type_;
+        }
+
+        bool is_nan_boxed() const noexcept
+        {
+            return boxed_;
+        }
+
+        // The elements of a NaN-boxed packed array that do not fit in a word
+        const array& others() const noexcept
+        {
+            return others_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        typed_array_view view() const
+        {
+            JSONCONS_ASSERT(!boxed_);
+            switch (type_)
+            {
+                case typed_array_type::uint8_value:
+                    return typed_array_view(data<uint8_t>(), size_);
+                case typed_array_type::uint16_value:
+                    return typed_array_view(data<uint16_t>(), size_);
+                case typed_array_type::uint32_value:
+                    return typed_array_view(data<uint32_t>(), size_);
+                case typed_array_type::uint64_value:
+                    return typed_array_view(data<uint64_t>(), size_);
+                case typed_array_type::int8_value:
+                    return typed_array_view(data<int8_t>(), size_);
+                case typed_array_type::int16_value:
+                    return typed_array_view(data<int16_t>(), size_);
+                case typed_array_type::int32_value:
+                    return typed_array_view(data<int32_t>(), size_);
+                case typed_array_type::int64_value:
+                    return typed_array_view(data<int64_t>(), size_);
+                case typed_array_type::half_value:
+                    return typed_array_view(half_array_arg, data<uint16_t>(), size_);
+                case typed_array_type::float_value:
+                    return typed_array_view(data<float>(), size_);
+                default:
+                    return typed_array_view(data<double>(), size_);
+            }
+        }
+
+        // Returns the element at index i as a basic_json value with the storage kind the decoders give it
+        Json value_at(std::size_t i) const
+        {
+            JSONCONS_ASSERT(i < size_);
+            if (boxed_)
+            {
+                return boxed_value_at(i);
+            }
+            switch (type_)
+            {
+                case typed_array_type::uint8_value:
+                    return Json(static_cast<uint64_t>(data<uint8_t>()[i]), semantic_tag::none);
+                case typed_array_type::uint16_value:
+                    return Json(static_cast<uint64_t>(data<uint16_t>()[i]), semantic_tag::none);
+                case typed_array_type::uint32_value:
+                    return Json(static_cast<uint64_t>(data<uint32_t>()[i]), semantic_tag::none);
+                case typed_array_type::uint64_value:
+                    return Json(data<uint64_t>()[i], semantic_tag::none);
+                case typed_array_type::int8_value:
+                    return Json(static_cast<int64_t>(data<int8_t>()[i]), semantic_tag::none);
+                case typed_array_type::int16_value:
+                    return Json(static_cast<int64_t>(data<int16_t>()[i]), semantic_tag::none);
+                case typed_array_type::int32_value:
+                    return Json(static_cast<int64_t>(data<int32_t>()[i]), semantic_tag::none);
+                case typed_array_type::int64_value:
+                    return Json(data<int64_t>()[i], semantic_tag::none);
+                case typed_array_type::half_value:
+                    return Json(half_arg, data<uint16_t>()[i], semantic_tag::none);
+                case typed_array_type::float_value:
+                    return Json(static_cast<double>(data<float>()[i]), semantic_tag::none);
+                default:
+                    return Json(data<double>()[i], semantic_tag::none);
+            }
+        }
+
+        // Returns the elements as basic_json values. The array is built on the first call, and
+        // concurrent calls on the same packed array return the same array.
+        const array& elements() const
+        {
+            array* p = elements_.load(std::memory_order_acquire);
+            if (p == nullptr)
+            {
+                array* q = create_elements();
+                if (elements_.compare_exchange_strong(p, q, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    p = q;
+                }
+                else
+                {
+                    destroy_elements(q);
+                }
+            }
+            return *p;
+        }
+
+        // Moves the elements out as basic_json values. References to the elements returned
+        // earlier by elements() refer to the elements of the returned array.
+        array release_elements()
+        {
+            array* p = elements_.load(std::memory_order_acquire);
+            if (p == nullptr)
+            {
+                array result(get_allocator());
+                if (boxed_)
+                {
+                    result.reserve(size_);
+                    for (std::size_t i = 0; i < size_; ++i)
+                    {
+                        uint64_t w = data<uint64_t>()[i];
+                        if (is_box(w) && kind_of(w) == box_kind::other_value)
+                        {
+                            result.emplace_back(std::move(others_[static_cast<std::size_t>(w & payload_mask)]));
+                        }
+                        else
+                        {
+                            result.emplace_back(value_at(i));
+                        }
+                    }
+                }
+                else
+                {
+                    fill(result);
+                }
+                return result;
+            }
+            array result(std::move(*p));
+            clear_elements();
+            return result;
+        }
+
+        // Frees the elements built by elements(), and unused capacity in others()
+        void shrink_to_fit()
+        {
+            clear_elements();
+            others_.shrink_to_fit();
+        }
+
+        // Bytes allocated for the words or numbers, and for the elements built by elements() if they 
+        // have been built, not including the memory held by others()
+        std::size_t allocated_bytes() const noexcept
+        {
+            std::size_t n = word_count()*sizeof(uint64_t);
+            array* p = elements_.load(std::memory_order_acquire);
+            if (p != nullptr)
+            {
+                n += sizeof(array) + p->allocated_bytes();
+            }
+            return n;
+        }
+
+        // Frees the elements built by elements()
+        void clear_elements() noexcept
+        {
+            array* p = elements_.exchange(nullptr, std::memory_order_acq_rel);
+            if (p != nullptr)
+            {
+                destroy_elements(p);
+            }
+        }
+    private:
+        std::size_t word_count() const noexcept
+        {
+            return boxed_ ? size_ : (size_*element_size(type_) + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+        }
+
+        static bool is_box(uint64_t w) noexcept
+        {
+            return (w & box_mask) == box_mask;
+        }
+
+        static box_kind kind_of(uint64_t w) noexcept
+        {
+            return static_cast<box_kind>((w >> kind_shift) & 0x07);
+        }
+
+        static uint64_t to_word(box_kind kind, uint64_t payload) noexcept
+        {
+            return box_mask | (static_cast<uint64_t>(kind) << kind_shift) | (payload & payload_mask);
+        }
+
+        static uint64_t to_word(const Json& val) noexcept
+        {
+            switch (val.storage_kind())
+            {
+                case json_storage_kind::null_value:
+                    return to_word(box_kind::null_value, 0);
+                case json_storage_kind::bool_value:
+                    return to_word(box_kind::bool_value, val.template as<bool>() ? 1 : 0);
+                case json_storage_kind::int64_value:
+                    return to_word(box_kind::int64_value, static_cast<uint64_t>(val.template as<int64_t>()));
+                case json_storage_kind::uint64_value:
+                    return to_word(box_kind::uint64_value, val.template as<uint64_t>());
+                default:
+                {
+                    double d = val.template as<double>();
+                    if (d != d)
+                    {
+                        return canonical_nan;
+                    }
+                    uint64_t w;
+                    std::memcpy(&w, &d, sizeof(double));
+                    return w;
+                }
+            }
+        }
+
+        Json boxed_value_at(std::size_t i) const
+        {
+            uint64_t w = data<uint64_t>()[i];
+            if (!is_box(w))
+            {
+                double d;
+                std::memcpy(&d, &w, sizeof(double));
+                return Json(d, semantic_tag::none);
+            }
+            uint64_t payload = w & payload_mask;
+            switch (kind_of(w))
+            {
+                case box_kind::null_value:
+                    return Json(null_type(), semantic_tag::none);
+                case box_kind::bool_value:
+                    return Json(payload != 0, semantic_tag::none);
+                case box_kind::int64_value:
+                    // Sign extends the 48 bit payload
+                    return Json(static_cast<int64_t>(payload & 0x00007fffffffffff) - static_cast<int64_t>(payload & 0x0000800000000000), 
+                                semantic_tag::none);
+                case box_kind::uint64_value:
+                    return Json(payload, semantic_tag::none);
+                default:
+                    return Json(json_const_pointer_arg, std::addressof(others_[static_cast<std::size_t>(payload)]));
+            }
+        }
+
+        void init(const void* data)
+        {
+            std::size_t n = word_count();
+            if (n > 0)
+            {
+                word_allocator_type alloc(get_allocator());
+                data_ = std::allocator_traits<word_allocator_type>::allocate(alloc, n);
+                std::memcpy(bytes(), data, size_*element_size(type_));
+            }
+        }
+
+        unsigned char* bytes()
+        {
+            return reinterpret_cast<unsigned char*>(extension_traits::to_plain_pointer(data_));
+        }
+
+        const unsigned char* bytes() const
+        {
+            return reinterpret_cast<const unsigned char*>(extension_traits::to_plain_pointer(data_));
+        }
+
+        template <class T>
+        const T* data() const
+        {
+            return reinterpret_cast<const T*>(extension_traits::to_plain_pointer(data_));
+        }
+
+        // The elements built by elements() are copies of the elements kept in others_, rather than
+        // values that refer to them, so that copies of the elements do not refer to this packed array
+        void fill(array& result) const
+        {
+            result.reserve(size_);
+            for (std::size_t i = 0; i < size_; ++i)
+            {
+                uint64_t w = boxed_ ? data<uint64_t>()[i] : 0;
+                if (boxed_ && is_box(w) && kind_of(w) == box_kind::other_value)
+                {
+                    result.emplace_back(others_[static_cast<std::size_t>(w & payload_mask)]);
+                }
+                else
+                {
+                    result.emplace_back(value_at(i));
+                }
+            }
+        }
+
+        array* create_elements() const
+        {
+            array_allocator_type alloc(get_allocator());
+            array_pointer ptr = std::allocator_traits<array_allocator_type>::allocate(alloc, 1);
+            array* p = extension_traits::to_plain_pointer(ptr);
+            JSONCONS_TRY
+            {
+                std::allocator_traits<array_allocator_type>::construct(alloc, p, array(get_allocator()));
+            }
+            JSONCONS_CATCH(...)
+            {
+                std::allocator_traits<array_allocator_type>::deallocate(alloc, ptr, 1);
+                JSONCONS_RETHROW;
+            }
+            JSONCONS_TRY
+            {
+                fill(*p);
+            }
+            JSONCONS_CATCH(...)
+            {
+                destroy_elements(p);
+                JSONCONS_RETHROW;
+            }
+            return p;
+        }
+
+        void destroy_elements(array* p) const noexcept
+        {
+            array_allocator_type alloc(get_allocator());
+            std::allocator_traits<array_allocator_type>::destroy(alloc, p);
+            std::allocator_traits<array_allocator_type>::deallocate(alloc, std::pointer_traits<array_pointer>::pointer_to(*p), 1);
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
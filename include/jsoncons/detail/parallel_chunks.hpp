@@ -0,0 +1,215 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_PARALLEL_CHUNKS_HPP
+#define JSONCONS_DETAIL_PARALLEL_CHUNKS_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception> // std::exception_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons { namespace detail {
+
+    template <class Chunk>
+    struct chunk_slot
+    {
+        Chunk chunk;
+        std::exception_ptr exception;
+        bool ready;
+
+        chunk_slot()
+            : ready(false)
+        {
+        }
+    };
+
+    // Chunk k is held in slot k % slots.size()
+    template <class Chunk>
+    struct chunk_pipeline_state
+    {
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable chunk_ready;
+        std::vector<chunk_slot<Chunk>> slots;
+        std::exception_ptr worker_exception; // thrown by make_worker on a worker thread
+        std::size_t submitted;
+        std::size_t taken;
+        bool stop;
+
+        chunk_pipeline_state(std::size_t n)
+            : slots(n), submitted(0), taken(0), stop(false)
+        {
+        }
+    };
+
+    // Stops and joins the workers on every exit, including by exception
+    template <class Chunk>
+    class chunk_worker_pool
+    {
+        chunk_pipeline_state<Chunk>& state_;
+        std::vector<std::thread> threads_;
+    public:
+        chunk_worker_pool(chunk_pipeline_state<Chunk>& state)
+            : state_(state)
+        {
+        }
+
+        chunk_worker_pool(const chunk_worker_pool&) = delete;
+        chunk_worker_pool& operator=(const chunk_worker_pool&) = delete;
+
+        template <class F>
+        void start(std::size_t n, F f)
+        {
+            threads_.reserve(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                threads_.emplace_back(f);
+            }
+        }
+
+        ~chunk_worker_pool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(state_.mutex);
+                state_.stop = true;
+            }
+            state_.work_available.notify_all();
+            for (auto& t : threads_)
+            {
+                t.join();
+            }
+        }
+    };
+
+    // parse_chunks_in_order
+    // Parses consecutive chunks of input on num_threads worker threads, and consumes the results in
+    // input order on the calling thread.
+    //   make_worker()        called once on each worker thread, returns a pointer to an object with
+    //                        operator()(Chunk&), typically holding a parser and a decoder
+    //   next_chunk(Chunk&)   called on the calling thread, sets up the next chunk, or returns false
+    //                        if there are no more
+    //   consume(Chunk&)      called on the calling thread with each parsed chunk, in order, returns
+    //                        false to stop
+    // At most max_in_flight chunks are being parsed or waiting to be consumed at a time, and their
+    // storage is reused. An exception thrown by a worker is rethrown on the calling thread, when its
+    // chunk is reached, and an exception thrown by make_worker is rethrown on the calling thread when
+    // it next waits for a chunk. The workers are joined before returning.
+
+    template <class Chunk,class MakeWorker,class NextChunk,class Consume>
+    void parse_chunks_in_order(std::size_t num_threads, std::size_t max_in_flight,
+                               MakeWorker make_worker, NextChunk next_chunk, Consume consume)
+    {
+        using slot = chunk_slot<Chunk>;
+
+        chunk_pipeline_state<Chunk> state(max_in_flight != 0 ? max_in_flight : 1);
+        const std::size_t slot_count = state.slots.size();
+
+        chunk_worker_pool<Chunk> pool(state);
+        pool.start(num_threads != 0 ? num_threads : 1, [&state,&make_worker,slot_count]()
+        {
+            decltype(make_worker()) worker{};
+            JSONCONS_TRY
+            {
+                worker = make_worker();
+            }
+            JSONCONS_CATCH(...)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    if (!state.worker_exception)
+                    {
+                        state.worker_exception = std::current_exception();
+                    }
+                }
+                state.chunk_ready.notify_all();
+                return;
+            }
+            for (;;)
+            {
+                slot* s;
+                {
+                    std::unique_lock<std::mutex> lock(state.mutex);
+                    state.work_available.wait(lock, [&state]() {return state.stop || state.taken < state.submitted;});
+                    if (state.stop)
+                    {
+                        return;
+                    }
+                    s = &state.slots[state.taken++ % slot_count];
+                }
+                JSONCONS_TRY
+                {
+                    (*worker)(s->chunk);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    s->exception = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    s->ready = true;
+                }
+                state.chunk_ready.notify_all();
+            }
+        });
+
+        // Slots that have not been submitted belong to the calling thread, so they are set up without the lock
+        bool more = true;
+        std::size_t submitted = 0;
+        std::size_t consumed = 0;
+        for (;;)
+        {
+            std::size_t filled = submitted;
+            while (more && filled - consumed < slot_count)
+            {
+                slot& next = state.slots[filled % slot_count];
+                more = next_chunk(next.chunk);
+                if (more)
+                {
+                    next.exception = nullptr;
+                    next.ready = false;
+                    ++filled;
+                }
+            }
+
+            slot* s;
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                if (filled != submitted)
+                {
+                    state.submitted = submitted = filled;
+                    state.work_available.notify_all();
+                }
+                if (consumed == submitted)
+                {
+                    break;
+                }
+                s = &state.slots[consumed % slot_count];
+                state.chunk_ready.wait(lock, [s,&state]() {return s->ready || state.worker_exception;});
+                if (!s->ready)
+                {
+                    std::rethrow_exception(state.worker_exception);
+                }
+            }
+
+            if (s->exception)
+            {
+                std::rethrow_exception(s->exception);
+            }
+            if (!consume(s->chunk))
+            {
+                break;
+            }
+            ++consumed;
+        }
+    }
+
+}} // namespace detail namespace jsoncons
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef JSONCONS_DETAIL_PARSE_NUMBER_HPP
 #define JSONCONS_DETAIL_PARSE_NUMBER_HPP
 
+#include <algorithm> // std::find_if
 #include <system_error>
 #include <stdexcept>
 #include <string>
@@ -19,6 +20,9 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_exception.hpp>
 #include <cctype>
+#include <cstring> // std::memcpy
+#include <cfloat> // FLT_EVAL_METHOD
+#include <jsoncons/detail/eisel_lemire.hpp>
 
 namespace jsoncons { namespace detail {
 
@@ -101,6 +105,128 @@ struct to_integer_result
     }
 };
 
+// SWAR (SIMD within a register) conversion of eight ASCII digits at a time, 
+// see Daniel Lemire, "Quickly parsing eight digits" (2018)
+
+template <class CharT>
+uint64_t load_eight_chars(const CharT* s) noexcept
+{
+    uint64_t val;
+    std::memcpy(&val, s, sizeof(uint64_t));
+    if (jsoncons::endian::native == jsoncons::endian::big)
+    {
+        val = binary::byte_swap(val);
+    }
+    return val;
+}
+
+inline
+bool is_eight_digits(uint64_t val) noexcept
+{
+    return ((val & 0xF0F0F0F0F0F0F0F0) | (((val + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+inline
+uint32_t parse_eight_digits(uint64_t val) noexcept
+{
+    const uint64_t mask = 0x000000FF000000FF;
+    const uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+    val -= 0x3030303030303030;
+    val = (val * 10) + (val >> 8); 
+    val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(val);
+}
+
+// swar_accumulate_digits
+// Appends runs of eight digits to n while n*10^8 + 99999999 cannot overflow, 
+// and returns a pointer to the first character not consumed. The remaining digits, 
+// and any overflow, are left to the caller.
+
+template <class T, class CharT>
+typename std::enable_if<sizeof(CharT) == sizeof(char) && (extension_traits::integer_limits<T>::digits >= 31),const CharT*>::type
+swar_accumulate_digits(const CharT* s, const CharT* end, T& n)
+{
+    static constexpr T max_value = (extension_traits::integer_limits<T>::max)();
+    static constexpr T max_prefix = (max_value - T(99999999)) / T(100000000);
+    while (end - s >= 8 && n <= max_prefix)
+    {
+        uint64_t chunk = load_eight_chars(s);
+        if (!is_eight_digits(chunk))
+        {
+            break;
+        }
+        n = n * T(100000000) + static_cast<T>(parse_eight_digits(chunk));
+        s += 8;
+    }
+    return s;
+}
+
+template <class T, class CharT>
+typename std::enable_if<!(sizeof(CharT) == sizeof(char) && (extension_traits::integer_limits<T>::digits >= 31)),const CharT*>::type
+swar_accumulate_digits(const CharT* s, const CharT*, T&)
+{
+    return s;
+}
+
+// swar_accumulate_negative_digits
+// As swar_accumulate_digits, but subtracts the digits from a non-positive n
+
+template <class T, class CharT>
+typename std::enable_if<sizeof(CharT) == sizeof(char) && (extension_traits::integer_limits<T>::digits >= 31),const CharT*>::type
+swar_accumulate_negative_digits(const CharT* s, const CharT* end, T& n)
+{
+    static constexpr T min_value = (extension_traits::integer_limits<T>::lowest)();
+    static constexpr T min_prefix = (min_value + T(99999999)) / T(100000000);
+    while (end - s >= 8 && n >= min_prefix)
+    {
+        uint64_t chunk = load_eight_chars(s);
+        if (!is_eight_digits(chunk))
+        {
+            break;
+        }
+        n = n * T(100000000) - static_cast<T>(parse_eight_digits(chunk));
+        s += 8;
+    }
+    return s;
+}
+
+template <class T, class CharT>
+typename std::enable_if<!(sizeof(CharT) == sizeof(char) && (extension_traits::integer_limits<T>::digits >= 31)),const CharT*>::type
+swar_accumulate_negative_digits(const CharT* s, const CharT*, T&)
+{
+    return s;
+}
+
+// skip_digits
+// Returns a pointer to the first character in [first,last) that is not a decimal digit
+
+template <class CharT>
+typename std::enable_if<sizeof(CharT) == sizeof(char),const CharT*>::type
+skip_digits(const CharT* first, const CharT* last) noexcept
+{
+    while (last - first >= 8 && is_eight_digits(load_eight_chars(first)))
+    {
+        first += 8;
+    }
+    while (first != last && (*first >= '0' && *first <= '9'))
+    {
+        ++first;
+    }
+    return first;
+}
+
+template <class CharT>
+typename std::enable_if<sizeof(CharT) != sizeof(char),const CharT*>::type
+skip_digits(const CharT* first, const CharT* last) noexcept
+{
+    while (first != last && (*first >= '0' && *first <= '9'))
+    {
+        ++first;
+    }
+    return first;
+}
+
 enum class integer_chars_format : uint8_t {decimal=1,hex};
 enum class integer_chars_state {initial,minus,integer,binary,octal,decimal,base16};
 
@@ -197,6 +323,7 @@ to_integer_decimal(const CharT* s, std::size_t length, T& n)
             {
                 static constexpr T max_value = (extension_traits::integer_limits<T>::max)();
                 static constexpr T max_value_div_10 = max_value / 10;
+                s = swar_accumulate_digits(s, end, n);
                 for (; s < end; ++s)
                 {
                     T x = 0;
@@ -527,6 +654,7 @@ to_integer(const CharT* s, std::size_t length, T& n)
             {
                 static constexpr T max_value = (extension_traits::integer_limits<T>::max)();
                 static constexpr T max_value_div_10 = max_value / 10;
+                s = swar_accumulate_digits(s, end, n);
                 for (; s < end; ++s)
                 {
                     T x = 0;
@@ -695,6 +823,7 @@ to_integer_unchecked(const CharT* s, std::size_t length, T& n)
     {
         static constexpr T max_value = (extension_traits::integer_limits<T>::max)();
         static constexpr T max_value_div_10 = max_value / 10;
+        s = swar_accumulate_digits(s, end, n);
         for (; s < end; ++s)
         {
             T x = static_cast<T>(*s) - static_cast<T>('0');
@@ -737,6 +866,7 @@ to_integer_unchecked(const CharT* s, std::size_t length, T& n)
         static constexpr T min_value = (extension_traits::integer_limits<T>::lowest)();
         static constexpr T min_value_div_10 = min_value / 10;
         ++s;
+        s = swar_accumulate_negative_digits(s, end, n);
         for (; s < end; ++s)
         {
             T x = (T)*s - (T)('0');
@@ -757,6 +887,7 @@ to_integer_unchecked(const CharT* s, std::size_t length, T& n)
     {
         static constexpr T max_value = (extension_traits::integer_limits<T>::max)();
         static constexpr T max_value_div_10 = max_value / 10;
+        s = swar_accumulate_digits(s, end, n);
         for (; s < end; ++s)
         {
             T x = static_cast<T>(*s) - static_cast<T>('0');
@@ -910,6 +1041,149 @@ base16_to_integer(const CharT* s, std::size_t length, T& n)
 }
 
 
+// decimal_to_double
+// Converts a decimal number of the form -?[0-9]+(\.[0-9]+)?([eE][+-]?[0-9]+)? to the nearest double,
+// using the decimal point character of the chars_to conversion. Returns false if the text is not 
+// of this form, or if the correctly rounded result cannot be determined cheaply, in which case 
+// the caller should use chars_to.
+
+template <class CharT>
+bool decimal_to_double(const CharT* s, std::size_t length, char decimal_point, double& val)
+{
+    static constexpr double powers_of_ten[] = {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+                                               1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+    const int max_significant_digits = 19;
+
+    const CharT* cur = s;
+    const CharT* end = s + length;
+
+    bool negative = false;
+    if (cur != end && *cur == '-')
+    {
+        negative = true;
+        ++cur;
+    }
+    if (cur == end || !(*cur >= '0' && *cur <= '9'))
+    {
+        return false;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int64_t exponent10 = 0;
+    bool truncated = false;
+
+    for (; cur != end && (*cur >= '0' && *cur <= '9'); ++cur)
+    {
+        unsigned d = static_cast<unsigned>(*cur - '0');
+        if (digits < max_significant_digits)
+        {
+            mantissa = mantissa*10 + d;
+            if (mantissa != 0)
+            {
+                ++digits;
+            }
+        }
+        else
+        {
+            ++exponent10;
+            truncated = truncated || d != 0;
+        }
+    }
+    if (cur != end && *cur == static_cast<CharT>(decimal_point))
+    {
+        ++cur;
+        if (cur == end || !(*cur >= '0' && *cur <= '9'))
+        {
+            return false;
+        }
+        for (; cur != end && (*cur >= '0' && *cur <= '9'); ++cur)
+        {
+            unsigned d = static_cast<unsigned>(*cur - '0');
+            if (digits < max_significant_digits)
+            {
+                mantissa = mantissa*10 + d;
+                if (mantissa != 0)
+                {
+                    ++digits;
+                }
+                --exponent10;
+            }
+            else
+            {
+                truncated = truncated || d != 0;
+            }
+        }
+    }
+    if (cur != end && (*cur == 'e' || *cur == 'E'))
+    {
+        ++cur;
+        bool negative_exponent = false;
+        if (cur != end && (*cur == '+' || *cur == '-'))
+        {
+            negative_exponent = *cur == '-';
+            ++cur;
+        }
+        if (cur == end || !(*cur >= '0' && *cur <= '9'))
+        {
+            return false;
+        }
+        int64_t e = 0;
+        for (; cur != end && (*cur >= '0' && *cur <= '9'); ++cur)
+        {
+            if (e < 100000)
+            {
+                e = e*10 + (*cur - '0');
+            }
+        }
+        exponent10 += negative_exponent ? -e : e;
+    }
+    if (cur != end)
+    {
+        return false;
+    }
+
+    if (mantissa == 0)
+    {
+        val = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (exponent10 < eisel_lemire_min_exponent10 || exponent10 > eisel_lemire_max_exponent10)
+    {
+        return false;
+    }
+
+    // Clinger's fast path: the mantissa and the power of ten are both exact doubles, 
+    // so a single correctly rounded multiplication or division gives the result 
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent10 >= -22 && exponent10 <= 22)
+    {
+        double d = static_cast<double>(mantissa);
+        d = exponent10 < 0 ? d / powers_of_ten[-exponent10] : d * powers_of_ten[exponent10];
+        val = negative ? -d : d;
+        return true;
+    }
+#else
+    (void)powers_of_ten;
+#endif
+
+    if (!eisel_lemire(mantissa, static_cast<int>(exponent10), negative, val))
+    {
+        return false;
+    }
+    // If digits were dropped, the exact value lies between mantissa and mantissa+1, 
+    // and the result holds only if both round to the same double
+    if (truncated)
+    {
+        double upper;
+        if (!eisel_lemire(mantissa+1, static_cast<int>(exponent10), negative, upper) || upper != val)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 #if defined(JSONCONS_HAS_STD_FROM_CHARS) && JSONCONS_HAS_STD_FROM_CHARS
 
 class chars_to
@@ -1128,6 +1402,51 @@ public:
 };
 #endif
 
+// is_bigint_text
+// True if s is the text of a JSON integer that fits in neither an int64_t nor a uint64_t
+
+template <class CharT>
+bool is_bigint_text(const CharT* s, std::size_t length)
+{
+    if (length < 19 || std::find_if(s, s+length, [](CharT c){return c == '.' || c == 'e' || c == 'E';}) != s+length)
+    {
+        return false;
+    }
+    if (s[0] == '-')
+    {
+        int64_t val;
+        return !to_integer_unchecked(s, length, val);
+    }
+    uint64_t val;
+    return !to_integer_unchecked(s, length, val);
+}
+
+// number_text_to_double
+// Converts the text of a JSON number, which always has '.' as its decimal point, to a double.
+
+template <class CharT>
+double number_text_to_double(const CharT* s, std::size_t length)
+{
+    double val = 0;
+    if (decimal_to_double(s, length, '.', val))
+    {
+        return val;
+    }
+    chars_to to_double;
+    std::basic_string<CharT> buffer(s, length);
+    if (to_double.get_decimal_point() != '.')
+    {
+        for (auto& c : buffer)
+        {
+            if (c == '.')
+            {
+                c = static_cast<CharT>(to_double.get_decimal_point());
+            }
+        }
+    }
+    return to_double(buffer.c_str(), buffer.length());
+}
+
 }}
 
 #endif
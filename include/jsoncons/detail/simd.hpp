@@ -0,0 +1,240 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_HPP
+#define JSONCONS_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/compiler_support.hpp>
+
+// Define JSONCONS_NO_SIMD to force the scalar code paths
+
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__AVX2__)
+#    define JSONCONS_HAS_AVX2 1
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2 1
+#  endif
+#  if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+#    define JSONCONS_HAS_NEON 1
+#  endif
+#endif
+
+#if defined(JSONCONS_HAS_AVX2)
+#  include <immintrin.h>
+#elif defined(JSONCONS_HAS_SSE2)
+#  include <emmintrin.h>
+#elif defined(JSONCONS_HAS_NEON)
+#  include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    // Index of the lowest set bit, x must be non-zero
+
+    inline
+    int trailing_zeros(uint32_t x) noexcept
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(x);
+    #elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((x & 1) == 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    inline
+    int trailing_zeros(uint64_t x) noexcept
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+    #else
+        uint32_t lo = static_cast<uint32_t>(x);
+        return lo != 0 ? trailing_zeros(lo) : 32 + trailing_zeros(static_cast<uint32_t>(x >> 32));
+    #endif
+    }
+
+#if defined(JSONCONS_HAS_NEON)
+    // One nibble per byte, for each lane of a comparison result
+    inline
+    uint64_t neon_nibble_mask(uint8x16_t eq) noexcept
+    {
+        uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    }
+#endif
+
+    // skip_blanks
+    // Returns a pointer to the first character in [first,last) that is not a space or a horizontal tab
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != sizeof(char),const CharT*>::type
+    skip_blanks(const CharT* first, const CharT* last) noexcept
+    {
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == sizeof(char),const CharT*>::type
+    skip_blanks(const CharT* first, const CharT* last) noexcept
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        const __m256i spaces = _mm256_set1_epi8(' ');
+        const __m256i tabs = _mm256_set1_epi8('\t');
+        while (last - first >= 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i blanks = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, spaces), _mm256_cmpeq_epi8(chunk, tabs));
+            uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(blanks));
+            if (mask != 0)
+            {
+                return first + trailing_zeros(mask);
+            }
+            first += 32;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i spaces16 = _mm_set1_epi8(' ');
+        const __m128i tabs16 = _mm_set1_epi8('\t');
+        while (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i blanks = _mm_or_si128(_mm_cmpeq_epi8(chunk, spaces16), _mm_cmpeq_epi8(chunk, tabs16));
+            uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(blanks)) & 0xFFFF;
+            if (mask != 0)
+            {
+                return first + trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        const uint8x16_t spaces16 = vdupq_n_u8(' ');
+        const uint8x16_t tabs16 = vdupq_n_u8('\t');
+        while (last - first >= 16)
+        {
+            uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+            uint8x16_t blanks = vorrq_u8(vceqq_u8(chunk, spaces16), vceqq_u8(chunk, tabs16));
+            uint64_t mask = ~neon_nibble_mask(blanks);
+            if (mask != 0)
+            {
+                return first + (trailing_zeros(mask) >> 2);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    // find_string_special
+    // Returns a pointer to the first quotation mark, reverse solidus or control character (U+0000 through U+001F) 
+    // in [first,last), or last if there is none
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) != sizeof(char),const CharT*>::type
+    find_string_special(const CharT* first, const CharT* last) noexcept
+    {
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+        while (first != last && *first != '\"' && *first != '\\' && static_cast<unsigned_type>(*first) >= 0x20)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class CharT>
+    typename std::enable_if<sizeof(CharT) == sizeof(char),const CharT*>::type
+    find_string_special(const CharT* first, const CharT* last) noexcept
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        const __m256i quotes = _mm256_set1_epi8('\"');
+        const __m256i backslashes = _mm256_set1_epi8('\\');
+        const __m256i max_control = _mm256_set1_epi8(0x1f);
+        while (last - first >= 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quotes), _mm256_cmpeq_epi8(chunk, backslashes)),
+                                              _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, max_control), chunk));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + trailing_zeros(mask);
+            }
+            first += 32;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i quotes16 = _mm_set1_epi8('\"');
+        const __m128i backslashes16 = _mm_set1_epi8('\\');
+        const __m128i max_control16 = _mm_set1_epi8(0x1f);
+        while (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quotes16), _mm_cmpeq_epi8(chunk, backslashes16)),
+                                           _mm_cmpeq_epi8(_mm_min_epu8(chunk, max_control16), chunk));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        const uint8x16_t quotes16 = vdupq_n_u8('\"');
+        const uint8x16_t backslashes16 = vdupq_n_u8('\\');
+        const uint8x16_t min_printable16 = vdupq_n_u8(0x20);
+        while (last - first >= 16)
+        {
+            uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+            uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(chunk, quotes16), vceqq_u8(chunk, backslashes16)),
+                                          vcltq_u8(chunk, min_printable16));
+            uint64_t mask = neon_nibble_mask(special);
+            if (mask != 0)
+            {
+                return first + (trailing_zeros(mask) >> 2);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last && *first != '\"' && *first != '\\' && static_cast<uint8_t>(*first) >= 0x20)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
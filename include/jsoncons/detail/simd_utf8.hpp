@@ -0,0 +1,419 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+/*
+ * The vectorized validator follows the "lookup" algorithm of
+ * J. Keiser and D. Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte",
+ * Software: Practice and Experience 51 (5), 2021
+ */
+
+#ifndef JSONCONS_DETAIL_SIMD_UTF8_HPP
+#define JSONCONS_DETAIL_SIMD_UTF8_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/simd.hpp>
+
+#if !defined(JSONCONS_NO_SIMD)
+#  if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define JSONCONS_HAS_UTF8_X86_DISPATCH 1
+#    include <immintrin.h>
+#  elif defined(_MSC_VER) && defined(_M_X64)
+#    define JSONCONS_HAS_UTF8_X86_DISPATCH 1
+#    include <immintrin.h>
+#  endif
+#endif
+
+#if defined(JSONCONS_HAS_UTF8_X86_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+#  define JSONCONS_TARGET_SSSE3 __attribute__((target("ssse3")))
+#  define JSONCONS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define JSONCONS_TARGET_SSSE3
+#  define JSONCONS_TARGET_AVX2
+#endif
+
+namespace jsoncons {
+namespace detail {
+namespace utf8 {
+
+    // Error classes for the lookup tables, one bit each
+
+    constexpr uint8_t too_short = 1 << 0;     // 11______ followed by 0_______ or 11______
+    constexpr uint8_t too_long = 1 << 1;      // 0_______ followed by 10______
+    constexpr uint8_t overlong_3 = 1 << 2;    // 11100000 100_____
+    constexpr uint8_t too_large = 1 << 3;     // 11110100 1001____, 11110100 101_____, 11110101+
+    constexpr uint8_t surrogate = 1 << 4;     // 11101101 101_____
+    constexpr uint8_t overlong_2 = 1 << 5;    // 1100000_ 10______
+    constexpr uint8_t too_large_1000 = 1 << 6;// 11110101+ 1000____
+    constexpr uint8_t overlong_4 = 1 << 6;    // 11110000 1000____
+    constexpr uint8_t two_conts = 1 << 7;     // 10______ 10______
+    constexpr uint8_t carry = too_short | too_long | two_conts;
+
+    // Indexed by the high nibble of the previous byte
+    constexpr uint8_t byte_1_high[16] = {
+        too_long, too_long, too_long, too_long,
+        too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4
+    };
+
+    // Indexed by the low nibble of the previous byte
+    constexpr uint8_t byte_1_low[16] = {
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry,
+        carry,
+        carry | too_large,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000
+    };
+
+    // Indexed by the high nibble of the current byte
+    constexpr uint8_t byte_2_high[16] = {
+        too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short
+    };
+
+    // A block ending in one of these bytes must be continued in the next block
+    constexpr uint8_t incomplete_max[32] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+    };
+
+    inline
+    bool is_ascii_word(const uint8_t* p) noexcept
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        return (word & 0x8080808080808080ull) == 0;
+    }
+
+    // Scalar validation used when no vector unit is available
+
+    inline
+    bool is_valid_scalar(const uint8_t* data, std::size_t length) noexcept
+    {
+        const uint8_t* last = data + length;
+        while (data != last)
+        {
+            if (last - data >= 8 && is_ascii_word(data))
+            {
+                data += 8;
+                continue;
+            }
+            if (*data < 0x80)
+            {
+                ++data;
+                continue;
+            }
+            auto r = unicode_traits::validate(data, static_cast<std::size_t>(last - data));
+            return r.ec == unicode_traits::conv_errc();
+        }
+        return true;
+    }
+
+#if defined(JSONCONS_HAS_UTF8_X86_DISPATCH)
+
+    JSONCONS_TARGET_SSSE3
+    inline
+    __m128i check_block_ssse3(__m128i input, __m128i prev_input) noexcept
+    {
+        const __m128i low_nibble_mask = _mm_set1_epi8(0x0f);
+        const __m128i table1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_1_high));
+        const __m128i table2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_1_low));
+        const __m128i table3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_2_high));
+
+        __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+        __m128i b1h = _mm_shuffle_epi8(table1, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble_mask));
+        __m128i b1l = _mm_shuffle_epi8(table2, _mm_and_si128(prev1, low_nibble_mask));
+        __m128i b2h = _mm_shuffle_epi8(table3, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble_mask));
+        __m128i special_cases = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+
+        __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+        __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+        __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+        __m128i must23_80 = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+        return _mm_xor_si128(must23_80, special_cases);
+    }
+
+    JSONCONS_TARGET_SSSE3
+    inline
+    bool is_valid_ssse3(const uint8_t* data, std::size_t length) noexcept
+    {
+        const __m128i max_value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(incomplete_max + 16));
+        __m128i error = _mm_setzero_si128();
+        __m128i prev_input = _mm_setzero_si128();
+        __m128i prev_incomplete = _mm_setzero_si128();
+
+        std::size_t i = 0;
+        for (; i + 16 <= length; i += 16)
+        {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(input) == 0)
+            {
+                error = _mm_or_si128(error, prev_incomplete);
+            }
+            else
+            {
+                error = _mm_or_si128(error, check_block_ssse3(input, prev_input));
+                prev_incomplete = _mm_subs_epu8(input, max_value);
+            }
+            prev_input = input;
+        }
+        if (i < length)
+        {
+            uint8_t buffer[16] = {0};
+            std::memcpy(buffer, data + i, length - i);
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+            error = _mm_or_si128(error, check_block_ssse3(input, prev_input));
+            prev_incomplete = _mm_subs_epu8(input, max_value);
+        }
+        error = _mm_or_si128(error, prev_incomplete);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xffff;
+    }
+
+    JSONCONS_TARGET_AVX2
+    inline
+    __m256i check_block_avx2(__m256i input, __m256i prev_input) noexcept
+    {
+        const __m256i low_nibble_mask = _mm256_set1_epi8(0x0f);
+        const __m256i table1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_1_high)));
+        const __m256i table2 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_1_low)));
+        const __m256i table3 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_2_high)));
+
+        __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+        __m256i b1h = _mm256_shuffle_epi8(table1, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble_mask));
+        __m256i b1l = _mm256_shuffle_epi8(table2, _mm256_and_si256(prev1, low_nibble_mask));
+        __m256i b2h = _mm256_shuffle_epi8(table3, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble_mask));
+        __m256i special_cases = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+        __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+        __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+        __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+        __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+        __m256i must23_80 = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+        return _mm256_xor_si256(must23_80, special_cases);
+    }
+
+    JSONCONS_TARGET_AVX2
+    inline
+    bool is_valid_avx2(const uint8_t* data, std::size_t length) noexcept
+    {
+        const __m256i max_value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(incomplete_max));
+        __m256i error = _mm256_setzero_si256();
+        __m256i prev_input = _mm256_setzero_si256();
+        __m256i prev_incomplete = _mm256_setzero_si256();
+
+        std::size_t i = 0;
+        for (; i + 32 <= length; i += 32)
+        {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            if (_mm256_movemask_epi8(input) == 0)
+            {
+                error = _mm256_or_si256(error, prev_incomplete);
+            }
+            else
+            {
+                error = _mm256_or_si256(error, check_block_avx2(input, prev_input));
+                prev_incomplete = _mm256_subs_epu8(input, max_value);
+            }
+            prev_input = input;
+        }
+        if (i < length)
+        {
+            uint8_t buffer[32] = {0};
+            std::memcpy(buffer, data + i, length - i);
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer));
+            error = _mm256_or_si256(error, check_block_avx2(input, prev_input));
+            prev_incomplete = _mm256_subs_epu8(input, max_value);
+        }
+        error = _mm256_or_si256(error, prev_incomplete);
+        return _mm256_testz_si256(error, error) != 0;
+    }
+
+    enum class cpu_level {scalar, ssse3, avx2};
+
+    inline
+    cpu_level detect_cpu_level() noexcept
+    {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        int max_leaf = info[0];
+        if (max_leaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            bool has_avx2 = (info[1] & (1 << 5)) != 0;
+            __cpuid(info, 1);
+            bool has_osxsave = (info[2] & (1 << 27)) != 0;
+            if (has_avx2 && has_osxsave && (_xgetbv(0) & 0x6) == 0x6)
+            {
+                return cpu_level::avx2;
+            }
+        }
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0 ? cpu_level::ssse3 : cpu_level::scalar;
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return cpu_level::avx2;
+        }
+        if (__builtin_cpu_supports("ssse3"))
+        {
+            return cpu_level::ssse3;
+        }
+        return cpu_level::scalar;
+    #endif
+    }
+
+    inline
+    cpu_level get_cpu_level() noexcept
+    {
+        static const cpu_level level = detect_cpu_level();
+        return level;
+    }
+
+#elif defined(JSONCONS_HAS_NEON)
+
+    inline
+    uint8x16_t check_block_neon(uint8x16_t input, uint8x16_t prev_input) noexcept
+    {
+        const uint8x16_t table1 = vld1q_u8(byte_1_high);
+        const uint8x16_t table2 = vld1q_u8(byte_1_low);
+        const uint8x16_t table3 = vld1q_u8(byte_2_high);
+
+        uint8x16_t prev1 = vextq_u8(prev_input, input, 15);
+        uint8x16_t b1h = vqtbl1q_u8(table1, vshrq_n_u8(prev1, 4));
+        uint8x16_t b1l = vqtbl1q_u8(table2, vandq_u8(prev1, vdupq_n_u8(0x0f)));
+        uint8x16_t b2h = vqtbl1q_u8(table3, vshrq_n_u8(input, 4));
+        uint8x16_t special_cases = vandq_u8(vandq_u8(b1h, b1l), b2h);
+
+        uint8x16_t prev2 = vextq_u8(prev_input, input, 14);
+        uint8x16_t prev3 = vextq_u8(prev_input, input, 13);
+        uint8x16_t is_third_byte = vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80));
+        uint8x16_t is_fourth_byte = vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80));
+        uint8x16_t must23_80 = vandq_u8(vorrq_u8(is_third_byte, is_fourth_byte), vdupq_n_u8(0x80));
+        return veorq_u8(must23_80, special_cases);
+    }
+
+    inline
+    bool is_valid_neon(const uint8_t* data, std::size_t length) noexcept
+    {
+        const uint8x16_t max_value = vld1q_u8(incomplete_max + 16);
+        uint8x16_t error = vdupq_n_u8(0);
+        uint8x16_t prev_input = vdupq_n_u8(0);
+        uint8x16_t prev_incomplete = vdupq_n_u8(0);
+
+        std::size_t i = 0;
+        for (; i + 16 <= length; i += 16)
+        {
+            uint8x16_t input = vld1q_u8(data + i);
+            if (vmaxvq_u8(input) < 0x80)
+            {
+                error = vorrq_u8(error, prev_incomplete);
+            }
+            else
+            {
+                error = vorrq_u8(error, check_block_neon(input, prev_input));
+                prev_incomplete = vqsubq_u8(input, max_value);
+            }
+            prev_input = input;
+        }
+        if (i < length)
+        {
+            uint8_t buffer[16] = {0};
+            std::memcpy(buffer, data + i, length - i);
+            uint8x16_t input = vld1q_u8(buffer);
+            error = vorrq_u8(error, check_block_neon(input, prev_input));
+            prev_incomplete = vqsubq_u8(input, max_value);
+        }
+        error = vorrq_u8(error, prev_incomplete);
+        return vmaxvq_u8(error) == 0;
+    }
+
+#endif
+
+    // is_valid
+    // Selects the widest instruction set supported by the CPU at run time
+
+    inline
+    bool is_valid(const uint8_t* data, std::size_t length) noexcept
+    {
+        if (length < 16)
+        {
+            return is_valid_scalar(data, length);
+        }
+    #if defined(JSONCONS_HAS_UTF8_X86_DISPATCH)
+        switch (get_cpu_level())
+        {
+            case cpu_level::avx2:
+                return is_valid_avx2(data, length);
+            case cpu_level::ssse3:
+                return is_valid_ssse3(data, length);
+            default:
+                return is_valid_scalar(data, length);
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        return is_valid_neon(data, length);
+    #else
+        return is_valid_scalar(data, length);
+    #endif
+    }
+
+} // namespace utf8
+
+    // fast_validate
+    // Validates the whole buffer with the vectorized validator, and only falls back to
+    // unicode_traits::validate to locate the offending sequence when it is invalid
+
+    template <class CharT>
+    typename std::enable_if<extension_traits::is_char8<CharT>::value,
+                            unicode_traits::convert_result<CharT>>::type
+    fast_validate(const CharT* data, std::size_t length) noexcept
+    {
+        if (utf8::is_valid(reinterpret_cast<const uint8_t*>(data), length))
+        {
+            return unicode_traits::convert_result<CharT>{data + length, unicode_traits::conv_errc()};
+        }
+        return unicode_traits::validate(data, length);
+    }
+
+    template <class CharT>
+    typename std::enable_if<!extension_traits::is_char8<CharT>::value,
+                            unicode_traits::convert_result<CharT>>::type
+    fast_validate(const CharT* data, std::size_t length) noexcept
+    {
+        return unicode_traits::validate(data, length);
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,551 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SMALL_VECTOR_HPP
+#define JSONCONS_DETAIL_SMALL_VECTOR_HPP
+
+#include <algorithm> // std::rotate, std::equal, std::lexicographical_compare
+#include <cassert> // assert
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator_traits, std::pointer_traits
+#include <new> // std::bad_alloc
+#include <stdexcept> // std::length_error
+#include <type_traits>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/extension_traits.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // small_vector
+    // A sequence container with the interface of std::vector used by json_array, that keeps up to
+    // N elements in a buffer inside the container object itself and moves them to the heap when it grows
+    // past N. Since json_array is itself heap allocated, an array of up to N elements takes one allocation
+    // instead of two. Iterators are pointers, and moving a container with inline elements moves the elements.
+
+    template <class T, class Allocator, std::size_t N>
+    class small_vector
+    {
+        static_assert(N > 0, "Inline capacity must be positive");
+    public:
+        using value_type = T;
+        using allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    private:
+        using allocator_traits_type = std::allocator_traits<allocator_type>;
+        using alloc_pointer = typename allocator_traits_type::pointer;
+
+        allocator_type alloc_;
+        T* data_;
+        size_type size_;
+        size_type capacity_;
+        alignas(T) unsigned char buffer_[sizeof(T)*N];
+    public:
+        small_vector()
+            : alloc_(), data_(inline_data()), size_(0), capacity_(N)
+        {
+        }
+
+        explicit small_vector(const allocator_type& alloc)
+            : alloc_(alloc), data_(inline_data()), size_(0), capacity_(N)
+        {
+        }
+
+        small_vector(size_type n, const T& value, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), data_(inline_data()), size_(0), capacity_(N)
+        {
+            resize(n, value);
+        }
+
+        template <class InputIt>
+        small_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), data_(inline_data()), size_(0), capacity_(N)
+        {
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+        }
+
+        small_vector(const std::initializer_list<T>& init, const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), data_(inline_data()), size_(0), capacity_(N)
+        {
+            append(init.begin(), init.end(), std::random_access_iterator_tag());
+        }
+
+        small_vector(const small_vector& other)
+            : alloc_(allocator_traits_type::select_on_container_copy_construction(other.alloc_)),
+              data_(inline_data()), size_(0), capacity_(N)
+        {
+            append(other.begin(), other.end(), std::random_access_iterator_tag());
+        }
+
+        small_vector(const small_vector& other, const allocator_type& alloc)
+            : alloc_(alloc), data_(inline_data()), size_(0), capacity_(N)
+        {
+            append(other.begin(), other.end(), std::random_access_iterator_tag());
+        }
+
+        small_vector(small_vector&& other) noexcept
+            : alloc_(other.alloc_), data_(inline_data()), size_(0), capacity_(N)
+        {
+            take(other);
+        }
+
+        small_vector(small_vector&& other, const allocator_type& alloc)
+            : alloc_(alloc), data_(inline_data()), size_(0), capacity_(N)
+        {
+            if (alloc_ == other.alloc_)
+            {
+                take(other);
+            }
+            else
+            {
+                append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                       std::random_access_iterator_tag());
+                other.clear();
+            }
+        }
+
+        ~small_vector() noexcept
+        {
+            clear();
+            release();
+        }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (allocator_traits_type::propagate_on_container_copy_assignment::value && alloc_ != other.alloc_)
+                {
+                    release();
+                }
+                propagate_allocator(typename allocator_traits_type::propagate_on_container_copy_assignment(), other.alloc_);
+                append(other.begin(), other.end(), std::random_access_iterator_tag());
+            }
+            return *this;
+        }
+
+        // Moves the elements one by one, which may allocate, only when the allocators are unequal and not propagated
+        small_vector& operator=(small_vector&& other) noexcept(allocator_traits_type::propagate_on_container_move_assignment::value ||
+                                                               extension_traits::is_stateless<allocator_type>::value)
+        {
+            if (this != &other)
+            {
+                clear();
+                release();
+                propagate_allocator(typename allocator_traits_type::propagate_on_container_move_assignment(), other.alloc_);
+                if (alloc_ == other.alloc_)
+                {
+                    take(other);
+                }
+                else
+                {
+                    append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                           std::random_access_iterator_tag());
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::min)(size_type(allocator_traits_type::max_size(alloc_)),
+                              size_type((std::numeric_limits<difference_type>::max)()));
+        }
+
+        // True if the elements are in the buffer inside the container
+        bool is_inline() const noexcept
+        {
+            return data_ == inline_data();
+        }
+
+        // Bytes allocated for a heap buffer, zero while the elements are in the buffer inside the container
+        std::size_t allocated_bytes() const noexcept
+        {
+            return is_inline() ? 0 : capacity_*sizeof(T);
+        }
+
+        T* data() noexcept {return data_;}
+        const T* data() const noexcept {return data_;}
+
+        iterator begin() noexcept {return data_;}
+        iterator end() noexcept {return data_ + size_;}
+        const_iterator begin() const noexcept {return data_;}
+        const_iterator end() const noexcept {return data_ + size_;}
+        const_iterator cbegin() const noexcept {return data_;}
+        const_iterator cend() const noexcept {return data_ + size_;}
+        reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+        reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        T& operator[](size_type i) {return data_[i];}
+        const T& operator[](size_type i) const {return data_[i];}
+
+        T& front() {return data_[0];}
+        const T& front() const {return data_[0];}
+        T& back() {return data_[size_-1];}
+        const T& back() const {return data_[size_-1];}
+
+        void reserve(size_type n)
+        {
+            if (n > capacity_)
+            {
+                reallocate(n);
+            }
+        }
+
+        // Moves the elements back inside the container if they fit, otherwise
+        // into a heap buffer of exactly size() elements
+        void shrink_to_fit()
+        {
+            if (!is_inline() && size_ < capacity_)
+            {
+                reallocate(size_);
+            }
+        }
+
+        void clear() noexcept
+        {
+            destroy_range(data_, data_ + size_);
+            size_ = 0;
+        }
+
+        template <class... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (size_ == capacity_)
+            {
+                // Construct the new element before moving the old ones, args may refer to one of them
+                size_type new_capacity = next_capacity(size_ + 1);
+                T* new_data = allocate(new_capacity);
+                JSONCONS_TRY
+                {
+                    allocator_traits_type::construct(alloc_, new_data + size_, std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    deallocate(new_data, new_capacity);
+                    JSONCONS_RETHROW;
+                }
+                move_to(new_data, new_capacity);
+            }
+            else
+            {
+                allocator_traits_type::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+            }
+            ++size_;
+            return back();
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back()
+        {
+            --size_;
+            allocator_traits_type::destroy(alloc_, data_ + size_);
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            size_type index = static_cast<size_type>(pos - begin());
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + index, end() - 1, end());
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            size_type index = static_cast<size_type>(pos - begin());
+            size_type old_size = size_;
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator it1 = begin() + (first - begin());
+            iterator it2 = begin() + (last - begin());
+            if (it1 != it2)
+            {
+                iterator new_end = std::move(it2, end(), it1);
+                destroy_range(new_end, end());
+                size_ -= static_cast<size_type>(it2 - it1);
+            }
+            return it1;
+        }
+
+        void resize(size_type n)
+        {
+            if (n < size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (size_ < n)
+                {
+                    emplace_back();
+                }
+            }
+        }
+
+        void resize(size_type n, const T& value)
+        {
+            if (n < size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (size_ < n)
+                {
+                    emplace_back(value);
+                }
+            }
+        }
+
+        // Swaps the allocators if propagate_on_container_swap is true, otherwise they must be equal, as for std::vector.
+        // Heap buffers are exchanged and inline elements moved, without allocating.
+        void swap(small_vector& other) noexcept
+        {
+            if (this == &other)
+            {
+                return;
+            }
+            assert(allocator_traits_type::propagate_on_container_swap::value || alloc_ == other.alloc_);
+
+            small_vector temp(std::move(other));
+            other.propagate_allocator(typename allocator_traits_type::propagate_on_container_swap(), alloc_);
+            other.take(*this);
+            propagate_allocator(typename allocator_traits_type::propagate_on_container_swap(), temp.alloc_);
+            take(temp);
+        }
+
+        friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+        {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const small_vector& lhs, const small_vector& rhs)
+        {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+        T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(buffer_);
+        }
+
+        const T* inline_data() const noexcept
+        {
+            return reinterpret_cast<const T*>(buffer_);
+        }
+
+        void propagate_allocator(std::true_type, const allocator_type& alloc) noexcept
+        {
+            alloc_ = alloc;
+        }
+
+        void propagate_allocator(std::false_type, const allocator_type&) noexcept
+        {
+        }
+
+        size_type next_capacity(size_type min_capacity) const
+        {
+            if (min_capacity > max_size())
+            {
+                JSONCONS_THROW(std::length_error("small_vector too long"));
+            }
+            size_type new_capacity = capacity_ <= max_size()/2 ? capacity_*2 : max_size();
+            return (std::max)(new_capacity, min_capacity);
+        }
+
+        T* allocate(size_type n)
+        {
+            return extension_traits::to_plain_pointer(allocator_traits_type::allocate(alloc_, n));
+        }
+
+        void deallocate(T* p, size_type n)
+        {
+            allocator_traits_type::deallocate(alloc_, std::pointer_traits<alloc_pointer>::pointer_to(*p), n);
+        }
+
+        void destroy_range(T* first, T* last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                allocator_traits_type::destroy(alloc_, first);
+            }
+        }
+
+        // Frees a heap buffer and points back at the inline one, the elements must have been destroyed or moved
+        void release() noexcept
+        {
+            if (!is_inline())
+            {
+                deallocate(data_, capacity_);
+                data_ = inline_data();
+                capacity_ = N;
+            }
+        }
+
+        // Moves the elements into new_data, an allocated buffer of new_capacity, and frees the old buffer
+        void move_to(T* new_data, size_type new_capacity) noexcept
+        {
+            for (size_type i = 0; i < size_; ++i)
+            {
+                allocator_traits_type::construct(alloc_, new_data + i, std::move(data_[i]));
+                allocator_traits_type::destroy(alloc_, data_ + i);
+            }
+            if (!is_inline())
+            {
+                deallocate(data_, capacity_);
+            }
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        void reallocate(size_type new_capacity)
+        {
+            if (new_capacity <= N)
+            {
+                if (!is_inline())
+                {
+                    T* old_data = data_;
+                    size_type old_capacity = capacity_;
+                    for (size_type i = 0; i < size_; ++i)
+                    {
+                        allocator_traits_type::construct(alloc_, inline_data() + i, std::move(old_data[i]));
+                        allocator_traits_type::destroy(alloc_, old_data + i);
+                    }
+                    deallocate(old_data, old_capacity);
+                    data_ = inline_data();
+                    capacity_ = N;
+                }
+            }
+            else
+            {
+                move_to(allocate(new_capacity), new_capacity);
+            }
+        }
+
+        // Takes the elements of other, *this must be empty and inline
+        void take(small_vector& other) noexcept
+        {
+            if (other.is_inline())
+            {
+                for (size_type i = 0; i < other.size_; ++i)
+                {
+                    allocator_traits_type::construct(alloc_, inline_data() + i, std::move(other.data_[i]));
+                }
+                size_ = other.size_;
+                other.clear();
+            }
+            else
+            {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.size_ = 0;
+                other.capacity_ = N;
+            }
+        }
+
+        template <class InputIt>
+        void append(InputIt first, InputIt last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+
+        template <class ForwardIt>
+        void append(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+        {
+            reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -19,6 +19,7 @@
 #include <stdexcept>
 #include <istream> // std::basic_istream
 #include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/detail/hash.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -543,15 +544,7 @@ namespace std {
     {
         size_t operator()(const jsoncons::detail::basic_string_view<CharT, Traits>& s) const noexcept
         {
-            const int p = 53;
-            const int m = 1000000009;
-            size_t hash_value = 0;
-            size_t p_pow = 1;
-            for (CharT c : s) {
-                hash_value = (hash_value + (c - 'a' + 1) * p_pow) % m;
-                p_pow = (p_pow * p) % m;
-            }
-            return hash_value;
+            return jsoncons::detail::hash_chars(s.data(), s.size());
         }
     };
 } // namespace std
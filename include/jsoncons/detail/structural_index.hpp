@@ -0,0 +1,387 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_STRUCTURAL_INDEX_HPP
+#define JSONCONS_DETAIL_STRUCTURAL_INDEX_HPP
+
+/*
+Stage one of the two-stage (tape) parse, after
+
+Geoff Langdale, Daniel Lemire, Parsing Gigabytes of JSON per Second,
+VLDB Journal 28 (6), 2019.
+
+The input is classified 64 bytes at a time into bitmasks of quotes, backslashes,
+operators and whitespace. Escaped quotes are removed, a prefix xor of the
+remaining quotes gives the bytes inside strings, and the offsets of the operators
+{}[]:, , of opening quotes, and of the first byte of every other atom are written
+to the index. Everything else (validation of strings, numbers and literals, and of
+the grammar) is left to stage two.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memset
+#include <vector>
+#include <jsoncons/detail/simd.hpp>
+
+namespace jsoncons { namespace detail {
+
+    struct block_masks
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;
+        uint64_t whitespace;
+    };
+
+#if defined(JSONCONS_HAS_AVX2)
+
+    inline
+    uint64_t avx2_mask64(__m256i lo, __m256i hi, __m256i c) noexcept
+    {
+        uint64_t l = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, c)));
+        uint64_t h = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, c)));
+        return l | (h << 32);
+    }
+
+    inline
+    block_masks classify_block(const char* p) noexcept
+    {
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+        const __m256i case_bit = _mm256_set1_epi8(0x20);
+        const __m256i lo_folded = _mm256_or_si256(lo, case_bit);
+        const __m256i hi_folded = _mm256_or_si256(hi, case_bit);
+
+        block_masks m;
+        m.quote = avx2_mask64(lo, hi, _mm256_set1_epi8('\"'));
+        m.backslash = avx2_mask64(lo, hi, _mm256_set1_epi8('\\'));
+        m.op = avx2_mask64(lo_folded, hi_folded, _mm256_set1_epi8('{')) |
+               avx2_mask64(lo_folded, hi_folded, _mm256_set1_epi8('}')) |
+               avx2_mask64(lo, hi, _mm256_set1_epi8(':')) |
+               avx2_mask64(lo, hi, _mm256_set1_epi8(','));
+        m.whitespace = avx2_mask64(lo, hi, _mm256_set1_epi8(' ')) |
+                       avx2_mask64(lo, hi, _mm256_set1_epi8('\t')) |
+                       avx2_mask64(lo, hi, _mm256_set1_epi8('\n')) |
+                       avx2_mask64(lo, hi, _mm256_set1_epi8('\r'));
+        return m;
+    }
+
+#elif defined(JSONCONS_HAS_SSE2)
+
+    inline
+    uint64_t sse2_mask64(const __m128i* v, __m128i c) noexcept
+    {
+        uint64_t r0 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[0], c)));
+        uint64_t r1 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[1], c)));
+        uint64_t r2 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[2], c)));
+        uint64_t r3 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[3], c)));
+        return r0 | (r1 << 16) | (r2 << 32) | (r3 << 48);
+    }
+
+    inline
+    block_masks classify_block(const char* p) noexcept
+    {
+        __m128i v[4];
+        __m128i folded[4];
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+        for (int i = 0; i < 4; ++i)
+        {
+            v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16*i));
+            folded[i] = _mm_or_si128(v[i], case_bit);
+        }
+
+        block_masks m;
+        m.quote = sse2_mask64(v, _mm_set1_epi8('\"'));
+        m.backslash = sse2_mask64(v, _mm_set1_epi8('\\'));
+        m.op = sse2_mask64(folded, _mm_set1_epi8('{')) |
+               sse2_mask64(folded, _mm_set1_epi8('}')) |
+               sse2_mask64(v, _mm_set1_epi8(':')) |
+               sse2_mask64(v, _mm_set1_epi8(','));
+        m.whitespace = sse2_mask64(v, _mm_set1_epi8(' ')) |
+                       sse2_mask64(v, _mm_set1_epi8('\t')) |
+                       sse2_mask64(v, _mm_set1_epi8('\n')) |
+                       sse2_mask64(v, _mm_set1_epi8('\r'));
+        return m;
+    }
+
+#elif defined(JSONCONS_HAS_NEON)
+
+    inline
+    uint64_t neon_mask64(const uint8x16_t* v, uint8x16_t c) noexcept
+    {
+        const uint8x16_t bits = {0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80};
+        uint8x16_t t0 = vandq_u8(vceqq_u8(v[0], c), bits);
+        uint8x16_t t1 = vandq_u8(vceqq_u8(v[1], c), bits);
+        uint8x16_t t2 = vandq_u8(vceqq_u8(v[2], c), bits);
+        uint8x16_t t3 = vandq_u8(vceqq_u8(v[3], c), bits);
+        uint8x16_t sum0 = vpaddq_u8(t0, t1);
+        uint8x16_t sum1 = vpaddq_u8(t2, t3);
+        sum0 = vpaddq_u8(sum0, sum1);
+        sum0 = vpaddq_u8(sum0, sum0);
+        return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+    }
+
+    inline
+    block_masks classify_block(const char* p) noexcept
+    {
+        uint8x16_t v[4];
+        uint8x16_t folded[4];
+        const uint8x16_t case_bit = vdupq_n_u8(0x20);
+        for (int i = 0; i < 4; ++i)
+        {
+            v[i] = vld1q_u8(reinterpret_cast<const uint8_t*>(p + 16*i));
+            folded[i] = vorrq_u8(v[i], case_bit);
+        }
+
+        block_masks m;
+        m.quote = neon_mask64(v, vdupq_n_u8('\"'));
+        m.backslash = neon_mask64(v, vdupq_n_u8('\\'));
+        m.op = neon_mask64(folded, vdupq_n_u8('{')) |
+               neon_mask64(folded, vdupq_n_u8('}')) |
+               neon_mask64(v, vdupq_n_u8(':')) |
+               neon_mask64(v, vdupq_n_u8(','));
+        m.whitespace = neon_mask64(v, vdupq_n_u8(' ')) |
+                       neon_mask64(v, vdupq_n_u8('\t')) |
+                       neon_mask64(v, vdupq_n_u8('\n')) |
+                       neon_mask64(v, vdupq_n_u8('\r'));
+        return m;
+    }
+
+#else
+
+    inline
+    block_masks classify_block(const char* p) noexcept
+    {
+        block_masks m = {0, 0, 0, 0};
+        for (int i = 0; i < 64; ++i)
+        {
+            uint64_t bit = uint64_t(1) << i;
+            switch (p[i])
+            {
+                case '\"':
+                    m.quote |= bit;
+                    break;
+                case '\\':
+                    m.backslash |= bit;
+                    break;
+                case '{': case '}': case '[': case ']': case ':': case ',':
+                    m.op |= bit;
+                    break;
+                case ' ': case '\t': case '\n': case '\r':
+                    m.whitespace |= bit;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return m;
+    }
+
+#endif
+
+    // Each bit i of the result is the xor of bits 0 through i of x
+    inline
+    uint64_t prefix_xor(uint64_t x) noexcept
+    {
+        x ^= x << 1;
+        x ^= x << 2;
+        x ^= x << 4;
+        x ^= x << 8;
+        x ^= x << 16;
+        x ^= x << 32;
+        return x;
+    }
+
+    class structural_indexer
+    {
+        uint64_t prev_escaped_;
+        uint64_t prev_in_string_;
+        uint64_t prev_scalar_;
+    public:
+        structural_indexer()
+            : prev_escaped_(0), prev_in_string_(0), prev_scalar_(0)
+        {
+        }
+
+        bool in_string() const
+        {
+            return prev_in_string_ != 0;
+        }
+
+        // Returns the mask of structural positions in a block
+        uint64_t next(const block_masks& m) noexcept
+        {
+            // Characters escaped by a backslash. Backslashes are rare, so the runs are
+            // walked one at a time.
+            uint64_t backslash = m.backslash;
+            uint64_t escaped = 0;
+            if (prev_escaped_)
+            {
+                escaped = 1;
+                backslash &= ~uint64_t(1);
+            }
+            prev_escaped_ = 0;
+            while (backslash != 0)
+            {
+                int i = trailing_zeros(backslash);
+                if (i == 63)
+                {
+                    prev_escaped_ = 1;
+                    break;
+                }
+                escaped |= uint64_t(1) << (i + 1);
+                backslash &= ~(uint64_t(3) << i);
+            }
+
+            uint64_t quote = m.quote & ~escaped;
+            uint64_t in_string = prefix_xor(quote) ^ prev_in_string_;
+            prev_in_string_ = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+            // The inside of each string and its closing quote
+            uint64_t string_tail = in_string ^ quote;
+
+            uint64_t scalar = ~(m.op | m.whitespace);
+            uint64_t nonquote_scalar = scalar & ~quote;
+            uint64_t follows_nonquote_scalar = (nonquote_scalar << 1) | prev_scalar_;
+            prev_scalar_ = nonquote_scalar >> 63;
+
+            return (m.op | (scalar & ~follows_nonquote_scalar)) & ~string_tail;
+        }
+    };
+
+    // find_structural_indexes
+    // Appends the offsets of the structural characters in [data,data+length) to indexes.
+    // Returns false if the input ends inside a string. length must be less than 2^32.
+
+    template <class Allocator>
+    bool find_structural_indexes(const char* data, std::size_t length, std::vector<uint32_t,Allocator>& indexes)
+    {
+        // Typical documents have one structural for every four to eight bytes, so start with room
+        // for one in eight and double as needed. There can be at most 64 in a block.
+        indexes.resize(length/8 + 64);
+        std::size_t count = 0;
+
+        structural_indexer indexer;
+        std::size_t offset = 0;
+        char tail[64];
+        while (offset < length)
+        {
+            const char* block = data + offset;
+            if (length - offset < 64)
+            {
+                std::memset(tail, ' ', sizeof(tail));
+                std::memcpy(tail, block, length - offset);
+                block = tail;
+            }
+            if (indexes.size() - count < 64)
+            {
+                indexes.resize(2*indexes.size());
+            }
+            uint32_t* out = indexes.data() + count;
+            uint64_t structurals = indexer.next(classify_block(block));
+            while (structurals != 0)
+            {
+                *out++ = static_cast<uint32_t>(offset + trailing_zeros(structurals));
+                structurals &= structurals - 1;
+            }
+            count = static_cast<std::size_t>(out - indexes.data());
+            offset += 64;
+        }
+        indexes.resize(count);
+        return !indexer.in_string();
+    }
+
+    // array_element_splitter
+    // Finds the commas that separate the elements of a top-level array, and its closing bracket, with 
+    // the structural indexer, so that brackets, braces and commas inside strings are passed over.
+    // Nesting is tracked by counting brackets and braces of either kind, the text is not otherwise checked.
+    // Offsets are not limited to 32 bits.
+
+    class array_element_splitter
+    {
+        const char* data_;
+        std::size_t length_;
+        structural_indexer indexer_;
+        std::size_t block_offset_;
+        std::size_t next_block_;
+        uint64_t structurals_;
+        std::size_t depth_;
+    public:
+        array_element_splitter(const char* data, std::size_t length)
+            : data_(data), length_(length), block_offset_(0), next_block_(0), structurals_(0), depth_(0)
+        {
+        }
+
+        // Returns the offset of the next separating comma at or after min_offset, or of the closing bracket
+        // of the array, or length if the text ends first
+        std::size_t next_split(std::size_t min_offset)
+        {
+            for (;;)
+            {
+                std::size_t pos = next_structural();
+                if (pos == length_)
+                {
+                    return length_;
+                }
+                switch (data_[pos])
+                {
+                    case '[':
+                    case '{':
+                        ++depth_;
+                        break;
+                    case ']':
+                    case '}':
+                        if (depth_ <= 1)
+                        {
+                            depth_ = 0;
+                            return pos;
+                        }
+                        --depth_;
+                        break;
+                    case ',':
+                        if (depth_ == 1 && pos >= min_offset)
+                        {
+                            return pos;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+    private:
+        std::size_t next_structural()
+        {
+            while (structurals_ == 0)
+            {
+                if (next_block_ >= length_)
+                {
+                    return length_;
+                }
+                const char* block = data_ + next_block_;
+                char tail[64];
+                if (length_ - next_block_ < 64)
+                {
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, block, length_ - next_block_);
+                    block = tail;
+                }
+                structurals_ = indexer_.next(classify_block(block));
+                block_offset_ = next_block_;
+                next_block_ += 64;
+            }
+            std::size_t pos = block_offset_ + static_cast<std::size_t>(trailing_zeros(structurals_));
+            structurals_ &= structurals_ - 1;
+            return pos;
+        }
+    };
+
+}} // namespace detail namespace jsoncons
+
+#endif
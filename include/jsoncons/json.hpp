@@ -8,6 +8,7 @@
 #define JSONCONS_JSON_HPP
 
 #include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_hash.hpp>
 #include <jsoncons/encode_json.hpp>
 #include <jsoncons/decode_json.hpp>
 #include <jsoncons/json_traits_macros.hpp>
@@ -21,6 +21,7 @@
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/detail/cow_vector.hpp>
 
 namespace jsoncons {
 
@@ -138,10 +139,22 @@ namespace jsoncons {
 
         std::size_t capacity() const {return elements_.capacity();}
 
+        // True if the elements are shared with a copy, see copy_on_write_policy
+        bool is_shared() const noexcept {return jsoncons::detail::is_shared_container(elements_);}
+
+        // Bytes allocated for the elements, not including memory the elements own
+        std::size_t allocated_bytes() const noexcept {return jsoncons::detail::container_allocated_bytes(elements_);}
+
         void clear() {elements_.clear();}
 
+        // Removes unused capacity from the elements and from this array. Elements shared with 
+        // a copy are left as they are, compacting them would copy them.
         void shrink_to_fit() 
         {
+            if (is_shared())
+            {
+                return;
+            }
             for (std::size_t i = 0; i < elements_.size(); ++i)
             {
                 elements_[i].shrink_to_fit();
@@ -283,6 +296,11 @@ namespace jsoncons {
 
         void flatten_and_destroy() noexcept
         {
+            // Elements shared with a copy are left to the copy
+            if (is_shared())
+            {
+                return;
+            }
             while (!elements_.empty())
             {
                 value_type current = std::move(elements_.back());
@@ -291,6 +309,10 @@ namespace jsoncons {
                 {
                     case json_storage_kind::array_value:
                     {
+                        if (current.template cast<typename Json::array_storage>().value().is_shared())
+                        {
+                            break;
+                        }
                         for (auto&& item : current.array_range())
                         {
                             if (item.size() > 0) // non-empty object or array
@@ -303,6 +325,10 @@ namespace jsoncons {
                     }
                     case json_storage_kind::object_value:
                     {
+                        if (current.template cast<typename Json::object_storage>().value().is_shared())
+                        {
+                            break;
+                        }
                         for (auto&& kv : current.object_range())
                         {
                             if (kv.value().size() > 0) // non-empty object or array
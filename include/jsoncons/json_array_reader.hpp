@@ -0,0 +1,492 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ARRAY_READER_HPP
+#define JSONCONS_JSON_ARRAY_READER_HPP
+
+#include <algorithm> // std::max
+#include <cstddef>
+#include <cstdint>
+#include <memory> // std::allocator, std::unique_ptr
+#include <system_error>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/detail/json_scan.hpp>
+#include <jsoncons/detail/parallel_chunks.hpp>
+#include <jsoncons/detail/structural_index.hpp>
+
+namespace jsoncons {
+
+    // basic_json_array_reader
+    // Reads the elements of a large top-level JSON array held in memory in parallel. The calling thread
+    // finds the commas between elements with the structural indexer and splits the array into chunks of
+    // whole elements, which are parsed on worker threads. The elements are handed back in input order.
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class basic_json_array_reader
+    {
+    public:
+        using value_type = Json;
+        using char_type = char;
+        using string_view_type = jsoncons::basic_string_view<char>;
+
+        static constexpr std::size_t default_chunk_size = 65536;
+    private:
+        // Elements in [first,last), where last is the separating comma or closing bracket after the last one,
+        // or the end of the input
+        struct chunk
+        {
+            const char* first;
+            const char* last;
+            const char* end;
+            std::vector<Json> values;
+            std::error_code ec;
+            // The error is at line error_line and column error_column of the text starting at error_base
+            const char* error_base;
+            std::size_t error_line;
+            std::size_t error_column;
+
+            chunk()
+                : first(nullptr), last(nullptr), end(nullptr), error_base(nullptr), error_line(0), error_column(0)
+            {
+            }
+        };
+
+        class chunk_parser
+        {
+            basic_json_parser<char,TempAllocator> parser_;
+            json_decoder<Json,TempAllocator> decoder_;
+        public:
+            chunk_parser(const basic_json_decode_options<char>& options, const TempAllocator& alloc)
+                : parser_(options, options.err_handler(), alloc), decoder_(temp_allocator_arg, alloc)
+            {
+            }
+
+            void operator()(chunk& c)
+            {
+                parse_chunk(c, parser_, decoder_);
+            }
+        };
+
+        string_view_type source_;
+        basic_json_decode_options<char> options_;
+        TempAllocator alloc_;
+        std::size_t num_threads_;
+        std::size_t chunk_size_;
+        std::size_t max_chunks_in_flight_;
+        std::size_t line_;
+        std::size_t column_;
+
+        // Noncopyable and nonmoveable
+        basic_json_array_reader(const basic_json_array_reader&) = delete;
+        basic_json_array_reader& operator=(const basic_json_array_reader&) = delete;
+
+    public:
+        // num_threads 0 means one thread per hardware thread
+        basic_json_array_reader(const string_view_type& source,
+                                std::size_t num_threads = 0,
+                                const TempAllocator& alloc = TempAllocator())
+            : basic_json_array_reader(source, basic_json_decode_options<char>(), num_threads, alloc)
+        {
+        }
+
+        basic_json_array_reader(const string_view_type& source,
+                                const basic_json_decode_options<char>& options,
+                                std::size_t num_threads = 0,
+                                const TempAllocator& alloc = TempAllocator())
+            : source_(source),
+              options_(options),
+              alloc_(alloc),
+              num_threads_(num_threads != 0 ? num_threads : (std::max)(std::size_t(1), static_cast<std::size_t>(std::thread::hardware_concurrency()))),
+              chunk_size_(default_chunk_size),
+              max_chunks_in_flight_(2*num_threads_),
+              line_(0),
+              column_(0)
+        {
+        }
+
+        std::size_t num_threads() const
+        {
+            return num_threads_;
+        }
+
+        std::size_t chunk_size() const
+        {
+            return chunk_size_;
+        }
+
+        // Chunks end at the first comma between elements at or after this many bytes
+        basic_json_array_reader& chunk_size(std::size_t value)
+        {
+            chunk_size_ = value != 0 ? value : 1;
+            return *this;
+        }
+
+        std::size_t max_chunks_in_flight() const
+        {
+            return max_chunks_in_flight_;
+        }
+
+        basic_json_array_reader& max_chunks_in_flight(std::size_t value)
+        {
+            max_chunks_in_flight_ = value != 0 ? value : 1;
+            return *this;
+        }
+
+        // The line and column of the error after a failed read
+        std::size_t line() const
+        {
+            return line_;
+        }
+
+        std::size_t column() const
+        {
+            return column_;
+        }
+
+        // Calls callback(Json&&) for each element of the array, in order, on the calling thread.
+        // A text that is not an array is passed to the callback whole.
+        template <class Callback>
+        void read(Callback callback)
+        {
+            std::error_code ec;
+            read(callback, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+        }
+
+        template <class Callback>
+        void read(Callback callback, std::error_code& ec)
+        {
+            line_ = 0;
+            column_ = 0;
+
+            const char* data = source_.data();
+            std::size_t length = source_.size();
+            std::size_t start = skip_bom(data, length);
+            data += start;
+            length -= start;
+            start = skip_whitespace(data, length);
+            if (start == length || data[start] != '[')
+            {
+                read_whole(data, length, callback, ec);
+                return;
+            }
+
+            jsoncons::detail::array_element_splitter splitter(data, length);
+            const char* next = data + start + 1;
+            const char* end = data + length;
+            // Offset of the closing bracket, or length if there is none
+            std::size_t close = length;
+            bool done = false;
+
+            jsoncons::detail::parse_chunks_in_order<chunk>(num_threads_, max_chunks_in_flight_,
+                [this]()
+                {
+                    return std::unique_ptr<chunk_parser>(new chunk_parser(options_, alloc_));
+                },
+                [this,&splitter,&next,&close,&done,data,start,end](chunk& c) -> bool
+                {
+                    if (done)
+                    {
+                        return false;
+                    }
+                    std::size_t offset = static_cast<std::size_t>(next - data);
+                    std::size_t split = splitter.next_split(offset + chunk_size_ - 1);
+                    c.first = next;
+                    c.last = data + split;
+                    c.end = end;
+                    if (c.last == end || *c.last != ',')
+                    {
+                        done = true;
+                        close = split;
+                        // An empty array
+                        if (offset == start + 1 && c.last != end && *c.last == ']' && is_blank(c.first, c.last))
+                        {
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        next = c.last + 1;
+                    }
+                    return true;
+                },
+                [this,&callback,&ec,data](chunk& c) -> bool
+                {
+                    if (c.ec)
+                    {
+                        ec = c.ec;
+                        set_error_position(data, c.error_base, c.error_line, c.error_column);
+                        return false;
+                    }
+                    for (auto& val : c.values)
+                    {
+                        callback(std::move(val));
+                    }
+                    c.values.clear();
+                    return true;
+                });
+
+            if (ec)
+            {
+                return;
+            }
+            if (close == length)
+            {
+                ec = json_errc::unexpected_eof;
+                jsoncons::detail::json_text_position(data, length, line_, column_);
+            }
+            else if (data[close] != ']')
+            {
+                // As basic_json_parser, the position just after the brace
+                ec = json_errc::expected_comma_or_rbracket;
+                jsoncons::detail::json_text_position(data, close + 1, line_, column_);
+            }
+            else if (skip_whitespace(data + close + 1, length - close - 1) != length - close - 1)
+            {
+                // As basic_json_parser, the position just after the array
+                ec = json_errc::extra_character;
+                jsoncons::detail::json_text_position(data, close + 1, line_, column_);
+            }
+        }
+
+        // Reads the elements into one array, in order. A text that is not an array is returned as is.
+        Json read_array()
+        {
+            std::error_code ec;
+            Json result = read_array(ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+            return result;
+        }
+
+        Json read_array(std::error_code& ec)
+        {
+            const char* data = source_.data();
+            std::size_t length = source_.size();
+            std::size_t start = skip_bom(data, length);
+            start += skip_whitespace(data + start, length - start);
+            if (start == length || data[start] != '[')
+            {
+                Json result;
+                read([&result](Json&& val) {result = std::move(val);}, ec);
+                return result;
+            }
+
+            Json result(json_array_arg);
+            read([&result](Json&& val) {result.push_back(std::move(val));}, ec);
+            return result;
+        }
+
+    private:
+        static std::size_t skip_bom(const char* data, std::size_t length)
+        {
+            return length >= 3 && static_cast<uint8_t>(data[0]) == 0xEF && static_cast<uint8_t>(data[1]) == 0xBB &&
+                   static_cast<uint8_t>(data[2]) == 0xBF ? 3 : 0;
+        }
+
+        static std::size_t skip_whitespace(const char* data, std::size_t length)
+        {
+            std::size_t i = 0;
+            while (i < length && (data[i] == ' ' || data[i] == '\t' || data[i] == '\n' || data[i] == '\r'))
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        static bool is_blank(const char* first, const char* last)
+        {
+            for (; first != last; ++first)
+            {
+                if (!(*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r'))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void set_error_position(const char* data, const char* base, std::size_t line, std::size_t column)
+        {
+            std::size_t base_line, base_column;
+            jsoncons::detail::json_text_position(data, static_cast<std::size_t>(base - data), base_line, base_column);
+            line_ = base_line + line - 1;
+            column_ = line == 1 ? base_column + column - 1 : column;
+        }
+
+        template <class Callback>
+        void read_whole(const char* data, std::size_t length, Callback& callback, std::error_code& ec)
+        {
+            basic_json_parser<char,TempAllocator> parser(options_, options_.err_handler(), alloc_);
+            json_decoder<Json,TempAllocator> decoder(temp_allocator_arg, alloc_);
+            parser.update(data, length);
+            parse_value(parser, decoder, ec);
+            if (!ec)
+            {
+                parser.check_done(ec);
+            }
+            if (!ec && !decoder.is_valid())
+            {
+                ec = json_errc::unexpected_eof;
+            }
+            if (ec)
+            {
+                line_ = parser.line();
+                column_ = parser.column();
+                return;
+            }
+            callback(decoder.get_result());
+        }
+
+        static void parse_value(basic_json_parser<char,TempAllocator>& parser, json_decoder<Json,TempAllocator>& decoder, std::error_code& ec)
+        {
+            while (!parser.stopped())
+            {
+                bool eof = parser.source_exhausted();
+                parser.parse_some(decoder, ec);
+                if (ec)
+                {
+                    return;
+                }
+                if (eof)
+                {
+                    if (parser.enter())
+                    {
+                        return;
+                    }
+                    else if (!parser.accept())
+                    {
+                        ec = json_errc::unexpected_eof;
+                        return;
+                    }
+                }
+            }
+        }
+
+        static void fail(chunk& c, std::error_code ec, const char* base, std::size_t line, std::size_t column)
+        {
+            c.ec = ec;
+            c.error_base = base;
+            c.error_line = line;
+            c.error_column = column;
+        }
+
+        static void parse_chunk(chunk& c, basic_json_parser<char,TempAllocator>& parser, json_decoder<Json,TempAllocator>& decoder)
+        {
+            c.values.clear();
+            c.ec = std::error_code();
+
+            const char* p = c.first;
+            for (;;)
+            {
+                const char* q = p;
+                while (q != c.last && (*q == ' ' || *q == '\t' || *q == '\n' || *q == '\r'))
+                {
+                    ++q;
+                }
+                // No value before the next comma, the closing bracket or the end, reported where
+                // basic_json_parser reports it
+                if (q != c.last && *q == ',')
+                {
+                    fail(c, json_errc::expected_value, q, 1, 1);
+                    return;
+                }
+                if (q == c.last)
+                {
+                    if (c.last == c.end)
+                    {
+                        fail(c, json_errc::unexpected_eof, c.last, 1, 1);
+                    }
+                    else if (*c.last == ']' && *(p - 1) == ',')
+                    {
+                        fail(c, json_errc::extra_comma, c.last, 1, 2);
+                    }
+                    else
+                    {
+                        fail(c, json_errc::expected_value, c.last, 1, 1);
+                    }
+                    return;
+                }
+                // The parser stops after the value, but is given the rest of the input so that an error is
+                // found where basic_json_parser finds it when reading the whole text
+                parser.reinitialize();
+                parser.update(p, static_cast<std::size_t>(c.end - p));
+                decoder.reset();
+                std::error_code ec;
+                parse_value(parser, decoder, ec);
+                if (!ec && !decoder.is_valid())
+                {
+                    ec = json_errc::unexpected_eof;
+                }
+                if (ec)
+                {
+                    // A character that cannot start a value is a syntax error at the root, but inside an array
+                    // basic_json_parser expects a value
+                    if (ec == json_errc::syntax_error)
+                    {
+                        std::size_t line, column;
+                        jsoncons::detail::json_text_position(p, static_cast<std::size_t>(q - p), line, column);
+                        if (parser.line() == line && parser.column() == column)
+                        {
+                            ec = json_errc::expected_value;
+                        }
+                    }
+                    fail(c, ec, p, parser.line(), parser.column());
+                    return;
+                }
+                c.values.push_back(decoder.get_result());
+
+                q = p + parser.end_position();
+                // The comma that ends a number is consumed with it
+                if (*(q - 1) == ',')
+                {
+                    if (q - 1 == c.last)
+                    {
+                        return;
+                    }
+                    p = q;
+                    continue;
+                }
+                while (q < c.last && (*q == ' ' || *q == '\t' || *q == '\n' || *q == '\r'))
+                {
+                    ++q;
+                }
+                if (q >= c.last)
+                {
+                    return;
+                }
+                if (*q != ',')
+                {
+                    fail(c, json_errc::expected_comma_or_rbracket, q, 1, 1);
+                    return;
+                }
+                p = q + 1;
+            }
+        }
+    };
+
+    template <class Json,class TempAllocator>
+    constexpr std::size_t basic_json_array_reader<Json,TempAllocator>::default_chunk_size;
+
+    using json_array_reader = basic_json_array_reader<json>;
+    using ojson_array_reader = basic_json_array_reader<ojson>;
+
+} // namespace jsoncons
+
+#endif
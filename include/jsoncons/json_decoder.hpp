@@ -7,20 +7,27 @@
 #ifndef JSONCONS_JSON_DECODER_HPP
 #define JSONCONS_JSON_DECODER_HPP
 
+#include <algorithm> // std::min, std::max
+#include <limits> // std::numeric_limits
 #include <string>
 #include <vector>
 #include <type_traits> // std::true_type
 #include <memory> // std::allocator
 #include <iterator> // std::make_move_iterator
 #include <utility> // std::move
+#include <cstring> // std::memcpy
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_type.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/shared_key.hpp>
+#include <jsoncons/detail/packed_array.hpp>
 
 namespace jsoncons {
 
 template <class Json,class TempAllocator=std::allocator<char>>
 class json_decoder final : public basic_json_visitor<typename Json::char_type>
 {
+    friend Json;
 public:
     using char_type = typename Json::char_type;
     using typename basic_json_visitor<char_type>::string_view_type;
@@ -51,8 +58,18 @@ private:
     };
 
     using temp_allocator_type = TempAllocator;
-    using stack_item_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<index_key_value<Json>>;
+    using temp_item_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<index_key_value<Json>>;
+    using result_item_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<index_key_value<Json>>;
+    // The stack of items under construction is scratch memory, so it comes from the temp allocator and the
+    // values are given the result allocator explicitly. A temp allocator that would construct the items with 
+    // itself (uses-allocator construction) keeps them in the result allocator instead.
+    using items_use_temp_allocator = std::integral_constant<bool,
+        std::is_same<temp_item_allocator_type,std::allocator<index_key_value<Json>>>::value ||
+        !std::uses_allocator<index_key_value<Json>,temp_item_allocator_type>::value>;
+    using stack_item_allocator_type = typename std::conditional<items_use_temp_allocator::value,
+        temp_item_allocator_type,result_item_allocator_type>::type;
     using structure_info_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info>;
+    using key_table_type = jsoncons::detail::shared_key_table<key_type,temp_allocator_type>;
  
     allocator_type allocator_;
 
@@ -63,17 +80,30 @@ private:
     std::vector<index_key_value<Json>,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
     bool is_valid_;
+    key_table_type key_table_;
+    char_type* insitu_data_;
+    std::size_t insitu_length_;
+    std::size_t max_length_hint_;
+    std::size_t min_packed_array_length_;
 
 public:
+    static constexpr std::size_t default_max_interned_keys = 1024;
+    static constexpr std::size_t default_max_length_hint = 65536;
+
     json_decoder(const allocator_type& alloc = allocator_type(), 
         const temp_allocator_type& temp_alloc = temp_allocator_type())
         : allocator_(alloc),
           result_(),
           index_(0),
           name_(alloc),
-          item_stack_(alloc),
+          item_stack_(item_allocator(alloc, temp_alloc, items_use_temp_allocator())),
           structure_stack_(temp_alloc),
-          is_valid_(false)
+          is_valid_(false),
+          key_table_(default_max_interned_keys, temp_alloc),
+          insitu_data_(nullptr),
+          insitu_length_(0),
+          max_length_hint_(default_max_length_hint),
+          min_packed_array_length_(0)
     {
         item_stack_.reserve(1000);
         structure_stack_.reserve(100);
@@ -86,9 +116,14 @@ public:
           result_(),
           index_(0),
           name_(),
-          item_stack_(),
+          item_stack_(item_allocator(allocator_type(), temp_alloc, items_use_temp_allocator())),
           structure_stack_(temp_alloc),
-          is_valid_(false)
+          is_valid_(false),
+          key_table_(default_max_interned_keys, temp_alloc),
+          insitu_data_(nullptr),
+          insitu_length_(0),
+          max_length_hint_(default_max_length_hint),
+          min_packed_array_length_(0)
     {
         item_stack_.reserve(1000);
         structure_stack_.reserve(100);
@@ -117,6 +152,45 @@ public:
         return is_valid_;
     }
 
+    // When Json's key_type is a basic_shared_key, as with shared_key_policy, object member names are
+    // interned: each distinct name gets one allocation that all of its occurrences share. Interning
+    // stops after max_interned_keys distinct names. Other key types are not affected.
+    std::size_t max_interned_keys() const
+    {
+        return key_table_.max_size();
+    }
+
+    void max_interned_keys(std::size_t value)
+    {
+        key_table_.max_size(value);
+    }
+
+    // Binary formats such as CBOR and MessagePack announce the lengths of arrays and maps, and the decoder
+    // reserves room for that many items. A length comes from the input and may be hostile, so no more
+    // than max_length_hint items are reserved for one container. Zero ignores lengths.
+    std::size_t max_length_hint() const
+    {
+        return max_length_hint_;
+    }
+
+    void max_length_hint(std::size_t value)
+    {
+        max_length_hint_ = value;
+    }
+
+    // Typed arrays, such as CBOR typed arrays, are kept as packed arrays of their numbers. An array 
+    // of at least min_packed_array_length numbers, all doubles, or all integers that fit in an int64 
+    // or all in a uint64, is also kept as a packed array. Zero, the default, packs typed arrays only.
+    std::size_t min_packed_array_length() const
+    {
+        return min_packed_array_length_;
+    }
+
+    void min_packed_array_length(std::size_t value)
+    {
+        min_packed_array_length_ = value;
+    }
+
     Json get_result()
     {
         JSONCONS_ASSERT(is_valid_);
@@ -134,6 +208,65 @@ public:
 
 private:
 
+    static stack_item_allocator_type item_allocator(const allocator_type&, const temp_allocator_type& temp_alloc, std::true_type)
+    {
+        return stack_item_allocator_type(temp_alloc);
+    }
+
+    static stack_item_allocator_type item_allocator(const allocator_type& alloc, const temp_allocator_type&, std::false_type)
+    {
+        return stack_item_allocator_type(alloc);
+    }
+
+    template <class... Args>
+    void emplace_item(std::true_type, Args&&... args)
+    {
+        item_stack_.emplace_back(std::move(name_), index_++, std::forward<Args>(args)..., allocator_);
+    }
+
+    template <class... Args>
+    void emplace_item(std::false_type, Args&&... args)
+    {
+        item_stack_.emplace_back(std::move(name_), index_++, std::forward<Args>(args)...);
+    }
+
+    // Makes room on the item stack for the items of a container whose length is known. Growth stays
+    // geometric, so that many small containers do not each cause a reallocation.
+    void reserve_items(std::size_t length)
+    {
+        std::size_t needed = item_stack_.size() + (std::min)(length, max_length_hint_);
+        if (needed > item_stack_.capacity())
+        {
+            item_stack_.reserve((std::max)(needed, 2*item_stack_.capacity()));
+        }
+    }
+
+    // Used by Json::parse_insitu. Strings are unescaped into the parsed buffer and referred to there
+    void insitu_buffer(char_type* data, std::size_t length)
+    {
+        insitu_data_ = data;
+        insitu_length_ = length;
+    }
+
+    // Moves the unescaped text of a quoted string over its escaped text in the buffer and terminates it
+    // after the parser has consumed it. The unescaped text is never longer than the escaped text.
+    bool insitu_string(const string_view_type& sv, const ser_context& context, string_view_type& result)
+    {
+        std::size_t pos = context.position();
+        if (pos >= insitu_length_ || insitu_data_[pos] != '\"' || sv.length() >= insitu_length_ - pos - 1)
+        {
+            return false;
+        }
+        char_type* first = insitu_data_ + pos + 1;
+        if (sv.data() != first)
+        {
+            std::memcpy(first, sv.data(), sv.length()*sizeof(char_type));
+        }
+        first[sv.length()] = 0;
+        result = string_view_type(first, sv.length());
+        return true;
+    }
+
     void visit_flush() override
     {
     }
@@ -146,11 +279,18 @@ private:
             item_stack_.clear();
             is_valid_ = false;
         }
-        item_stack_.emplace_back(std::move(name_), index_++, json_object_arg, tag);
+        emplace_item(items_use_temp_allocator(), json_object_arg, tag);
         structure_stack_.emplace_back(structure_type::object_t, item_stack_.size()-1);
         return true;
     }
 
+    bool visit_begin_object(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        bool more = visit_begin_object(tag, context, ec);
+        reserve_items(length);
+        return more;
+    }
+
     bool visit_end_object(const ser_context&, std::error_code&) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 0);
@@ -186,11 +326,18 @@ private:
             item_stack_.clear();
             is_valid_ = false;
         }
-        item_stack_.emplace_back(std::move(name_), index_++, json_array_arg, tag);
+        emplace_item(items_use_temp_allocator(), json_array_arg, tag);
         structure_stack_.emplace_back(structure_type::array_t, item_stack_.size()-1);
         return true;
     }
 
+    bool visit_begin_array(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        bool more = visit_begin_array(tag, context, ec);
+        reserve_items(length);
+        return more;
+    }
+
     bool visit_end_array(const ser_context&, std::error_code&) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 1);
@@ -205,12 +352,16 @@ private:
 
         if (size > 0)
         {
-            container.reserve(size);
             auto first = item_stack_.begin() + (container_index+1);
             auto last = first + size;
-            for (auto it = first; it != last; ++it)
+            if (min_packed_array_length_ == 0 || size < min_packed_array_length_ || !pack_numbers(container, first, last))
             {
-                container.push_back(std::move(it->value));
+                container.reserve(size);
+                for (auto it = first; it != last; ++it)
+                {
+                    container.push_back(std::move(it->value));
+                }
+                nan_box_array(jsoncons::detail::is_nan_boxed_policy<typename Json::policy_type>(), container);
             }
             item_stack_.erase(first, item_stack_.end());
         }
@@ -226,19 +377,202 @@ private:
         return true;
     }
 
+    // Replaces container with a packed array of the numbers in [first,last), if they are all doubles,
+    // or all integers that fit in an int64 or all in a uint64, and have no semantic tags
+    template <class Iterator>
+    bool pack_numbers(Json& container, Iterator first, Iterator last)
+    {
+        bool has_double = false;
+        bool has_int64 = false;
+        bool has_uint64 = false;
+        bool has_large_uint64 = false;
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->value.tag() != semantic_tag::none)
+            {
+                return false;
+            }
+            switch (it->value.storage_kind())
+            {
+                case json_storage_kind::double_value:
+                    has_double = true;
+                    break;
+                case json_storage_kind::int64_value:
+                    has_int64 = true;
+                    break;
+                case json_storage_kind::uint64_value:
+                    has_uint64 = true;
+                    if (it->value.template as_integer<uint64_t>() > static_cast<uint64_t>((std::numeric_limits<int64_t>::max)()))
+                    {
+                        has_large_uint64 = true;
+                    }
+                    break;
+                default:
+                    return false;
+            }
+        }
+        if (has_double)
+        {
+            if (has_int64 || has_uint64)
+            {
+                return false;
+            }
+            container = make_packed<double>(first, last, container.tag());
+        }
+        else if (has_int64)
+        {
+            if (has_large_uint64)
+            {
+                return false;
+            }
+            container = make_packed<int64_t>(first, last, container.tag());
+        }
+        else
+        {
+            container = make_packed<uint64_t>(first, last, container.tag());
+        }
+        return true;
+    }
+
+    void nan_box_array(std::false_type, Json&)
+    {
+    }
+
+    // With a nan_boxed_policy, replaces container with a NaN-boxed packed array of its elements
+    // if that takes less memory
+    void nan_box_array(std::true_type, Json& container)
+    {
+        auto& elements = container.template cast<typename Json::array_storage>().value();
+        if (jsoncons::detail::packed_array<Json>::nan_boxing_saves_memory(elements.begin(), elements.end()))
+        {
+            container = Json(nan_boxed_array_arg, std::move(elements), container.tag(), allocator_);
+        }
+    }
+
+    template <class T,class Iterator>
+    Json make_packed(Iterator first, Iterator last, semantic_tag tag)
+    {
+        using value_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<T>;
+        std::vector<T,value_allocator_type> values(value_allocator_type(structure_stack_.get_allocator()));
+        values.reserve(static_cast<std::size_t>(last - first));
+        for (auto it = first; it != last; ++it)
+        {
+            values.push_back(it->value.template as<T>());
+        }
+        return Json(packed_array_arg, jsoncons::span<const T>(values.data(), values.size()), tag, allocator_);
+    }
+
+    template <class... Args>
+    bool packed_array_value(Args&&... args)
+    {
+        switch (structure_stack_.back().type_)
+        {
+            case structure_type::object_t:
+            case structure_type::array_t:
+                emplace_item(items_use_temp_allocator(), packed_array_arg, std::forward<Args>(args)...);
+                break;
+            case structure_type::root_t:
+                result_ = Json(packed_array_arg, std::forward<Args>(args)..., allocator_);
+                is_valid_ = true;
+                return false;
+        }
+        return true;
+    }
+
+    bool visit_typed_array(const jsoncons::span<const uint8_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const uint16_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const uint32_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const uint64_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const int8_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const int16_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const int32_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const int64_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(half_arg_t, const jsoncons::span<const uint16_t>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(half_arg, s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const float>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const jsoncons::span<const double>& s, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return packed_array_value(s, tag);
+    }
+
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
     {
-        name_ = key_type(name.data(),name.length(),allocator_);
+        name_ = make_key(name, is_shared_key<key_type>());
         return true;
     }
 
-    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+    key_type make_key(const string_view_type& name, std::false_type)
+    {
+        return key_type(name.data(),name.length(),allocator_);
+    }
+
+    key_type make_key(const string_view_type& name, std::true_type)
+    {
+        return key_table_.get(name, allocator_);
+    }
+
+    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context& context, std::error_code&) override
     {
+        string_view_type insitu;
+        if (insitu_data_ != nullptr && insitu_string(sv, context, insitu))
+        {
+            switch (structure_stack_.back().type_)
+            {
+                case structure_type::object_t:
+                case structure_type::array_t:
+                    emplace_item(items_use_temp_allocator(), string_view_arg, insitu, tag);
+                    break;
+                case structure_type::root_t:
+                    result_ = Json(string_view_arg, insitu, tag, allocator_);
+                    is_valid_ = true;
+                    return false;
+            }
+            return true;
+        }
         switch (structure_stack_.back().type_)
         {
             case structure_type::object_t:
             case structure_type::array_t:
-                item_stack_.emplace_back(std::move(name_), index_++, sv, tag);
+                emplace_item(items_use_temp_allocator(), sv, tag);
                 break;
             case structure_type::root_t:
                 result_ = Json(sv, tag, allocator_);
@@ -257,7 +591,7 @@ private:
         {
             case structure_type::object_t:
             case structure_type::array_t:
-                item_stack_.emplace_back(std::move(name_), index_++, byte_string_arg, b, tag);
+                emplace_item(items_use_temp_allocator(), byte_string_arg, b, tag);
                 break;
             case structure_type::root_t:
                 result_ = Json(byte_string_arg, b, tag, allocator_);
@@ -276,7 +610,7 @@ private:
         {
             case structure_type::object_t:
             case structure_type::array_t:
-                item_stack_.emplace_back(std::move(name_), index_++, byte_string_arg, b, ext_tag);
+                emplace_item(items_use_temp_allocator(), byte_string_arg, b, ext_tag);
                 break;
             case structure_type::root_t:
                 result_ = Json(byte_string_arg, b, ext_tag, allocator_);
@@ -362,6 +696,26 @@ private:
         return true;
     }
 
+    // Keeps the number text, lazy_number parses only
+    bool visit_number(const string_view_type& text, 
+                      semantic_tag tag,   
+                      const ser_context&,
+                      std::error_code&) override
+    {
+        switch (structure_stack_.back().type_)
+        {
+            case structure_type::object_t:
+            case structure_type::array_t:
+                emplace_item(items_use_temp_allocator(), number_text_arg, text, tag);
+                break;
+            case structure_type::root_t:
+                result_ = Json(number_text_arg, text, tag, allocator_);
+                is_valid_ = true;
+                return false;
+        }
+        return true;
+    }
+
     bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
     {
         switch (structure_stack_.back().type_)
@@ -395,6 +749,12 @@ private:
     }
 };
 
+template <class Json,class TempAllocator>
+constexpr std::size_t json_decoder<Json,TempAllocator>::default_max_interned_keys;
+
+template <class Json,class TempAllocator>
+constexpr std::size_t json_decoder<Json,TempAllocator>::default_max_length_hint;
+
 } // namespace jsoncons
 
 #endif
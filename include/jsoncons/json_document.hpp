@@ -0,0 +1,900 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_DOCUMENT_HPP
+#define JSONCONS_JSON_DOCUMENT_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <istream> // std::basic_istream
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <system_error>
+#include <type_traits>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_tape.hpp>
+
+namespace jsoncons {
+
+    // basic_json_document_view
+    // A read-only handle to a value on the tape of a basic_json_document. Views are cheap to copy,
+    // and remain valid as long as the document (and the text it refers to) is neither destroyed nor moved.
+
+    template <class Allocator=std::allocator<char>>
+    class basic_json_document_view
+    {
+    public:
+        using allocator_type = Allocator;
+        using char_type = char;
+        using string_view_type = jsoncons::basic_string_view<char>;
+        using json_tape_type = basic_json_tape<Allocator>;
+
+        class key_value_type;
+        class object_iterator;
+        class array_iterator;
+
+        using const_object_iterator = object_iterator;
+        using const_array_iterator = array_iterator;
+        using object_range_type = range<object_iterator,object_iterator>;
+        using array_range_type = range<array_iterator,array_iterator>;
+
+    private:
+        using default_json_type = basic_json<char,sorted_policy,Allocator>;
+
+        template <class T>
+        struct is_scalar_target
+            : std::integral_constant<bool, std::is_same<T,bool>::value ||
+                                           extension_traits::is_integer<T>::value ||
+                                           std::is_floating_point<T>::value ||
+                                           std::is_same<T,string_view_type>::value ||
+                                           extension_traits::is_string<T>::value>
+        {
+        };
+
+        const json_tape_type* tape_;
+        std::size_t index_;
+
+    public:
+        basic_json_document_view(const json_tape_type& tape, std::size_t index)
+            : tape_(std::addressof(tape)), index_(index)
+        {
+        }
+
+        basic_json_document_view(const basic_json_document_view&) = default;
+        basic_json_document_view& operator=(const basic_json_document_view&) = default;
+
+        // Index of the value on the tape
+        std::size_t index() const
+        {
+            return index_;
+        }
+
+        json_type type() const
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::begin_object:
+                    return json_type::object_value;
+                case tape_type::begin_array:
+                    return json_type::array_value;
+                case tape_type::string_value:
+                case tape_type::bigint_value:
+                case tape_type::bigdec_value:
+                    return json_type::string_value;
+                case tape_type::int64_value:
+                    return json_type::int64_value;
+                case tape_type::uint64_value:
+                    return json_type::uint64_value;
+                case tape_type::double_value:
+                    return json_type::double_value;
+                case tape_type::true_value:
+                case tape_type::false_value:
+                    return json_type::bool_value;
+                default:
+                    return json_type::null_value;
+            }
+        }
+
+        semantic_tag tag() const
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::bigint_value:
+                    return semantic_tag::bigint;
+                case tape_type::bigdec_value:
+                    return semantic_tag::bigdec;
+                default:
+                    return semantic_tag::none;
+            }
+        }
+
+        bool is_null() const noexcept
+        {
+            return tape_->type(index_) == tape_type::null_value;
+        }
+
+        bool is_bool() const noexcept
+        {
+            return tape_->type(index_) == tape_type::true_value || tape_->type(index_) == tape_type::false_value;
+        }
+
+        bool is_string() const noexcept
+        {
+            return tape_->type(index_) == tape_type::string_value || tape_->type(index_) == tape_type::bigint_value ||
+                   tape_->type(index_) == tape_type::bigdec_value;
+        }
+
+        bool is_int64() const noexcept
+        {
+            return tape_->type(index_) == tape_type::int64_value;
+        }
+
+        bool is_uint64() const noexcept
+        {
+            return tape_->type(index_) == tape_type::uint64_value;
+        }
+
+        bool is_double() const noexcept
+        {
+            return tape_->type(index_) == tape_type::double_value;
+        }
+
+        bool is_number() const noexcept
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::int64_value:
+                case tape_type::uint64_value:
+                case tape_type::double_value:
+                case tape_type::bigint_value:
+                case tape_type::bigdec_value:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool is_object() const noexcept
+        {
+            return tape_->type(index_) == tape_type::begin_object;
+        }
+
+        bool is_array() const noexcept
+        {
+            return tape_->type(index_) == tape_type::begin_array;
+        }
+
+        bool empty() const noexcept
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::begin_object:
+                case tape_type::begin_array:
+                    return tape_->count(index_) == 0;
+                case tape_type::string_value:
+                    return tape_->string(index_).empty();
+                default:
+                    return false;
+            }
+        }
+
+        // Number of elements of an array or members of an object, 0 for other values
+        std::size_t size() const noexcept
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::begin_object:
+                case tape_type::begin_array:
+                {
+                    std::size_t count = tape_->count(index_);
+                    if (count < json_tape_type::max_count)
+                    {
+                        return count;
+                    }
+                    // The count saturated, walk the container
+                    count = 0;
+                    const std::size_t step = is_object() ? 1 : 0;
+                    std::size_t end = tape_->end_of(index_);
+                    for (std::size_t i = index_ + 1; i < end; i = tape_->next(i + step))
+                    {
+                        ++count;
+                    }
+                    return count;
+                }
+                default:
+                    return 0;
+            }
+        }
+
+        bool contains(const string_view_type& key) const noexcept
+        {
+            return is_object() && find_member(key) != tape_->end_of(index_);
+        }
+
+        object_iterator find(const string_view_type& key) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(key.data(),key.length()));
+            }
+            return object_iterator(*tape_, find_member(key));
+        }
+
+        basic_json_document_view at(const string_view_type& key) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(key.data(),key.length()));
+            }
+            std::size_t i = find_member(key);
+            if (i == tape_->end_of(index_))
+            {
+                JSONCONS_THROW(key_not_found(key.data(),key.length()));
+            }
+            return basic_json_document_view(*tape_, i + 1);
+        }
+
+        // Elements are reached by skipping their predecessors, which takes one step per element
+        basic_json_document_view at(std::size_t index) const
+        {
+            std::size_t step;
+            switch (tape_->type(index_))
+            {
+                case tape_type::begin_array:
+                    step = 0;
+                    break;
+                case tape_type::begin_object:
+                    step = 1;
+                    break;
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+            std::size_t end = tape_->end_of(index_);
+            std::size_t i = index_ + 1;
+            for (std::size_t n = 0; n < index && i < end; ++n)
+            {
+                i = tape_->next(i + step);
+            }
+            if (i >= end)
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return basic_json_document_view(*tape_, i + step);
+        }
+
+        basic_json_document_view operator[](const string_view_type& key) const
+        {
+            return at(key);
+        }
+
+        basic_json_document_view operator[](std::size_t index) const
+        {
+            return at(index);
+        }
+
+        object_range_type object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            return object_range_type(object_iterator(*tape_, index_ + 1), object_iterator(*tape_, tape_->end_of(index_)));
+        }
+
+        array_range_type array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            return array_range_type(array_iterator(*tape_, index_ + 1), array_iterator(*tape_, tape_->end_of(index_)));
+        }
+
+        bool as_bool() const
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::true_value:
+                    return true;
+                case tape_type::false_value:
+                    return false;
+                case tape_type::int64_value:
+                    return tape_->int64_value(index_) != 0;
+                case tape_type::uint64_value:
+                    return tape_->uint64_value(index_) != 0;
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a bool"));
+            }
+        }
+
+        template <class IntegerType>
+        IntegerType as_integer() const
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::string_value:
+                case tape_type::bigint_value:
+                case tape_type::bigdec_value:
+                {
+                    IntegerType val;
+                    string_view_type s = tape_->string(index_);
+                    auto result = jsoncons::detail::to_integer(s.data(), s.length(), val);
+                    if (!result)
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::runtime_error>(result.error_code().message()));
+                    }
+                    return val;
+                }
+                case tape_type::double_value:
+                    return static_cast<IntegerType>(tape_->double_value(index_));
+                case tape_type::int64_value:
+                    return static_cast<IntegerType>(tape_->int64_value(index_));
+                case tape_type::uint64_value:
+                    return static_cast<IntegerType>(tape_->uint64_value(index_));
+                case tape_type::true_value:
+                    return static_cast<IntegerType>(1);
+                case tape_type::false_value:
+                    return static_cast<IntegerType>(0);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an integer"));
+            }
+        }
+
+        double as_double() const
+        {
+            switch (tape_->type(index_))
+            {
+                case tape_type::string_value:
+                case tape_type::bigint_value:
+                case tape_type::bigdec_value:
+                {
+                    std::string s(tape_->string(index_).data(), tape_->string(index_).length());
+                    jsoncons::detail::chars_to to_double;
+                    // to_double() throws std::invalid_argument if conversion fails
+                    return to_double(s.c_str(), s.length());
+                }
+                case tape_type::double_value:
+                    return tape_->double_value(index_);
+                case tape_type::int64_value:
+                    return static_cast<double>(tape_->int64_value(index_));
+                case tape_type::uint64_value:
+                    return static_cast<double>(tape_->uint64_value(index_));
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Not a double"));
+            }
+        }
+
+        // Refers to the source text when the string has no escapes, otherwise to the tape
+        string_view_type as_string_view() const
+        {
+            if (!is_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+            return tape_->string(index_);
+        }
+
+        // The text of a string, or the JSON text of any other value
+        std::string as_string() const
+        {
+            if (is_string())
+            {
+                string_view_type s = tape_->string(index_);
+                return std::string(s.data(), s.length());
+            }
+            return to_string();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            return as_bool();
+        }
+
+        template <class T>
+        typename std::enable_if<extension_traits::is_integer<T>::value,T>::type
+        as() const
+        {
+            return as_integer<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value,T>::type
+        as() const
+        {
+            return static_cast<T>(as_double());
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_view_type>::value,T>::type
+        as() const
+        {
+            return as_string_view();
+        }
+
+        template <class T>
+        typename std::enable_if<extension_traits::is_string<T>::value,T>::type
+        as() const
+        {
+            std::string s = as_string();
+            return T(s.data(), s.length());
+        }
+
+        // Materializes the value as a basic_json
+        template <class T>
+        typename std::enable_if<extension_traits::is_basic_json<T>::value,T>::type
+        as() const
+        {
+            json_decoder<T> decoder;
+            dump(decoder);
+            return decoder.get_result();
+        }
+
+        // Other types go through json_type_traits of a materialized basic_json
+        template <class T>
+        typename std::enable_if<!is_scalar_target<T>::value && !extension_traits::is_basic_json<T>::value,T>::type
+        as() const
+        {
+            return as<default_json_type>().template as<T>();
+        }
+
+        std::string to_string() const
+        {
+            std::string s;
+            dump(s);
+            return s;
+        }
+
+        template <class CharContainer>
+        typename std::enable_if<extension_traits::is_back_insertable_char_container<CharContainer>::value>::type
+        dump(CharContainer& cont,
+             const basic_json_encode_options<char>& options = basic_json_encode_options<char>(),
+             indenting indent = indenting::no_indent) const
+        {
+            std::error_code ec;
+            if (indent == indenting::indent)
+            {
+                basic_json_encoder<char,jsoncons::string_sink<CharContainer>> encoder(cont, options);
+                dump(encoder, ec);
+            }
+            else
+            {
+                basic_compact_json_encoder<char,jsoncons::string_sink<CharContainer>> encoder(cont, options);
+                dump(encoder, ec);
+            }
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        void dump(std::basic_ostream<char>& os,
+                  const basic_json_encode_options<char>& options = basic_json_encode_options<char>(),
+                  indenting indent = indenting::no_indent) const
+        {
+            std::error_code ec;
+            if (indent == indenting::indent)
+            {
+                basic_json_encoder<char> encoder(os, options);
+                dump(encoder, ec);
+            }
+            else
+            {
+                basic_compact_json_encoder<char> encoder(os, options);
+                dump(encoder, ec);
+            }
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        template <class CharContainer>
+        typename std::enable_if<extension_traits::is_back_insertable_char_container<CharContainer>::value>::type
+        dump_pretty(CharContainer& cont,
+                    const basic_json_encode_options<char>& options = basic_json_encode_options<char>()) const
+        {
+            dump(cont, options, indenting::indent);
+        }
+
+        void dump_pretty(std::basic_ostream<char>& os,
+                         const basic_json_encode_options<char>& options = basic_json_encode_options<char>()) const
+        {
+            dump(os, options, indenting::indent);
+        }
+
+        void dump(basic_json_visitor<char>& visitor) const
+        {
+            std::error_code ec;
+            dump(visitor, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        // Replays the value to a visitor
+        void dump(basic_json_visitor<char>& visitor, std::error_code& ec) const
+        {
+            const ser_context context;
+            const std::size_t last = tape_->next(index_);
+            std::size_t i = index_;
+            bool more = true;
+            while (i < last && more)
+            {
+                switch (tape_->type(i))
+                {
+                    case tape_type::begin_object:
+                    {
+                        std::size_t count = tape_->count(i);
+                        more = count < json_tape_type::max_count
+                            ? visitor.begin_object(count, semantic_tag::none, context, ec)
+                            : visitor.begin_object(semantic_tag::none, context, ec);
+                        break;
+                    }
+                    case tape_type::end_object:
+                        more = visitor.end_object(context, ec);
+                        break;
+                    case tape_type::begin_array:
+                    {
+                        std::size_t count = tape_->count(i);
+                        more = count < json_tape_type::max_count
+                            ? visitor.begin_array(count, semantic_tag::none, context, ec)
+                            : visitor.begin_array(semantic_tag::none, context, ec);
+                        break;
+                    }
+                    case tape_type::end_array:
+                        more = visitor.end_array(context, ec);
+                        break;
+                    case tape_type::key:
+                        more = visitor.key(tape_->string(i), context, ec);
+                        break;
+                    case tape_type::string_value:
+                        more = visitor.string_value(tape_->string(i), semantic_tag::none, context, ec);
+                        break;
+                    case tape_type::bigint_value:
+                        more = visitor.string_value(tape_->string(i), semantic_tag::bigint, context, ec);
+                        break;
+                    case tape_type::bigdec_value:
+                        more = visitor.string_value(tape_->string(i), semantic_tag::bigdec, context, ec);
+                        break;
+                    case tape_type::int64_value:
+                        more = visitor.int64_value(tape_->int64_value(i), semantic_tag::none, context, ec);
+                        ++i;
+                        break;
+                    case tape_type::uint64_value:
+                        more = visitor.uint64_value(tape_->uint64_value(i), semantic_tag::none, context, ec);
+                        ++i;
+                        break;
+                    case tape_type::double_value:
+                        more = visitor.double_value(tape_->double_value(i), semantic_tag::none, context, ec);
+                        ++i;
+                        break;
+                    case tape_type::true_value:
+                        more = visitor.bool_value(true, semantic_tag::none, context, ec);
+                        break;
+                    case tape_type::false_value:
+                        more = visitor.bool_value(false, semantic_tag::none, context, ec);
+                        break;
+                    case tape_type::null_value:
+                        more = visitor.null_value(semantic_tag::none, context, ec);
+                        break;
+                    default:
+                        JSONCONS_UNREACHABLE();
+                        break;
+                }
+                if (ec) return;
+                ++i;
+            }
+            visitor.flush();
+        }
+
+    private:
+        // Index of the key of the member named key, or of the end marker if there is none
+        std::size_t find_member(const string_view_type& key) const noexcept
+        {
+            std::size_t end = tape_->end_of(index_);
+            std::size_t i = index_ + 1;
+            while (i < end && tape_->string(i) != key)
+            {
+                i = tape_->next(i + 1);
+            }
+            return i;
+        }
+    };
+
+    template <class Allocator>
+    class basic_json_document_view<Allocator>::key_value_type
+    {
+        string_view_type key_;
+        basic_json_document_view<Allocator> value_;
+    public:
+        key_value_type(const string_view_type& key, const basic_json_document_view<Allocator>& value)
+            : key_(key), value_(value)
+        {
+        }
+
+        string_view_type key() const
+        {
+            return key_;
+        }
+
+        const basic_json_document_view<Allocator>& value() const
+        {
+            return value_;
+        }
+    };
+
+    template <class Allocator>
+    class basic_json_document_view<Allocator>::object_iterator
+    {
+        const json_tape_type* tape_;
+        std::size_t index_;
+        key_value_type current_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = key_value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const key_value_type*;
+        using reference = const key_value_type&;
+
+        object_iterator(const json_tape_type& tape, std::size_t index)
+            : tape_(std::addressof(tape)), index_(index),
+              current_(string_view_type(), basic_json_document_view<Allocator>(tape, index))
+        {
+            update();
+        }
+
+        reference operator*() const
+        {
+            return current_;
+        }
+
+        pointer operator->() const
+        {
+            return std::addressof(current_);
+        }
+
+        object_iterator& operator++()
+        {
+            index_ = tape_->next(index_ + 1);
+            update();
+            return *this;
+        }
+
+        object_iterator operator++(int)
+        {
+            object_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const object_iterator& other) const
+        {
+            return index_ == other.index_ && tape_ == other.tape_;
+        }
+
+        bool operator!=(const object_iterator& other) const
+        {
+            return !(*this == other);
+        }
+    private:
+        void update()
+        {
+            if (tape_->type(index_) == tape_type::key)
+            {
+                current_ = key_value_type(tape_->string(index_), basic_json_document_view<Allocator>(*tape_, index_ + 1));
+            }
+        }
+    };
+
+    template <class Allocator>
+    class basic_json_document_view<Allocator>::array_iterator
+    {
+        basic_json_document_view<Allocator> current_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = basic_json_document_view<Allocator>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const basic_json_document_view<Allocator>*;
+        using reference = const basic_json_document_view<Allocator>&;
+
+        array_iterator(const json_tape_type& tape, std::size_t index)
+            : current_(tape, index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return current_;
+        }
+
+        pointer operator->() const
+        {
+            return std::addressof(current_);
+        }
+
+        array_iterator& operator++()
+        {
+            current_.index_ = current_.tape_->next(current_.index_);
+            return *this;
+        }
+
+        array_iterator operator++(int)
+        {
+            array_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const array_iterator& other) const
+        {
+            return current_.index_ == other.current_.index_ && current_.tape_ == other.current_.tape_;
+        }
+
+        bool operator!=(const array_iterator& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    // basic_json_document
+    // Owns the tape of a parsed JSON text, and the text itself unless it was parsed in place
+    // from a string view.
+
+    template <class Allocator=std::allocator<char>>
+    class basic_json_document
+    {
+    public:
+        using allocator_type = Allocator;
+        using char_type = char;
+        using string_view_type = jsoncons::basic_string_view<char>;
+        using view_type = basic_json_document_view<Allocator>;
+        using json_tape_type = basic_json_tape<Allocator>;
+    private:
+        using char_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<char>;
+
+        std::vector<char,char_allocator_type> buffer_;
+        json_tape_type tape_;
+
+    public:
+        explicit basic_json_document(const Allocator& alloc = Allocator())
+            : buffer_(alloc), tape_(alloc)
+        {
+        }
+
+        // A copy would refer to the text of the original
+        basic_json_document(const basic_json_document&) = delete;
+        basic_json_document(basic_json_document&&) = default;
+
+        basic_json_document& operator=(const basic_json_document&) = delete;
+        basic_json_document& operator=(basic_json_document&&) = default;
+
+        // Parses the text in place, the text must outlive the document
+        static basic_json_document parse(const string_view_type& source,
+                                         const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                         const Allocator& alloc = Allocator())
+        {
+            basic_json_document doc(alloc);
+            doc.build(source.data(), source.length(), options);
+            return doc;
+        }
+
+        static basic_json_document parse(const char_type* source,
+                                         const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                         const Allocator& alloc = Allocator())
+        {
+            return parse(string_view_type(source), options, alloc);
+        }
+
+        // Parses a copy of a temporary string
+        static basic_json_document parse(std::string&& source,
+                                         const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                         const Allocator& alloc = Allocator())
+        {
+            basic_json_document doc(alloc);
+            doc.buffer_.assign(source.begin(), source.end());
+            doc.build(doc.buffer_.data(), doc.buffer_.size(), options);
+            return doc;
+        }
+
+        static basic_json_document parse(std::basic_istream<char>& is,
+                                         const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                         const Allocator& alloc = Allocator())
+        {
+            basic_json_document doc(alloc);
+            doc.buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+            if (is.bad())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error));
+            }
+            doc.build(doc.buffer_.data(), doc.buffer_.size(), options);
+            return doc;
+        }
+
+        view_type root() const
+        {
+            return view_type(tape_, 0);
+        }
+
+        const json_tape_type& tape() const
+        {
+            return tape_;
+        }
+
+    private:
+        void build(const char* data, std::size_t length, const basic_json_decode_options<char>& options)
+        {
+            // Skip a UTF-8 byte order mark
+            if (length >= 3 && static_cast<uint8_t>(data[0]) == 0xEF && static_cast<uint8_t>(data[1]) == 0xBB &&
+                static_cast<uint8_t>(data[2]) == 0xBF)
+            {
+                data += 3;
+                length -= 3;
+            }
+
+            std::error_code ec;
+            basic_json_tape_builder<Allocator> builder(options, buffer_.get_allocator());
+            builder.build(data, length, tape_, ec);
+            if (!ec)
+            {
+                return;
+            }
+
+            // The text is not strict JSON. basic_json_parser reports the error, or, if the
+            // text is accepted (comments, recoverable errors), writes it out as JSON for the tape.
+            std::vector<char,char_allocator_type> text(buffer_.get_allocator());
+            {
+                basic_compact_json_encoder<char,jsoncons::string_sink<std::vector<char,char_allocator_type>>> encoder(text);
+                basic_json_parser<char,Allocator> parser(options, options.err_handler(), buffer_.get_allocator());
+                parser.update(data, length);
+                ec = std::error_code();
+                while (!ec && !parser.stopped())
+                {
+                    bool eof = parser.source_exhausted();
+                    parser.parse_some(encoder, ec);
+                    if (!ec && eof)
+                    {
+                        if (parser.enter())
+                        {
+                            break;
+                        }
+                        else if (!parser.accept())
+                        {
+                            ec = json_errc::unexpected_eof;
+                        }
+                    }
+                }
+                if (!ec)
+                {
+                    parser.check_done(ec);
+                }
+                if (ec)
+                {
+                    JSONCONS_THROW(ser_error(ec, parser.line(), parser.column()));
+                }
+            }
+            buffer_.swap(text);
+            builder.build(buffer_.data(), buffer_.size(), tape_, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+    };
+
+    using json_document = basic_json_document<std::allocator<char>>;
+    using json_document_view = basic_json_document_view<std::allocator<char>>;
+
+} // namespace jsoncons
+
+#endif
@@ -873,6 +873,43 @@ namespace detail {
             return true;
         }
 
+        // True unless the options ask for the number to be formatted
+        bool writes_number_text(const string_view_type& text) const
+        {
+            if (options_.float_format() != float_chars_format::general || options_.precision() != 0)
+            {
+                return false;
+            }
+            return options_.bigint_format() == bigint_chars_format::number || 
+                   !jsoncons::detail::is_bigint_text(text.data(), text.size());
+        }
+
+        bool visit_number(const string_view_type& text, 
+                          semantic_tag tag,
+                          const ser_context& context,
+                          std::error_code& ec) override
+        {
+            if (!writes_number_text(text))
+            {
+                return jsoncons::detail::number_text_value(text, tag, *this, context, ec);
+            }
+            if (!stack_.empty()) 
+            {
+                if (stack_.back().is_array())
+                {
+                    begin_scalar_value();
+                }
+                if (!stack_.back().is_multi_line() && column_ >= options_.line_length_limit())
+                {
+                    break_line();
+                }
+            }
+            sink_.append(text.data(), text.size());
+            column_ += text.size();
+            end_value();
+            return true;
+        }
+
         bool visit_uint64(uint64_t value, 
                              semantic_tag, 
                              const ser_context&,
@@ -1513,6 +1550,38 @@ namespace detail {
             return true;
         }
 
+        // True unless the options ask for the number to be formatted
+        bool writes_number_text(const string_view_type& text) const
+        {
+            if (options_.float_format() != float_chars_format::general || options_.precision() != 0)
+            {
+                return false;
+            }
+            return options_.bigint_format() == bigint_chars_format::number || 
+                   !jsoncons::detail::is_bigint_text(text.data(), text.size());
+        }
+
+        bool visit_number(const string_view_type& text, 
+                          semantic_tag tag,
+                          const ser_context& context,
+                          std::error_code& ec) override
+        {
+            if (!writes_number_text(text))
+            {
+                return jsoncons::detail::number_text_value(text, tag, *this, context, ec);
+            }
+            if (!stack_.empty() && stack_.back().is_array() && stack_.back().count() > 0)
+            {
+                sink_.push_back(',');
+            }
+            sink_.append(text.data(), text.size());
+            if (!stack_.empty())
+            {
+                stack_.back().increment_count();
+            }
+            return true;
+        }
+
         bool visit_uint64(uint64_t value, 
                              semantic_tag, 
                              const ser_context&,
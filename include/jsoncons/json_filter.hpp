@@ -153,6 +153,11 @@ private:
         return destination_->double_value(value, tag, context, ec);
     }
 
+    bool visit_number(const string_view_type& text, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        return destination_->number_value(text, tag, context, ec);
+    }
+
     bool visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
     {
         return destination_->bool_value(value, tag, context, ec);
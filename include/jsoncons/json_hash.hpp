@@ -0,0 +1,229 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_HASH_HPP
+#define JSONCONS_JSON_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <functional> // std::hash
+#include <memory> // std::addressof
+#include <unordered_map>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/detail/hash.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // Numbers that compare equal hash equal: integers are hashed as the double they compare as,
+    // and all zeros and all NaNs hash the same
+    inline uint64_t hash_number(double val) noexcept
+    {
+        if (val == 0)
+        {
+            val = 0;
+        }
+        uint64_t bits;
+        if (val != val)
+        {
+            bits = 0x7ff8000000000000ULL;
+        }
+        else
+        {
+            std::memcpy(&bits, &val, sizeof(double));
+        }
+        return hash_mix(bits ^ 0x3c6ef372fe94f82bULL);
+    }
+
+    // The structural hash of j, child_hash gives the hash of an element or member value
+    template <class Json,class ChildHash>
+    std::size_t json_hash_with(const Json& j, ChildHash child_hash)
+    {
+        const uint64_t k = 0x9e3779b97f4a7c15ULL;
+
+        switch (j.type())
+        {
+            case json_type::null_value:
+                return static_cast<std::size_t>(hash_mix(0x6a09e667f3bcc908ULL));
+            case json_type::bool_value:
+                return static_cast<std::size_t>(hash_mix(j.template as<bool>() ? 0xbb67ae8584caa73bULL : 0xa54ff53a5f1d36f1ULL));
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::half_value:
+            case json_type::double_value:
+                return static_cast<std::size_t>(hash_number(j.template as<double>()));
+            case json_type::string_value:
+            {
+                // Big numbers by their text too, since they are equal to strings with the same text
+                auto sv = j.as_string_view();
+                return hash_chars(sv.data(), sv.size());
+            }
+            case json_type::byte_string_value:
+            {
+                auto bytes = j.as_byte_string_view();
+                return static_cast<std::size_t>(hash_mix(hash_chars(bytes.data(), bytes.size()) ^ 0x510e527fade682d1ULL));
+            }
+            case json_type::array_value:
+            {
+                // Elements in order
+                uint64_t h = 0x9b05688c2b3e6c1fULL;
+                if (j.storage_kind() != json_storage_kind::array_value)
+                {
+                    // A packed array, or a value that refers to an array, read without building the 
+                    // elements of a packed array as basic_json values
+                    for (const auto& item : j.array_value_range())
+                    {
+                        h = (h ^ child_hash(item))*k;
+                    }
+                }
+                else
+                {
+                    for (const auto& item : j.array_range())
+                    {
+                        h = (h ^ child_hash(item))*k;
+                    }
+                }
+                return static_cast<std::size_t>(hash_mix(h ^ j.size()));
+            }
+            case json_type::object_value:
+            {
+                // Members in any order, so that the hash does not depend on how an object orders its members
+                uint64_t h = 0x1f83d9abfb41bd6bULL;
+                for (const auto& member : j.object_range())
+                {
+                    const auto& key = member.key();
+                    h += hash_mix(hash_chars(key.data(), key.size())*k + child_hash(member.value()));
+                }
+                return static_cast<std::size_t>(hash_mix(h ^ j.size()));
+            }
+            default:
+                return 0;
+        }
+    }
+
+} // namespace detail
+
+    // json_hash
+    // A structural hash that agrees with operator==: values that compare equal hash equal. The hash of an
+    // object does not depend on the order of its members.
+
+    template <class Json>
+    std::size_t json_hash(const Json& j)
+    {
+        return detail::json_hash_with(j, [](const Json& item) -> std::size_t {return json_hash(item);});
+    }
+
+    // json_hash_cache
+    // Remembers the hashes of the arrays and objects it has hashed, by address, so that hashing a value
+    // again, or any array or object inside it, takes constant time. The values must not be modified, moved
+    // or destroyed while the cache is in use.
+
+    template <class Json>
+    class json_hash_cache
+    {
+        std::unordered_map<const Json*,std::size_t> hashes_;
+    public:
+        json_hash_cache() = default;
+
+        std::size_t hash(const Json& j)
+        {
+            if (!(j.is_array() || j.is_object()))
+            {
+                return json_hash(j);
+            }
+            if (j.storage_kind() == json_storage_kind::json_const_pointer)
+            {
+                // Not remembered, a value that refers to another may be a temporary
+                return detail::json_hash_with(j, [this](const Json& item) -> std::size_t {return hash(item);});
+            }
+            auto it = hashes_.find(std::addressof(j));
+            if (it != hashes_.end())
+            {
+                return it->second;
+            }
+            std::size_t h = detail::json_hash_with(j, [this](const Json& item) -> std::size_t {return hash(item);});
+            hashes_.emplace(std::addressof(j), h);
+            return h;
+        }
+
+        // Equivalent to a == b. Arrays and objects of different sizes or hashes are
+        // found to differ without comparing their elements.
+        bool deep_equal(const Json& a, const Json& b)
+        {
+            if (std::addressof(a) == std::addressof(b))
+            {
+                return true;
+            }
+            if (a.is_array() && b.is_array())
+            {
+                if (a.size() != b.size() || hash(a) != hash(b))
+                {
+                    return false;
+                }
+                if (a.storage_kind() != json_storage_kind::array_value || 
+                    b.storage_kind() != json_storage_kind::array_value)
+                {
+                    // Compares the elements of a packed array in place
+                    return a == b;
+                }
+                auto it = a.array_range().begin();
+                for (const auto& item : b.array_range())
+                {
+                    if (!deep_equal(*it, item))
+                    {
+                        return false;
+                    }
+                    ++it;
+                }
+                return true;
+            }
+            if (a.is_object() && b.is_object())
+            {
+                if (a.size() != b.size() || hash(a) != hash(b))
+                {
+                    return false;
+                }
+                auto it = a.object_range().begin();
+                for (const auto& member : b.object_range())
+                {
+                    if (!(it->key() == member.key() && deep_equal(it->value(), member.value())))
+                    {
+                        return false;
+                    }
+                    ++it;
+                }
+                return true;
+            }
+            return a == b;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return hashes_.size();
+        }
+
+        void clear() noexcept
+        {
+            hashes_.clear();
+        }
+    };
+
+} // namespace jsoncons
+
+namespace std {
+    template <class CharT,class Policy,class Allocator>
+    struct hash<jsoncons::basic_json<CharT,Policy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,Policy,Allocator>& j) const
+        {
+            return jsoncons::json_hash(j);
+        }
+    };
+} // namespace std
+
+#endif
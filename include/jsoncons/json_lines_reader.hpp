@@ -0,0 +1,295 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <algorithm> // std::max
+#include <cstddef>
+#include <cstring> // std::memchr
+#include <memory> // std::allocator, std::unique_ptr
+#include <system_error>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/detail/parallel_chunks.hpp>
+
+namespace jsoncons {
+
+    // basic_json_lines_reader
+    // Reads JSON Lines (one JSON text per line) from a buffer held in memory. The buffer is split into
+    // chunks of whole lines that are parsed on worker threads, and the results are handed back in input
+    // order on the calling thread. At most max_chunks_in_flight chunks are parsed or waiting at a time.
+
+    template <class Json,class TempAllocator=std::allocator<char>>
+    class basic_json_lines_reader
+    {
+    public:
+        using value_type = Json;
+        using char_type = char;
+        using string_view_type = jsoncons::basic_string_view<char>;
+
+        static constexpr std::size_t default_chunk_size = 65536;
+    private:
+        struct chunk
+        {
+            const char* first;
+            const char* last;
+            std::vector<Json> values;
+            std::size_t line_count;
+            std::error_code ec;
+            std::size_t error_line;
+            std::size_t error_column;
+
+            chunk()
+                : first(nullptr), last(nullptr), line_count(0), error_line(0), error_column(0)
+            {
+            }
+        };
+
+        class chunk_parser
+        {
+            basic_json_parser<char,TempAllocator> parser_;
+            json_decoder<Json,TempAllocator> decoder_;
+        public:
+            chunk_parser(const basic_json_decode_options<char>& options, const TempAllocator& alloc)
+                : parser_(options, options.err_handler(), alloc), decoder_(temp_allocator_arg, alloc)
+            {
+            }
+
+            void operator()(chunk& c)
+            {
+                parse_chunk(c, parser_, decoder_);
+            }
+        };
+
+        string_view_type source_;
+        basic_json_decode_options<char> options_;
+        TempAllocator alloc_;
+        std::size_t num_threads_;
+        std::size_t chunk_size_;
+        std::size_t max_chunks_in_flight_;
+        std::size_t line_;
+        std::size_t column_;
+
+        // Noncopyable and nonmoveable
+        basic_json_lines_reader(const basic_json_lines_reader&) = delete;
+        basic_json_lines_reader& operator=(const basic_json_lines_reader&) = delete;
+
+    public:
+        // num_threads 0 means one thread per hardware thread
+        basic_json_lines_reader(const string_view_type& source,
+                                std::size_t num_threads = 0,
+                                const TempAllocator& alloc = TempAllocator())
+            : basic_json_lines_reader(source, basic_json_decode_options<char>(), num_threads, alloc)
+        {
+        }
+
+        basic_json_lines_reader(const string_view_type& source,
+                                const basic_json_decode_options<char>& options,
+                                std::size_t num_threads = 0,
+                                const TempAllocator& alloc = TempAllocator())
+            : source_(source),
+              options_(options),
+              alloc_(alloc),
+              num_threads_(num_threads != 0 ? num_threads : (std::max)(std::size_t(1), static_cast<std::size_t>(std::thread::hardware_concurrency()))),
+              chunk_size_(default_chunk_size),
+              max_chunks_in_flight_(2*num_threads_),
+              line_(0),
+              column_(0)
+        {
+        }
+
+        std::size_t num_threads() const
+        {
+            return num_threads_;
+        }
+
+        std::size_t chunk_size() const
+        {
+            return chunk_size_;
+        }
+
+        // Chunks end at the first line break at or after this many bytes
+        basic_json_lines_reader& chunk_size(std::size_t value)
+        {
+            chunk_size_ = value != 0 ? value : 1;
+            return *this;
+        }
+
+        std::size_t max_chunks_in_flight() const
+        {
+            return max_chunks_in_flight_;
+        }
+
+        basic_json_lines_reader& max_chunks_in_flight(std::size_t value)
+        {
+            max_chunks_in_flight_ = value != 0 ? value : 1;
+            return *this;
+        }
+
+        // Number of lines read, or the line of the error after a failed read
+        std::size_t line() const
+        {
+            return line_;
+        }
+
+        std::size_t column() const
+        {
+            return column_;
+        }
+
+        // Calls callback(Json&&) for the value on each non-blank line, in input order, on the calling thread
+        template <class Callback>
+        void read(Callback callback)
+        {
+            std::error_code ec;
+            read(callback, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line_,column_));
+            }
+        }
+
+        template <class Callback>
+        void read(Callback callback, std::error_code& ec)
+        {
+            line_ = 0;
+            column_ = 0;
+
+            const char* next = source_.data();
+            const char* end = source_.data() + source_.size();
+
+            jsoncons::detail::parse_chunks_in_order<chunk>(num_threads_, max_chunks_in_flight_,
+                [this]() 
+                {
+                    return std::unique_ptr<chunk_parser>(new chunk_parser(options_, alloc_));
+                },
+                [this,&next,end](chunk& c) -> bool
+                {
+                    if (next == end)
+                    {
+                        return false;
+                    }
+                    c.first = next;
+                    next = end_of_chunk(next, end);
+                    c.last = next;
+                    return true;
+                },
+                [this,&callback,&ec](chunk& c) -> bool
+                {
+                    if (c.ec)
+                    {
+                        ec = c.ec;
+                        line_ += c.error_line;
+                        column_ = c.error_column;
+                        return false;
+                    }
+                    line_ += c.line_count;
+                    for (auto& val : c.values)
+                    {
+                        callback(std::move(val));
+                    }
+                    c.values.clear();
+                    return true;
+                });
+        }
+
+    private:
+        const char* end_of_chunk(const char* first, const char* end) const
+        {
+            if (static_cast<std::size_t>(end - first) <= chunk_size_)
+            {
+                return end;
+            }
+            const char* p = static_cast<const char*>(std::memchr(first + chunk_size_ - 1, '\n', static_cast<std::size_t>(end - first) - (chunk_size_ - 1)));
+            return p != nullptr ? p + 1 : end;
+        }
+
+        static bool is_blank(const char* first, const char* last)
+        {
+            for (; first != last; ++first)
+            {
+                if (!(*first == ' ' || *first == '\t' || *first == '\r'))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static void parse_chunk(chunk& c, basic_json_parser<char,TempAllocator>& parser, json_decoder<Json,TempAllocator>& decoder)
+        {
+            c.values.clear();
+            c.line_count = 0;
+            c.ec = std::error_code();
+
+            const char* p = c.first;
+            while (p != c.last)
+            {
+                const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(c.last - p)));
+                const char* eol = nl != nullptr ? nl : c.last;
+                ++c.line_count;
+                if (!is_blank(p, eol))
+                {
+                    std::error_code ec;
+                    parser.reinitialize();
+                    parser.update(p, static_cast<std::size_t>(eol - p));
+                    decoder.reset();
+                    while (!parser.stopped())
+                    {
+                        bool eof = parser.source_exhausted();
+                        parser.parse_some(decoder, ec);
+                        if (ec)
+                        {
+                            break;
+                        }
+                        if (eof)
+                        {
+                            if (parser.enter())
+                            {
+                                break;
+                            }
+                            else if (!parser.accept())
+                            {
+                                ec = json_errc::unexpected_eof;
+                                break;
+                            }
+                        }
+                    }
+                    if (!ec)
+                    {
+                        parser.check_done(ec);
+                    }
+                    if (ec)
+                    {
+                        c.ec = ec;
+                        c.error_line = c.line_count;
+                        c.error_column = parser.column();
+                        return;
+                    }
+                    c.values.push_back(decoder.get_result());
+                }
+                p = nl != nullptr ? nl + 1 : c.last;
+            }
+        }
+    };
+
+    template <class Json,class TempAllocator>
+    constexpr std::size_t basic_json_lines_reader<Json,TempAllocator>::default_chunk_size;
+
+    using json_lines_reader = basic_json_lines_reader<json>;
+    using ojson_lines_reader = basic_json_lines_reader<ojson>;
+
+} // namespace jsoncons
+
+#endif
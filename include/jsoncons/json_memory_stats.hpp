@@ -0,0 +1,45 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_MEMORY_STATS_HPP
+#define JSONCONS_JSON_MEMORY_STATS_HPP
+
+#include <cstddef>
+
+namespace jsoncons {
+
+    // json_memory_stats
+    // The memory owned by a basic_json value and the values it contains, by storage kind.
+    // Counts are numbers of values, bytes are heap bytes unless noted otherwise.
+
+    struct json_memory_stats
+    {
+        std::size_t short_strings = 0;
+        std::size_t short_string_bytes = 0; // characters kept inside the value, no heap bytes
+        std::size_t long_strings = 0;
+        std::size_t long_string_bytes = 0;
+        std::size_t byte_strings = 0;
+        std::size_t byte_string_bytes = 0;
+        std::size_t raw_numbers = 0; // number texts kept by lazy_number
+        std::size_t raw_number_bytes = 0; // texts too long to keep inside the value
+        std::size_t arrays = 0;
+        std::size_t array_bytes = 0; // arrays and their element buffers
+        std::size_t packed_arrays = 0;
+        std::size_t packed_array_bytes = 0;
+        std::size_t objects = 0;
+        std::size_t object_bytes = 0; // objects, their member buffers and indexes
+        std::size_t key_bytes = 0; // object member names
+        std::size_t slack_bytes = 0; // unused capacity of element and member buffers, part of array_bytes and object_bytes
+
+        std::size_t heap_bytes() const noexcept
+        {
+            return long_string_bytes + byte_string_bytes + raw_number_bytes + array_bytes + packed_array_bytes + object_bytes + key_bytes;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
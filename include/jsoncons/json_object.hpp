@@ -17,13 +17,16 @@
 #include <initializer_list>
 #include <iterator> // std::iterator_traits
 #include <memory> // std::allocator
+#include <new> // std::bad_alloc
 #include <utility> // std::move
 #include <cassert> // assert
+#include <functional> // std::less
 #include <unordered_set>
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
 #include <jsoncons/json_array.hpp>
+#include <jsoncons/detail/hash.hpp>
 
 namespace jsoncons {
 
@@ -64,6 +67,50 @@ namespace jsoncons {
         explicit sorted_unique_range_tag() = default; 
     };
 
+namespace detail {
+
+    template <class String>
+    using string_allocated_bytes_t = decltype(std::declval<const String&>().allocated_bytes());
+
+    // Bytes allocated by s for its characters, zero if they are kept inside the string object
+    template <class String>
+    typename std::enable_if<extension_traits::is_detected<string_allocated_bytes_t,String>::value,std::size_t>::type
+    string_allocated_bytes(const String& s) noexcept
+    {
+        return s.allocated_bytes();
+    }
+
+    template <class String>
+    typename std::enable_if<!extension_traits::is_detected<string_allocated_bytes_t,String>::value,std::size_t>::type
+    string_allocated_bytes(const String& s) noexcept
+    {
+        const char* p = reinterpret_cast<const char*>(s.data());
+        const char* first = reinterpret_cast<const char*>(std::addressof(s));
+        std::less<const char*> less;
+        bool is_inside = !less(p, first) && less(p, first + sizeof(String));
+        return is_inside ? 0 : (s.capacity() + 1)*sizeof(typename String::value_type);
+    }
+
+    template <class String>
+    using string_use_count_t = decltype(std::declval<const String&>().use_count());
+
+    // True if s shares its characters with other strings, as basic_shared_key does
+    template <class String>
+    typename std::enable_if<extension_traits::is_detected<string_use_count_t,String>::value,bool>::type
+    is_shared_string(const String& s) noexcept
+    {
+        return s.use_count() > 1;
+    }
+
+    template <class String>
+    typename std::enable_if<!extension_traits::is_detected<string_use_count_t,String>::value,bool>::type
+    is_shared_string(const String&) noexcept
+    {
+        return false;
+    }
+
+} // namespace detail
+
     // key_value
 
     template <class KeyT, class ValueT>
@@ -382,6 +429,18 @@ namespace jsoncons {
             return members_.empty();
         }
 
+        // True if the members are shared with a copy, see copy_on_write_policy
+        bool is_shared() const noexcept
+        {
+            return jsoncons::detail::is_shared_container(members_);
+        }
+
+        // Bytes allocated for the members, not including memory the members own
+        std::size_t allocated_bytes() const noexcept
+        {
+            return jsoncons::detail::container_allocated_bytes(members_);
+        }
+
         void swap(sorted_json_object& other) noexcept
         {
             members_.swap(other.members_);
@@ -415,6 +474,10 @@ namespace jsoncons {
 
         void shrink_to_fit() 
         {
+            if (is_shared())
+            {
+                return;
+            }
             for (std::size_t i = 0; i < members_.size(); ++i)
             {
                 members_[i].shrink_to_fit();
@@ -505,15 +568,14 @@ namespace jsoncons {
                 auto last = first + count;
 
                 std::sort(first, last, compare);
-                members_.emplace_back(key_type(first->name,get_allocator()), std::move(first->value));
-                auto prev_it = first;
+                members_.emplace_back(key_type(std::move(first->name),get_allocator()), std::move(first->value));
+                const key_value_container_type& members = members_;
                 for (auto it = first+1; it != last; ++it)
                 {
-                    if (it->name != prev_it->name)
+                    if (it->name != members.back().key())
                     {
-                        members_.emplace_back(key_type(it->name,get_allocator()), std::move(it->value));
+                        members_.emplace_back(key_type(std::move(it->name),get_allocator()), std::move(it->value));
                     }
-                    ++prev_it;
                 }
             }
         }
@@ -947,7 +1009,8 @@ namespace jsoncons {
 
         void flatten_and_destroy() noexcept
         {
-            if (!members_.empty())
+            // Members shared with a copy are left to the copy
+            if (!members_.empty() && !is_shared())
             {
                 json_array<Json> temp(get_allocator());
 
@@ -981,26 +1044,18 @@ namespace jsoncons {
         using string_view_type = typename Json::string_view_type;
         using key_value_type = key_value<KeyT,Json>;
     private:
-        struct MyHash
-        {
-            std::uintmax_t operator()(const key_type& s) const noexcept
-            {
-                const int p = 31;
-                const int m = static_cast<int>(1e9) + 9;
-                std::uintmax_t hash_value = 0;
-                std::uintmax_t p_pow = 1;
-                for (char_type c : s) {
-                    hash_value = (hash_value + (c - 'a' + 1) * p_pow) % m;
-                    p_pow = (p_pow * p) % m;
-                }
-                return hash_value;   
-            }
-        };
-
         using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;
         using key_value_container_type = SequenceContainer<key_value_type,key_value_allocator_type>;
+        using index_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t>;
+        using index_type = std::vector<std::size_t,index_allocator_type>;
+
+        // Objects with fewer members are searched linearly
+        static constexpr std::size_t index_threshold = 32;
 
         key_value_container_type members_;
+        // Open addressing hash index into members_, a slot holds a position plus one, or zero if empty.
+        // It is built once the object reaches index_threshold members, and is empty before then.
+        index_type index_;
 
         struct Comp
         {
@@ -1025,45 +1080,51 @@ namespace jsoncons {
         }
         order_preserving_json_object(const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
-              members_(key_value_allocator_type(alloc))
+              members_(key_value_allocator_type(alloc)),
+              index_(index_allocator_type(alloc))
         {
         }
 
         order_preserving_json_object(const order_preserving_json_object& val)
             : allocator_holder<allocator_type>(val.get_allocator()), 
-              members_(val.members_)
+              members_(val.members_),
+              index_(val.index_)
         {
         }
 
         order_preserving_json_object(order_preserving_json_object&& val,const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
-              members_(std::move(val.members_),key_value_allocator_type(alloc))
+              members_(std::move(val.members_),key_value_allocator_type(alloc)),
+              index_(std::move(val.index_),index_allocator_type(alloc))
         {
+            val.index_.clear();
         }
 
         order_preserving_json_object(order_preserving_json_object&& val) noexcept
             : allocator_holder<allocator_type>(val.get_allocator()), 
-              members_(std::move(val.members_))
+              members_(std::move(val.members_)),
+              index_(std::move(val.index_))
         {
+            val.index_.clear();
         }
 
         order_preserving_json_object(const order_preserving_json_object& val, const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
-              members_(val.members_,key_value_allocator_type(alloc))
+              members_(val.members_,key_value_allocator_type(alloc)),
+              index_(val.index_,index_allocator_type(alloc))
         {
         }
 
         template<class InputIt>
         order_preserving_json_object(InputIt first, InputIt last)
         {
-            std::unordered_set<key_type,MyHash> keys;
             for (auto it = first; it != last; ++it)
             {
                 auto kv = get_key_value<KeyT,Json>()(*it);
-                if (keys.find(kv.key()) == keys.end())
+                if (find(kv.key()) == members_.end())
                 {
-                    keys.emplace(kv.key());
                     members_.emplace_back(std::move(kv));
+                    update_index();
                 }
             }
         }
@@ -1072,16 +1133,16 @@ namespace jsoncons {
         order_preserving_json_object(InputIt first, InputIt last, 
                     const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
-              members_(key_value_allocator_type(alloc))
+              members_(key_value_allocator_type(alloc)),
+              index_(index_allocator_type(alloc))
         {
-            std::unordered_set<key_type,MyHash> keys;
             for (auto it = first; it != last; ++it)
             {
                 auto kv = get_key_value<KeyT,Json>()(*it);
-                if (keys.find(kv.key()) == keys.end())
+                if (find(kv.key()) == members_.end())
                 {
-                    keys.emplace(kv.key());
                     members_.emplace_back(std::move(kv));
+                    update_index();
                 }
             }
         }
@@ -1113,12 +1174,14 @@ namespace jsoncons {
         {
             allocator_holder<allocator_type>::operator=(val.get_allocator());
             members_ = val.members_;
+            index_ = val.index_;
             return *this;
         }
 
         void swap(order_preserving_json_object& other) noexcept
         {
             members_.swap(other.members_);
+            index_.swap(other.index_);
         }
 
         bool empty() const
@@ -1126,6 +1189,18 @@ namespace jsoncons {
             return members_.empty();
         }
 
+        // True if the members are shared with a copy, see copy_on_write_policy
+        bool is_shared() const noexcept
+        {
+            return jsoncons::detail::is_shared_container(members_);
+        }
+
+        // Bytes allocated for the members and the index, not including memory the members own
+        std::size_t allocated_bytes() const noexcept
+        {
+            return jsoncons::detail::container_allocated_bytes(members_) + index_.capacity()*sizeof(std::size_t);
+        }
+
         iterator begin()
         {
             return members_.begin();
@@ -1153,15 +1228,21 @@ namespace jsoncons {
         void clear() 
         {
             members_.clear();
+            index_.clear();
         }
 
         void shrink_to_fit() 
         {
+            if (is_shared())
+            {
+                return;
+            }
             for (std::size_t i = 0; i < members_.size(); ++i)
             {
                 members_[i].shrink_to_fit();
             }
             members_.shrink_to_fit();
+            index_.shrink_to_fit();
         }
 
         void reserve(std::size_t n) {members_.reserve(n);}
@@ -1186,6 +1267,10 @@ namespace jsoncons {
 
         iterator find(const string_view_type& name) noexcept
         {
+            if (!index_.empty())
+            {
+                return members_.begin() + index_find(name);
+            }
             bool found = false;
             auto it = members_.begin();
             while (!found && it != members_.end())
@@ -1204,6 +1289,10 @@ namespace jsoncons {
 
         const_iterator find(const string_view_type& name) const noexcept
         {
+            if (!index_.empty())
+            {
+                return members_.begin() + index_find(name);
+            }
             bool found = false;
             auto it = members_.begin();
             while (!found && it != members_.end())
@@ -1226,10 +1315,12 @@ namespace jsoncons {
             {
     #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
                 iterator it = members_.begin() + (pos - members_.begin());
-                return members_.erase(it);
+                it = members_.erase(it);
     #else
-                return members_.erase(pos);
+                iterator it = members_.erase(pos);
     #endif
+                rebuild_index();
+                return it;
             }
             else
             {
@@ -1248,10 +1339,12 @@ namespace jsoncons {
     #if defined(JSONCONS_NO_VECTOR_ERASE_TAKES_CONST_ITERATOR)
                 iterator it1 = members_.begin() + (first - members_.begin());
                 iterator it2 = members_.begin() + (last - members_.begin());
-                return members_.erase(it1,it2);
+                iterator it = members_.erase(it1,it2);
     #else
-                return members_.erase(first,last);
+                iterator it = members_.erase(first,last);
     #endif
+                rebuild_index();
+                return it;
             }
             else
             {
@@ -1270,6 +1363,7 @@ namespace jsoncons {
     #else
                 members_.erase(pos);
     #endif
+                rebuild_index();
             }
         }
 
@@ -1318,13 +1412,14 @@ namespace jsoncons {
                 {
                     members_.emplace_back(std::move(it->name), std::move(it->value));
                 }
+                rebuild_index();
             }
         }
 
         template<class InputIt>
         void insert(InputIt first, InputIt last)
         {
-            std::unordered_set<key_type,MyHash> keys;
+            std::unordered_set<key_type,jsoncons::detail::string_hash> keys;
             for (auto it = first; it != last; ++it)
             {
                 key_type key{it->first, get_allocator()};
@@ -1334,6 +1429,7 @@ namespace jsoncons {
                     members_.emplace_back(std::move(key), it->second);
                 }
             }
+            rebuild_index();
         }
 
         template<class InputIt>
@@ -1343,6 +1439,7 @@ namespace jsoncons {
             {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*it));
             }
+            rebuild_index();
         }
    
         template <class T, class A=allocator_type>
@@ -1353,6 +1450,7 @@ namespace jsoncons {
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
+                update_index();
                 auto pos = members_.begin() + (members_.size() - 1);
                 return std::make_pair(pos, true);
             }
@@ -1371,6 +1469,7 @@ namespace jsoncons {
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), std::forward<T>(value));
+                update_index();
                 auto pos = members_.begin() + (members_.size()-1);
                 return std::make_pair(pos,true);
             }
@@ -1396,6 +1495,7 @@ namespace jsoncons {
                 if (it == members_.end())
                 {
                     members_.emplace_back(key_type(key.begin(), key.end()), std::forward<T>(value));
+                    update_index();
                     auto pos = members_.begin() + (members_.size() - 1);
                     return pos;
                 }
@@ -1422,6 +1522,7 @@ namespace jsoncons {
                 if (it == members_.end())
                 {
                     members_.emplace_back(key_type(key.begin(),key.end(),get_allocator()), std::forward<T>(value));
+                    update_index();
                     auto pos = members_.begin() + (members_.size()-1);
                     return pos;
                 }
@@ -1576,6 +1677,7 @@ namespace jsoncons {
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
+                update_index();
                 auto pos = members_.begin() + (members_.size()-1);
                 return std::make_pair(pos,true);
             }
@@ -1594,6 +1696,7 @@ namespace jsoncons {
             {
                 members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
                     std::forward<Args>(args)...);
+                update_index();
                 auto pos = members_.begin() + members_.size();
                 return std::make_pair(pos,true);
             }
@@ -1619,6 +1722,7 @@ namespace jsoncons {
                 {
                     members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
                         std::forward<Args>(args)...);
+                    update_index();
                     auto pos = members_.begin() + members_.size();
                     return pos;
                 }
@@ -1645,6 +1749,7 @@ namespace jsoncons {
                 {
                     members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
                         std::forward<Args>(args)...);
+                    update_index();
                     auto pos = members_.begin() + members_.size();
                     return pos;
                 }
@@ -1668,6 +1773,10 @@ namespace jsoncons {
 
         iterator find(iterator hint, const string_view_type& name) noexcept
         {
+            if (!index_.empty())
+            {
+                return find(name);
+            }
             bool found = false;
             auto it = hint;
             while (!found && it != members_.end())
@@ -1684,9 +1793,81 @@ namespace jsoncons {
             return found ? it : find(name);
         }
 
+        // Position of the member named name, or size() if there is none
+        std::size_t index_find(const string_view_type& name) const noexcept
+        {
+            std::size_t mask = index_.size() - 1;
+            std::size_t slot = jsoncons::detail::hash_chars(name.data(), name.size()) & mask;
+            while (index_[slot] != 0)
+            {
+                std::size_t pos = index_[slot] - 1;
+                if (members_[pos].key() == name)
+                {
+                    return pos;
+                }
+                slot = (slot + 1) & mask;
+            }
+            return members_.size();
+        }
+
+        void index_insert(std::size_t pos) noexcept
+        {
+            const key_value_container_type& members = members_;
+            const key_type& key = members[pos].key();
+            std::size_t mask = index_.size() - 1;
+            std::size_t slot = jsoncons::detail::hash_chars(key.data(), key.size()) & mask;
+            while (index_[slot] != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+            index_[slot] = pos + 1;
+        }
+
+        // Called after a member has been appended
+        void update_index()
+        {
+            if (index_.empty() ? members_.size() >= index_threshold : members_.size()*2 > index_.size())
+            {
+                rebuild_index();
+            }
+            else if (!index_.empty())
+            {
+                index_insert(members_.size() - 1);
+            }
+        }
+
+        // Called after members have been removed or reordered, keeps the load factor at most one half
+        void rebuild_index()
+        {
+            index_.clear();
+            if (members_.size() >= index_threshold)
+            {
+                std::size_t capacity = 64;
+                while (capacity < members_.size()*2)
+                {
+                    capacity *= 2;
+                }
+                // An empty index, left if allocation fails, falls back to a linear search
+                JSONCONS_TRY
+                {
+                    index_.resize(capacity, 0);
+                }
+                JSONCONS_CATCH(const std::bad_alloc&)
+                {
+                    index_.clear();
+                    return;
+                }
+                for (std::size_t pos = 0; pos < members_.size(); ++pos)
+                {
+                    index_insert(pos);
+                }
+            }
+        }
+
         void flatten_and_destroy() noexcept
         {
-            if (!members_.empty())
+            // Members shared with a copy are left to the copy
+            if (!members_.empty() && !is_shared())
             {
                 json_array<Json> temp(get_allocator());
 
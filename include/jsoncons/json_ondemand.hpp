@@ -0,0 +1,969 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ONDEMAND_HPP
+#define JSONCONS_JSON_ONDEMAND_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcmp
+#include <deque>
+#include <iterator>
+#include <istream> // std::basic_istream
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/detail/json_scan.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/structural_index.hpp>
+
+namespace jsoncons {
+
+    template <class Allocator>
+    class basic_json_ondemand_document;
+
+    // basic_json_ondemand_value
+    // A handle to a value in a basic_json_ondemand_document. Nothing is converted or validated until
+    // it is asked for, and values that are passed over on the way to a member or element are skipped
+    // by matching brackets in the structural index, without looking at their contents.
+
+    template <class Allocator=std::allocator<char>>
+    class basic_json_ondemand_value
+    {
+    public:
+        using allocator_type = Allocator;
+        using char_type = char;
+        using string_view_type = jsoncons::basic_string_view<char>;
+        using document_type = basic_json_ondemand_document<Allocator>;
+
+        class key_value_type;
+        class object_iterator;
+        class array_iterator;
+
+        using object_range_type = range<object_iterator,object_iterator>;
+        using array_range_type = range<array_iterator,array_iterator>;
+
+    private:
+        friend class basic_json_ondemand_document<Allocator>;
+
+        using default_json_type = basic_json<char,sorted_policy,Allocator>;
+
+        const document_type* doc_;
+        std::size_t index_;
+
+        basic_json_ondemand_value(const document_type* doc, std::size_t index)
+            : doc_(doc), index_(index)
+        {
+        }
+    public:
+        basic_json_ondemand_value()
+            : doc_(nullptr), index_(0)
+        {
+        }
+
+        json_type type() const
+        {
+            switch (doc_->char_at(index_))
+            {
+                case '{':
+                    return json_type::object_value;
+                case '[':
+                    return json_type::array_value;
+                case '\"':
+                    return json_type::string_value;
+                case 't':
+                case 'f':
+                    return json_type::bool_value;
+                case 'n':
+                    return json_type::null_value;
+                case '-':
+                case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                {
+                    bool is_integer = false;
+                    string_view_type s = doc_->scan_number(index_, is_integer);
+                    if (!is_integer)
+                    {
+                        return json_type::double_value;
+                    }
+                    // Integers that do not fit in 64 bits are bigint strings, as in basic_json
+                    if (s[0] == '-')
+                    {
+                        int64_t val;
+                        return jsoncons::detail::to_integer_unchecked(s.data(), s.length(), val) ? json_type::int64_value : json_type::string_value;
+                    }
+                    uint64_t val;
+                    return jsoncons::detail::to_integer_unchecked(s.data(), s.length(), val) ? json_type::uint64_value : json_type::string_value;
+                }
+                default:
+                    doc_->fail(json_errc::expected_value, doc_->offset_of(index_));
+            }
+            return json_type::null_value;
+        }
+
+        bool is_null() const
+        {
+            if (doc_->char_at(index_) != 'n')
+            {
+                return false;
+            }
+            doc_->check_literal(index_, "null", 4);
+            return true;
+        }
+
+        bool is_bool() const
+        {
+            char c = doc_->char_at(index_);
+            return c == 't' || c == 'f';
+        }
+
+        bool is_string() const
+        {
+            return doc_->char_at(index_) == '\"';
+        }
+
+        bool is_number() const
+        {
+            char c = doc_->char_at(index_);
+            return c == '-' || (c >= '0' && c <= '9');
+        }
+
+        bool is_object() const
+        {
+            return doc_->char_at(index_) == '{';
+        }
+
+        bool is_array() const
+        {
+            return doc_->char_at(index_) == '[';
+        }
+
+        bool get_bool() const
+        {
+            switch (doc_->char_at(index_))
+            {
+                case 't':
+                    doc_->check_literal(index_, "true", 4);
+                    return true;
+                case 'f':
+                    doc_->check_literal(index_, "false", 5);
+                    return false;
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a bool"));
+            }
+        }
+
+        int64_t get_int64() const
+        {
+            return get_integer<int64_t>();
+        }
+
+        uint64_t get_uint64() const
+        {
+            return get_integer<uint64_t>();
+        }
+
+        double get_double() const
+        {
+            if (!is_number())
+            {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Not a double"));
+            }
+            bool is_integer = false;
+            string_view_type s = doc_->scan_number(index_, is_integer);
+
+            double d;
+            if (jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', d))
+            {
+                return d;
+            }
+            jsoncons::detail::chars_to to_double;
+            std::string buffer(s.data(), s.length());
+            const char decimal_point = to_double.get_decimal_point();
+            for (auto& c : buffer)
+            {
+                if (c == '.')
+                {
+                    c = decimal_point;
+                }
+            }
+            return to_double(buffer.c_str(), buffer.length());
+        }
+
+        // Refers to the text when the string has no escapes, otherwise to a copy owned by the document
+        string_view_type get_string_view() const
+        {
+            if (!is_string())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+            return doc_->string_at(index_);
+        }
+
+        std::string get_string() const
+        {
+            string_view_type s = get_string_view();
+            return std::string(s.data(), s.length());
+        }
+
+        // The text of the value, without surrounding whitespace
+        string_view_type raw_json() const
+        {
+            return doc_->raw_json(index_);
+        }
+
+        // Number of members or elements. Walks the container, skipping over nested values.
+        std::size_t size() const
+        {
+            switch (doc_->char_at(index_))
+            {
+                case '{':
+                {
+                    std::size_t count = 0;
+                    for (std::size_t i = doc_->first_member(index_); i != 0; i = doc_->next_member(i))
+                    {
+                        ++count;
+                    }
+                    return count;
+                }
+                case '[':
+                {
+                    std::size_t count = 0;
+                    for (std::size_t i = doc_->first_element(index_); i != 0; i = doc_->next_element(i))
+                    {
+                        ++count;
+                    }
+                    return count;
+                }
+                default:
+                    return 0;
+            }
+        }
+
+        bool empty() const
+        {
+            switch (doc_->char_at(index_))
+            {
+                case '{':
+                    return doc_->char_at(index_ + 1) == '}';
+                case '[':
+                    return doc_->char_at(index_ + 1) == ']';
+                default:
+                    return false;
+            }
+        }
+
+        object_iterator find(const string_view_type& key) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(key.data(),key.length()));
+            }
+            for (std::size_t i = doc_->first_member(index_); i != 0; i = doc_->next_member(i))
+            {
+                if (doc_->key_equals(i, key))
+                {
+                    return object_iterator(doc_, i);
+                }
+            }
+            return object_iterator(doc_, doc_->close_of(index_));
+        }
+
+        bool contains(const string_view_type& key) const
+        {
+            return is_object() && find(key) != object_iterator(doc_, doc_->close_of(index_));
+        }
+
+        basic_json_ondemand_value at(const string_view_type& key) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(key.data(),key.length()));
+            }
+            for (std::size_t i = doc_->first_member(index_); i != 0; i = doc_->next_member(i))
+            {
+                if (doc_->key_equals(i, key))
+                {
+                    return basic_json_ondemand_value(doc_, i + 2);
+                }
+            }
+            JSONCONS_THROW(key_not_found(key.data(),key.length()));
+        }
+
+        basic_json_ondemand_value operator[](const string_view_type& key) const
+        {
+            return at(key);
+        }
+
+        // Reaching element i takes i steps
+        basic_json_ondemand_value at(std::size_t i) const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+            std::size_t count = 0;
+            for (std::size_t j = doc_->first_element(index_); j != 0; j = doc_->next_element(j))
+            {
+                if (count++ == i)
+                {
+                    return basic_json_ondemand_value(doc_, j);
+                }
+            }
+            JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+        }
+
+        basic_json_ondemand_value operator[](std::size_t i) const
+        {
+            return at(i);
+        }
+
+        object_range_type object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            std::size_t first = doc_->first_member(index_);
+            std::size_t last = doc_->close_of(index_);
+            return object_range_type(object_iterator(doc_, first == 0 ? last : first), object_iterator(doc_, last));
+        }
+
+        array_range_type array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            std::size_t first = doc_->first_element(index_);
+            std::size_t last = doc_->close_of(index_);
+            return array_range_type(array_iterator(doc_, first == 0 ? last : first), array_iterator(doc_, last));
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            return get_bool();
+        }
+
+        template <class T>
+        typename std::enable_if<extension_traits::is_integer<T>::value && !std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            return get_integer<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value,T>::type
+        as() const
+        {
+            return static_cast<T>(get_double());
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_view_type>::value,T>::type
+        as() const
+        {
+            return get_string_view();
+        }
+
+        // The text of a string, or the JSON text of any other value
+        template <class T>
+        typename std::enable_if<extension_traits::is_string<T>::value,T>::type
+        as() const
+        {
+            string_view_type s = is_string() ? doc_->string_at(index_) : raw_json();
+            return T(s.data(), s.length());
+        }
+
+        // basic_json targets are parsed from the text of the value
+        template <class T>
+        typename std::enable_if<extension_traits::is_basic_json<T>::value,T>::type
+        as() const
+        {
+            return T::parse(raw_json());
+        }
+
+        template <class T>
+        typename std::enable_if<!std::is_same<T,bool>::value && !extension_traits::is_integer<T>::value &&
+                                !std::is_floating_point<T>::value && !std::is_same<T,string_view_type>::value &&
+                                !extension_traits::is_string<T>::value && !extension_traits::is_basic_json<T>::value,T>::type
+        as() const
+        {
+            return as<default_json_type>().template as<T>();
+        }
+
+        template <class T>
+        T get() const
+        {
+            return as<T>();
+        }
+
+        friend bool operator==(const basic_json_ondemand_value& lhs, const basic_json_ondemand_value& rhs)
+        {
+            return lhs.doc_ == rhs.doc_ && lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const basic_json_ondemand_value& lhs, const basic_json_ondemand_value& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template <class IntegerType>
+        IntegerType get_integer() const
+        {
+            if (!is_number())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an integer"));
+            }
+            bool is_integer = false;
+            string_view_type s = doc_->scan_number(index_, is_integer);
+            if (!is_integer)
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an integer"));
+            }
+            IntegerType val;
+            auto result = jsoncons::detail::to_integer(s.data(), s.length(), val);
+            if (!result)
+            {
+                JSONCONS_THROW(json_runtime_error<std::runtime_error>(result.error_code().message()));
+            }
+            return val;
+        }
+    };
+
+    template <class Allocator>
+    class basic_json_ondemand_value<Allocator>::key_value_type
+    {
+        const document_type* doc_;
+        std::size_t index_;
+    public:
+        key_value_type(const document_type* doc, std::size_t index)
+            : doc_(doc), index_(index)
+        {
+        }
+
+        string_view_type key() const
+        {
+            return doc_->string_at(index_);
+        }
+
+        basic_json_ondemand_value value() const
+        {
+            return basic_json_ondemand_value(doc_, index_ + 2);
+        }
+    };
+
+    template <class Allocator>
+    class basic_json_ondemand_value<Allocator>::object_iterator
+    {
+        const document_type* doc_;
+        std::size_t index_;
+        key_value_type kv_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = key_value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const key_value_type*;
+        using reference = const key_value_type&;
+
+        object_iterator()
+            : doc_(nullptr), index_(0), kv_(nullptr, 0)
+        {
+        }
+
+        object_iterator(const document_type* doc, std::size_t index)
+            : doc_(doc), index_(index), kv_(doc, index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return kv_;
+        }
+
+        pointer operator->() const
+        {
+            return &kv_;
+        }
+
+        object_iterator& operator++()
+        {
+            std::size_t next = doc_->next_member(index_);
+            index_ = next == 0 ? doc_->close_after(index_ + 2) : next;
+            kv_ = key_value_type(doc_, index_);
+            return *this;
+        }
+
+        object_iterator operator++(int)
+        {
+            object_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const object_iterator& other) const
+        {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const object_iterator& other) const
+        {
+            return index_ != other.index_;
+        }
+    };
+
+    template <class Allocator>
+    class basic_json_ondemand_value<Allocator>::array_iterator
+    {
+        const document_type* doc_;
+        std::size_t index_;
+        basic_json_ondemand_value value_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = basic_json_ondemand_value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const basic_json_ondemand_value*;
+        using reference = const basic_json_ondemand_value&;
+
+        array_iterator()
+            : doc_(nullptr), index_(0)
+        {
+        }
+
+        array_iterator(const document_type* doc, std::size_t index)
+            : doc_(doc), index_(index), value_(doc, index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return value_;
+        }
+
+        pointer operator->() const
+        {
+            return &value_;
+        }
+
+        array_iterator& operator++()
+        {
+            std::size_t next = doc_->next_element(index_);
+            index_ = next == 0 ? doc_->close_after(index_) : next;
+            value_ = basic_json_ondemand_value(doc_, index_);
+            return *this;
+        }
+
+        array_iterator operator++(int)
+        {
+            array_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const array_iterator& other) const
+        {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const array_iterator& other) const
+        {
+            return index_ != other.index_;
+        }
+    };
+
+    // basic_json_ondemand_document
+    // Holds a JSON text and the offsets of its structural characters. Parsing checks only that brackets
+    // are balanced and that there is a single top-level value, everything else is checked when it is read.
+
+    template <class Allocator=std::allocator<char>>
+    class basic_json_ondemand_document
+    {
+    public:
+        using allocator_type = Allocator;
+        using char_type = char;
+        using string_view_type = jsoncons::basic_string_view<char>;
+        using value_type = basic_json_ondemand_value<Allocator>;
+    private:
+        friend class basic_json_ondemand_value<Allocator>;
+
+        using char_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<char>;
+        using index_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint32_t>;
+        using string_type = std::basic_string<char,std::char_traits<char>,char_allocator_type>;
+        using string_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<string_type>;
+
+        std::vector<char,char_allocator_type> buffer_;
+        const char* data_;
+        std::size_t length_;
+        std::vector<uint32_t,index_allocator_type> indexes_;
+        // Unescaped strings, a deque so that views of earlier strings stay valid
+        mutable std::deque<string_type,string_allocator_type> strings_;
+
+    public:
+        explicit basic_json_ondemand_document(const Allocator& alloc = Allocator())
+            : buffer_(alloc), data_(nullptr), length_(0), indexes_(alloc), strings_(alloc)
+        {
+        }
+
+        // A copy would refer to the text of the original
+        basic_json_ondemand_document(const basic_json_ondemand_document&) = delete;
+        basic_json_ondemand_document(basic_json_ondemand_document&&) = default;
+
+        basic_json_ondemand_document& operator=(const basic_json_ondemand_document&) = delete;
+        basic_json_ondemand_document& operator=(basic_json_ondemand_document&&) = default;
+
+        // Indexes the text in place, the text must outlive the document
+        static basic_json_ondemand_document parse(const string_view_type& source,
+                                                  const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                                  const Allocator& alloc = Allocator())
+        {
+            basic_json_ondemand_document doc(alloc);
+            doc.build(source.data(), source.length(), options);
+            return doc;
+        }
+
+        static basic_json_ondemand_document parse(const char_type* source,
+                                                  const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                                  const Allocator& alloc = Allocator())
+        {
+            return parse(string_view_type(source), options, alloc);
+        }
+
+        // Indexes a copy of a temporary string
+        static basic_json_ondemand_document parse(std::string&& source,
+                                                  const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                                  const Allocator& alloc = Allocator())
+        {
+            basic_json_ondemand_document doc(alloc);
+            doc.buffer_.assign(source.begin(), source.end());
+            doc.build(doc.buffer_.data(), doc.buffer_.size(), options);
+            return doc;
+        }
+
+        static basic_json_ondemand_document parse(std::basic_istream<char>& is,
+                                                  const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                                  const Allocator& alloc = Allocator())
+        {
+            basic_json_ondemand_document doc(alloc);
+            doc.buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+            if (is.bad())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error));
+            }
+            doc.build(doc.buffer_.data(), doc.buffer_.size(), options);
+            return doc;
+        }
+
+        value_type root() const
+        {
+            return value_type(this, 0);
+        }
+
+        value_type operator[](const string_view_type& key) const
+        {
+            return root()[key];
+        }
+
+        value_type operator[](std::size_t i) const
+        {
+            return root()[i];
+        }
+
+    private:
+        void build(const char* data, std::size_t length, const basic_json_decode_options<char>& options)
+        {
+            // Skip a UTF-8 byte order mark
+            if (length >= 3 && static_cast<uint8_t>(data[0]) == 0xEF && static_cast<uint8_t>(data[1]) == 0xBB &&
+                static_cast<uint8_t>(data[2]) == 0xBF)
+            {
+                data += 3;
+                length -= 3;
+            }
+            data_ = data;
+            length_ = length;
+
+            if (length >= (std::numeric_limits<uint32_t>::max)())
+            {
+                JSONCONS_THROW(ser_error(json_errc::source_error));
+            }
+            if (!jsoncons::detail::find_structural_indexes(data, length, indexes_) || indexes_.empty())
+            {
+                fail(json_errc::unexpected_eof, length_);
+            }
+
+            // Brackets must match, so that values can be skipped by counting them
+            std::vector<char,char_allocator_type> stack(buffer_.get_allocator());
+            const std::size_t n = indexes_.size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                char c = data_[indexes_[i]];
+                switch (c)
+                {
+                    case '{':
+                    case '[':
+                        if (static_cast<int>(stack.size()) >= options.max_nesting_depth())
+                        {
+                            fail(json_errc::max_nesting_depth_exceeded, indexes_[i]);
+                        }
+                        stack.push_back(c);
+                        break;
+                    case '}':
+                    case ']':
+                        if (stack.empty())
+                        {
+                            fail(json_errc::syntax_error, indexes_[i]);
+                        }
+                        if (stack.back() != (c == '}' ? '{' : '['))
+                        {
+                            fail(stack.back() == '{' ? json_errc::expected_comma_or_rbrace : json_errc::expected_comma_or_rbracket, indexes_[i]);
+                        }
+                        stack.pop_back();
+                        break;
+                    default:
+                        break;
+                }
+                if (stack.empty() && i + 1 < n)
+                {
+                    fail(json_errc::extra_character, indexes_[i + 1]);
+                }
+            }
+            if (!stack.empty())
+            {
+                fail(json_errc::unexpected_eof, length_);
+            }
+        }
+
+        [[noreturn]] void fail(json_errc ec, std::size_t offset) const
+        {
+            std::size_t line, column;
+            jsoncons::detail::json_text_position(data_, offset, line, column);
+            JSONCONS_THROW(ser_error(ec, line, column));
+        }
+
+        std::size_t offset_of(std::size_t i) const
+        {
+            return indexes_[i];
+        }
+
+        char char_at(std::size_t i) const
+        {
+            return data_[indexes_[i]];
+        }
+
+        // Index of the closing bracket of the container at i
+        std::size_t close_of(std::size_t i) const
+        {
+            std::size_t depth = 0;
+            for (;;)
+            {
+                switch (data_[indexes_[i]])
+                {
+                    case '{':
+                    case '[':
+                        ++depth;
+                        break;
+                    case '}':
+                    case ']':
+                        if (--depth == 0)
+                        {
+                            return i;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                ++i;
+            }
+        }
+
+        // Index just past the value at i
+        std::size_t skip(std::size_t i) const
+        {
+            switch (data_[indexes_[i]])
+            {
+                case '{':
+                case '[':
+                    return close_of(i) + 1;
+                case '}':
+                case ']':
+                case ',':
+                case ':':
+                    fail(json_errc::expected_value, indexes_[i]);
+                default:
+                    return i + 1;
+            }
+        }
+
+        // Index of the closing bracket that follows the last member or element, whose value is at i
+        std::size_t close_after(std::size_t i) const
+        {
+            return skip(i);
+        }
+
+        // Index of the first key in the object at i, or 0 if the object is empty
+        std::size_t first_member(std::size_t i) const
+        {
+            if (char_at(i + 1) == '}')
+            {
+                return 0;
+            }
+            check_member(i + 1);
+            return i + 1;
+        }
+
+        // Index of the key after the member whose key is at i, or 0 after the last member
+        std::size_t next_member(std::size_t i) const
+        {
+            std::size_t j = skip(i + 2);
+            switch (char_at(j))
+            {
+                case ',':
+                    if (char_at(j + 1) == '}')
+                    {
+                        fail(json_errc::extra_comma, offset_of(j + 1) + 1);
+                    }
+                    check_member(j + 1);
+                    return j + 1;
+                case '}':
+                    return 0;
+                default:
+                    fail(json_errc::expected_comma_or_rbrace, offset_of(j));
+            }
+        }
+
+        void check_member(std::size_t i) const
+        {
+            if (char_at(i) != '\"')
+            {
+                fail(json_errc::expected_key, offset_of(i));
+            }
+            if (char_at(i + 1) != ':')
+            {
+                fail(json_errc::expected_colon, offset_of(i + 1));
+            }
+        }
+
+        // Index of the first element in the array at i, or 0 if the array is empty
+        std::size_t first_element(std::size_t i) const
+        {
+            return char_at(i + 1) == ']' ? 0 : i + 1;
+        }
+
+        // Index of the element after the one at i, or 0 after the last element
+        std::size_t next_element(std::size_t i) const
+        {
+            std::size_t j = skip(i);
+            switch (char_at(j))
+            {
+                case ',':
+                    if (char_at(j + 1) == ']')
+                    {
+                        fail(json_errc::extra_comma, offset_of(j + 1) + 1);
+                    }
+                    return j + 1;
+                case ']':
+                    return 0;
+                default:
+                    fail(json_errc::expected_comma_or_rbracket, offset_of(j));
+            }
+        }
+
+        void check_literal(std::size_t i, const char* literal, std::size_t len) const
+        {
+            std::size_t pos = offset_of(i);
+            if (length_ - pos < len || std::memcmp(data_ + pos, literal, len) != 0 ||
+                !jsoncons::detail::is_json_terminator(data_ + pos + len, data_ + length_))
+            {
+                fail(json_errc::invalid_value, pos);
+            }
+        }
+
+        string_view_type scan_number(std::size_t i, bool& is_integer) const
+        {
+            const char* first = data_ + offset_of(i);
+            const char* end = data_ + length_;
+            const char* last = jsoncons::detail::scan_json_number(first, end, is_integer);
+            if (last == nullptr || !jsoncons::detail::is_json_terminator(last, end))
+            {
+                fail(json_errc::invalid_number, offset_of(i));
+            }
+            return string_view_type(first, static_cast<std::size_t>(last - first));
+        }
+
+        string_view_type string_at(std::size_t i) const
+        {
+            const char* first = data_ + offset_of(i) + 1;
+            const char* end = data_ + length_;
+            const char* last = jsoncons::detail::find_string_special(first, end);
+            if (JSONCONS_LIKELY(last != end && *last == '\"'))
+            {
+                auto result = jsoncons::detail::fast_validate(first, static_cast<std::size_t>(last - first));
+                if (JSONCONS_UNLIKELY(result.ec != unicode_traits::conv_errc()))
+                {
+                    fail(json_errc::illegal_codepoint, static_cast<std::size_t>(result.ptr - data_));
+                }
+                return string_view_type(first, static_cast<std::size_t>(last - first));
+            }
+            strings_.emplace_back(buffer_.get_allocator());
+            string_type& s = strings_.back();
+            json_errc ec = jsoncons::detail::unescape_json_string(first, end, s, last);
+            if (ec != json_errc())
+            {
+                strings_.pop_back();
+                fail(ec, static_cast<std::size_t>(last - data_));
+            }
+            return string_view_type(s.data(), s.length());
+        }
+
+        // Compares the key at i with key, without keeping a copy of a key that has escapes
+        bool key_equals(std::size_t i, const string_view_type& key) const
+        {
+            const char* first = data_ + offset_of(i) + 1;
+            const char* end = data_ + length_;
+            const char* last = jsoncons::detail::find_string_special(first, end);
+            if (JSONCONS_LIKELY(last != end && *last == '\"'))
+            {
+                return string_view_type(first, static_cast<std::size_t>(last - first)) == key;
+            }
+            string_type s(buffer_.get_allocator());
+            json_errc ec = jsoncons::detail::unescape_json_string(first, end, s, last);
+            if (ec != json_errc())
+            {
+                fail(ec, static_cast<std::size_t>(last - data_));
+            }
+            return string_view_type(s.data(), s.length()) == key;
+        }
+
+        string_view_type raw_json(std::size_t i) const
+        {
+            const char* first = data_ + offset_of(i);
+            char c = *first;
+            if (c == '{' || c == '[')
+            {
+                return string_view_type(first, static_cast<std::size_t>(offset_of(close_of(i)) + 1 - offset_of(i)));
+            }
+            // A scalar extends to the next structural character, less any whitespace before it
+            const char* last = (i + 1 < indexes_.size()) ? data_ + offset_of(i + 1) : data_ + length_;
+            while (last > first + 1 && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\n' || last[-1] == '\r'))
+            {
+                --last;
+            }
+            return string_view_type(first, static_cast<std::size_t>(last - first));
+        }
+    };
+
+    using json_ondemand_document = basic_json_ondemand_document<std::allocator<char>>;
+    using json_ondemand_value = basic_json_ondemand_value<std::allocator<char>>;
+
+} // namespace jsoncons
+
+#endif
@@ -358,17 +358,23 @@ public:
     using typename super_type::string_type;
 private:
     bool lossless_number_;
+    bool lazy_number_;
+    std::size_t max_interned_keys_;
+    std::size_t max_length_hint_;
+    std::size_t min_packed_array_length_;
     std::function<bool(json_errc,const ser_context&)> err_handler_;
 public:
     basic_json_decode_options()
-        : lossless_number_(false), err_handler_(default_json_parsing())
+        : lossless_number_(false), lazy_number_(false), max_interned_keys_(1024), max_length_hint_(65536), min_packed_array_length_(0), 
+          err_handler_(default_json_parsing())
     {
     }
 
     basic_json_decode_options(const basic_json_decode_options&) = default;
 
     basic_json_decode_options(basic_json_decode_options&& other)
-        : super_type(std::move(other)), lossless_number_(other.lossless_number_), err_handler_(std::move(other.err_handler_))
+        : super_type(std::move(other)), lossless_number_(other.lossless_number_), lazy_number_(other.lazy_number_), max_interned_keys_(other.max_interned_keys_), 
+          max_length_hint_(other.max_length_hint_), min_packed_array_length_(other.min_packed_array_length_), err_handler_(std::move(other.err_handler_))
     {
     }
 
@@ -379,6 +385,26 @@ public:
         return lossless_number_;
     }
 
+    bool lazy_number() const 
+    {
+        return lazy_number_;
+    }
+
+    std::size_t max_interned_keys() const 
+    {
+        return max_interned_keys_;
+    }
+
+    std::size_t max_length_hint() const 
+    {
+        return max_length_hint_;
+    }
+
+    std::size_t min_packed_array_length() const 
+    {
+        return min_packed_array_length_;
+    }
+
     const std::function<bool(json_errc,const ser_context&)>& err_handler() const 
     {
         return err_handler_;
@@ -582,6 +608,10 @@ public:
     using basic_json_decode_options<CharT>::neginf_to_num;
 
     using basic_json_decode_options<CharT>::lossless_number;
+    using basic_json_decode_options<CharT>::lazy_number;
+    using basic_json_decode_options<CharT>::max_interned_keys;
+    using basic_json_decode_options<CharT>::max_length_hint;
+    using basic_json_decode_options<CharT>::min_packed_array_length;
     using basic_json_decode_options<CharT>::err_handler;
 
     using basic_json_encode_options<CharT>::byte_string_format;
@@ -764,6 +794,30 @@ public:
         return *this;
     }
 
+    basic_json_options& lazy_number(bool value) 
+    {
+        this->lazy_number_ = value;
+        return *this;
+    }
+
+    basic_json_options& max_interned_keys(std::size_t value) 
+    {
+        this->max_interned_keys_ = value;
+        return *this;
+    }
+
+    basic_json_options& max_length_hint(std::size_t value) 
+    {
+        this->max_length_hint_ = value;
+        return *this;
+    }
+
+    basic_json_options& min_packed_array_length(std::size_t value) 
+    {
+        this->min_packed_array_length_ = value;
+        return *this;
+    }
+
     basic_json_options& err_handler(const std::function<bool(json_errc,const ser_context&)>& value) 
     {
         this->err_handler_ = value;
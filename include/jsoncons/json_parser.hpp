@@ -7,6 +7,7 @@
 #ifndef JSONCONS_JSON_PARSER_HPP
 #define JSONCONS_JSON_PARSER_HPP
 
+#include <algorithm> // std::replace
 #include <memory> // std::allocator
 #include <string>
 #include <vector>
@@ -21,6 +22,8 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -265,9 +268,12 @@ public:
             {
                 case ' ':
                 case '\t':
-                    ++input_ptr_;
-                    ++position_;
+                {
+                    const char_type* p = jsoncons::detail::skip_blanks(input_ptr_ + 1, local_input_end);
+                    position_ += (p - input_ptr_);
+                    input_ptr_ = p;
                     break;
+                }
                 case '\r': 
                     push_state(state_);
                     ++input_ptr_;
@@ -279,7 +285,7 @@ public:
                     ++line_;
                     ++position_;
                     mark_position_ = position_;
-                    return;   
+                    break;   
                 default:
                     return;
             }
@@ -641,13 +647,7 @@ public:
                                 ++position_;
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -760,13 +760,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/':
@@ -840,13 +834,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/':
@@ -915,13 +903,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -996,13 +978,7 @@ public:
                                 ++input_ptr_;
                                 ++position_;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1050,13 +1026,7 @@ public:
                                 ++position_;
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1198,13 +1168,7 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1715,6 +1679,7 @@ public:
     void parse_number(basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
         const char_type* local_input_end = end_input_;
+        const char_type* number_first = nullptr;
 
         switch (state_)
         {
@@ -1836,6 +1801,21 @@ zero:
                 return;
         }
 integer:
+        {
+            // If the whole integer is in this buffer, convert it in place rather than through string_buffer_
+            const char_type* digits_end = jsoncons::detail::skip_digits(input_ptr_, local_input_end);
+            if (digits_end != local_input_end && *digits_end != '.' && *digits_end != 'e' && *digits_end != 'E' &&
+                static_cast<std::size_t>(input_ptr_ - begin_input_) >= string_buffer_.length())
+            {
+                number_first = input_ptr_ - string_buffer_.length();
+            }
+            else
+            {
+                string_buffer_.append(input_ptr_, digits_end);
+            }
+            position_ += (digits_end - input_ptr_);
+            input_ptr_ = digits_end;
+        }
         if (JSONCONS_UNLIKELY(input_ptr_ >= local_input_end)) // Buffer exhausted               
         {
             state_ = json_parse_state::integer;
@@ -1844,7 +1824,7 @@ integer:
         switch (*input_ptr_)
         {
             case '\r': 
-                end_integer_value(visitor, ec);
+                end_integer_value(number_first, visitor, ec);
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
@@ -1852,7 +1832,7 @@ integer:
                 state_ = json_parse_state::cr;
                 return; 
             case '\n': 
-                end_integer_value(visitor, ec);
+                end_integer_value(number_first, visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
@@ -1860,12 +1840,12 @@ integer:
                 mark_position_ = position_;
                 return;   
             case ' ':case '\t':
-                end_integer_value(visitor, ec);
+                end_integer_value(number_first, visitor, ec);
                 if (ec) return;
                 skip_space();
                 return;
             case '/': 
-                end_integer_value(visitor, ec);
+                end_integer_value(number_first, visitor, ec);
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
@@ -1874,15 +1854,10 @@ integer:
                 return;
             case '}':
             case ']':
-                end_integer_value(visitor, ec);
+                end_integer_value(number_first, visitor, ec);
                 if (ec) return;
                 state_ = json_parse_state::expect_comma_or_end;
                 return;
-            case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                string_buffer_.push_back(static_cast<char>(*input_ptr_));
-                ++input_ptr_;
-                ++position_;
-                goto integer;
             case '.':
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
@@ -1894,7 +1869,7 @@ integer:
                 ++position_;
                 goto exp1;
             case ',':
-                end_integer_value(visitor, ec);
+                end_integer_value(number_first, visitor, ec);
                 if (ec) return;
                 begin_member_or_element(ec);
                 if (ec) return;
@@ -2159,6 +2134,11 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
@@ -2639,42 +2619,66 @@ private:
 
     void end_integer_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
-        if (string_buffer_[0] == '-')
+        end_integer_value(string_buffer_.data(), string_buffer_.length(), visitor, ec);
+    }
+
+    // Integer that ends at input_ptr_, either in the input buffer starting at first, 
+    // or, if first is null, in string_buffer_
+    void end_integer_value(const char_type* first, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (first != nullptr)
         {
-            end_negative_value(visitor, ec);
+            end_integer_value(first, static_cast<std::size_t>(input_ptr_ - first), visitor, ec);
         }
         else
         {
-            end_positive_value(visitor, ec);
+            end_integer_value(visitor, ec);
         }
     }
 
-    void end_negative_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    void end_integer_value(const char_type* s, std::size_t length, basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    {
+        if (options_.lazy_number())
+        {
+            more_ = visitor.number_value(string_view_type(s, length), semantic_tag::none, *this, ec);
+            after_value(ec);
+        }
+        else if (s[0] == '-')
+        {
+            end_negative_value(s, length, visitor, ec);
+        }
+        else
+        {
+            end_positive_value(s, length, visitor, ec);
+        }
+    }
+
+    void end_negative_value(const char_type* s, std::size_t length, basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
         int64_t val;
-        auto result = jsoncons::detail::to_integer_unchecked(string_buffer_.data(), string_buffer_.length(), val);
+        auto result = jsoncons::detail::to_integer_unchecked(s, length, val);
         if (result)
         {
             more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
         }
         else // Must be overflow
         {
-            more_ = visitor.string_value(string_buffer_, semantic_tag::bigint, *this, ec);
+            more_ = visitor.string_value(string_view_type(s, length), semantic_tag::bigint, *this, ec);
         }
         after_value(ec);
     }
 
-    void end_positive_value(basic_json_visitor<char_type>& visitor, std::error_code& ec)
+    void end_positive_value(const char_type* s, std::size_t length, basic_json_visitor<char_type>& visitor, std::error_code& ec)
     {
         uint64_t val;
-        auto result = jsoncons::detail::to_integer_unchecked(string_buffer_.data(), string_buffer_.length(), val);
+        auto result = jsoncons::detail::to_integer_unchecked(s, length, val);
         if (result)
         {
             more_ = visitor.uint64_value(val, semantic_tag::none, *this, ec);
         }
         else // Must be overflow
         {
-            more_ = visitor.string_value(string_buffer_, semantic_tag::bigint, *this, ec);
+            more_ = visitor.string_value(string_view_type(s, length), semantic_tag::bigint, *this, ec);
         }
         after_value(ec);
     }
@@ -2687,9 +2691,22 @@ private:
             {
                 more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
             }
+            else if (options_.lazy_number())
+            {
+                // string_buffer_ has the locale's decimal point, the number text has '.'
+                if (to_double_.get_decimal_point() != '.')
+                {
+                    std::replace(string_buffer_.begin(), string_buffer_.end(), static_cast<char_type>(to_double_.get_decimal_point()), char_type('.'));
+                }
+                more_ = visitor.number_value(string_buffer_, semantic_tag::none, *this, ec);
+            }
             else
             {
-                double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                double d;
+                if (!jsoncons::detail::decimal_to_double(string_buffer_.data(), string_buffer_.length(), to_double_.get_decimal_point(), d))
+                {
+                    d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                }
                 more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
             }
         }
@@ -2710,7 +2727,7 @@ private:
     void end_string_value(const char_type* s, std::size_t length, basic_json_visitor<char_type>& visitor, std::error_code& ec) 
     {
         string_view_type sv(s, length);
-        auto result = unicode_traits::validate(s, length);
+        auto result = jsoncons::detail::fast_validate(s, length);
         if (result.ec != unicode_traits::conv_errc())
         {
             translate_conv_errc(result.ec,ec);
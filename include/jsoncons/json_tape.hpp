@@ -0,0 +1,590 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_TAPE_HPP
+#define JSONCONS_JSON_TAPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <system_error>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
+#include <jsoncons/detail/json_scan.hpp>
+#include <jsoncons/detail/structural_index.hpp>
+
+namespace jsoncons {
+
+    // A tape is a flat array of 64-bit words, one per token, with the token type in the
+    // high byte. Containers hold the index one past their end marker in the low 32 bits
+    // and the number of elements (members for objects) in the next 24 bits, saturating
+    // at 0xFFFFFF, so that a whole subtree can be skipped in one step. Numbers take
+    // a second word holding their value. Strings without escapes hold their length and
+    // are read in place from the source text, other strings hold an offset into a separate
+    // buffer of length-prefixed, unescaped strings.
+
+    enum class tape_type : uint8_t
+    {
+        begin_object = '{',
+        end_object = '}',
+        begin_array = '[',
+        end_array = ']',
+        key = 'k',
+        string_value = '\"',
+        bigint_value = 'B',
+        bigdec_value = 'D',
+        int64_value = 'l',
+        uint64_value = 'u',
+        double_value = 'd',
+        true_value = 't',
+        false_value = 'f',
+        null_value = 'n'
+    };
+
+    template <class Allocator=std::allocator<char>>
+    class basic_json_tape
+    {
+    public:
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<char>;
+
+        static constexpr std::size_t max_count = 0xFFFFFF;
+    private:
+        // Marks a string that is read in place from the source text, the payload holds its length
+        static constexpr uint64_t source_string_flag = uint64_t(1) << 55;
+
+        using word_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint64_t>;
+        using offset_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint32_t>;
+        using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char>;
+
+        template <class Alloc>
+        friend class basic_json_tape_builder;
+
+        std::vector<uint64_t,word_allocator_type> words_;
+        std::vector<uint32_t,offset_allocator_type> offsets_;
+        std::vector<char,char_allocator_type> strings_;
+        const char* source_;
+    public:
+        basic_json_tape(const allocator_type& alloc = allocator_type())
+            : words_(alloc), offsets_(alloc), strings_(alloc), source_(nullptr)
+        {
+        }
+
+        basic_json_tape(const basic_json_tape&) = default;
+        basic_json_tape(basic_json_tape&&) = default;
+        basic_json_tape& operator=(const basic_json_tape&) = default;
+        basic_json_tape& operator=(basic_json_tape&&) = default;
+
+        void clear()
+        {
+            words_.clear();
+            offsets_.clear();
+            strings_.clear();
+        }
+
+        bool empty() const
+        {
+            return words_.empty();
+        }
+
+        // Number of words on the tape
+        std::size_t size() const
+        {
+            return words_.size();
+        }
+
+        tape_type type(std::size_t i) const
+        {
+            return static_cast<tape_type>(words_[i] >> 56);
+        }
+
+        // Offset in the source text of the token at i
+        std::size_t source_offset(std::size_t i) const
+        {
+            return offsets_[i];
+        }
+
+        // Index one past the value that starts at i
+        std::size_t next(std::size_t i) const
+        {
+            switch (type(i))
+            {
+                case tape_type::begin_object:
+                case tape_type::begin_array:
+                    return static_cast<std::size_t>(words_[i] & 0xFFFFFFFF);
+                case tape_type::int64_value:
+                case tape_type::uint64_value:
+                case tape_type::double_value:
+                    return i + 2;
+                default:
+                    return i + 1;
+            }
+        }
+
+        // Index of the end marker of the container that starts at i
+        std::size_t end_of(std::size_t i) const
+        {
+            return static_cast<std::size_t>(words_[i] & 0xFFFFFFFF) - 1;
+        }
+
+        // Number of elements or members of the container at i, or max_count if there are more
+        std::size_t count(std::size_t i) const
+        {
+            return static_cast<std::size_t>((words_[i] >> 32) & max_count);
+        }
+
+        // The source text the tape was built from
+        const char* source() const
+        {
+            return source_;
+        }
+
+        // The text of a key, string, bigint or bigdec. Strings without escapes refer to the 
+        // source text, which must outlive the tape.
+        string_view_type string(std::size_t i) const
+        {
+            if (words_[i] & source_string_flag)
+            {
+                return string_view_type(source_ + offsets_[i] + 1, static_cast<std::size_t>(words_[i] & 0xFFFFFFFF));
+            }
+            std::size_t offset = static_cast<std::size_t>(words_[i] & 0x00FFFFFFFFFFFFFF);
+            uint32_t length;
+            std::memcpy(&length, strings_.data() + offset, sizeof(uint32_t));
+            return string_view_type(strings_.data() + offset + sizeof(uint32_t), length);
+        }
+
+        int64_t int64_value(std::size_t i) const
+        {
+            return static_cast<int64_t>(words_[i+1]);
+        }
+
+        uint64_t uint64_value(std::size_t i) const
+        {
+            return words_[i+1];
+        }
+
+        double double_value(std::size_t i) const
+        {
+            double d;
+            std::memcpy(&d, &words_[i+1], sizeof(double));
+            return d;
+        }
+    };
+
+    template <class Allocator>
+    constexpr std::size_t basic_json_tape<Allocator>::max_count;
+    template <class Allocator>
+    constexpr uint64_t basic_json_tape<Allocator>::source_string_flag;
+
+    // basic_json_tape_builder
+    // Stage two of the tape parse: walks the structural index, validates the grammar,
+    // strings, numbers and literals, and writes the tape. It accepts only RFC 8259 JSON,
+    // and reports the first problem with a json_errc and the offset of the offending token.
+
+    template <class Allocator=std::allocator<char>>
+    class basic_json_tape_builder
+    {
+    public:
+        using allocator_type = Allocator;
+        using json_tape_type = basic_json_tape<Allocator>;
+    private:
+        using index_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint32_t>;
+
+        struct frame
+        {
+            std::size_t index;
+            std::size_t count;
+            bool is_object;
+        };
+        using frame_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<frame>;
+
+        basic_json_decode_options<char> options_;
+        std::vector<uint32_t,index_allocator_type> indexes_;
+        std::vector<frame,frame_allocator_type> stack_;
+        jsoncons::detail::chars_to to_double_;
+        std::string number_buffer_;
+
+        const char* data_;
+        std::size_t length_;
+        json_tape_type* tape_;
+        std::size_t error_offset_;
+    public:
+        basic_json_tape_builder(const basic_json_decode_options<char>& options = basic_json_decode_options<char>(),
+                                const allocator_type& alloc = allocator_type())
+            : options_(options), indexes_(alloc), stack_(alloc),
+              data_(nullptr), length_(0), tape_(nullptr), error_offset_(0)
+        {
+        }
+
+        // Offset in the source of the token where the last build failed
+        std::size_t error_offset() const
+        {
+            return error_offset_;
+        }
+
+        void build(const char* data, std::size_t length, json_tape_type& tape, std::error_code& ec)
+        {
+            data_ = data;
+            length_ = length;
+            tape_ = &tape;
+            error_offset_ = 0;
+            tape.clear();
+            tape.source_ = data;
+            stack_.clear();
+
+            if (length >= 0xFFFFFFFF)
+            {
+                ec = json_errc::source_error;
+                return;
+            }
+            if (!jsoncons::detail::find_structural_indexes(data, length, indexes_))
+            {
+                error_offset_ = length;
+                ec = json_errc::unexpected_eof;
+                return;
+            }
+            tape.words_.reserve(indexes_.size() + indexes_.size()/2);
+            tape.offsets_.reserve(indexes_.size() + indexes_.size()/2);
+
+            json_errc result = walk();
+            if (result != json_errc())
+            {
+                ec = result;
+                tape.clear();
+            }
+        }
+
+    private:
+        void append(tape_type t, uint64_t payload, std::size_t offset)
+        {
+            tape_->words_.push_back((static_cast<uint64_t>(t) << 56) | payload);
+            tape_->offsets_.push_back(static_cast<uint32_t>(offset));
+        }
+
+        void append_value(tape_type t, uint64_t value, std::size_t offset)
+        {
+            append(t, 0, offset);
+            tape_->words_.push_back(value);
+            tape_->offsets_.push_back(static_cast<uint32_t>(offset));
+        }
+
+        json_errc fail(json_errc ec, std::size_t offset)
+        {
+            error_offset_ = offset;
+            return ec;
+        }
+
+        json_errc walk()
+        {
+            const uint32_t* idx = indexes_.data();
+            const std::size_t n = indexes_.size();
+            std::size_t i = 0;
+            std::size_t pos = 0;
+            json_errc ec{};
+
+            if (n == 0)
+            {
+                return fail(json_errc::unexpected_eof, length_);
+            }
+
+        value:
+            if (JSONCONS_UNLIKELY(i >= n))
+            {
+                return fail(json_errc::unexpected_eof, length_);
+            }
+            pos = idx[i++];
+            switch (data_[pos])
+            {
+                case '{':
+                    if (JSONCONS_UNLIKELY(static_cast<int>(stack_.size()) >= options_.max_nesting_depth()))
+                    {
+                        return fail(json_errc::max_nesting_depth_exceeded, pos);
+                    }
+                    stack_.push_back(frame{tape_->words_.size(), 0, true});
+                    append(tape_type::begin_object, 0, pos);
+                    if (i < n && data_[idx[i]] == '}')
+                    {
+                        ++i;
+                        goto end_container;
+                    }
+                    goto object_key;
+                case '[':
+                    if (JSONCONS_UNLIKELY(static_cast<int>(stack_.size()) >= options_.max_nesting_depth()))
+                    {
+                        return fail(json_errc::max_nesting_depth_exceeded, pos);
+                    }
+                    stack_.push_back(frame{tape_->words_.size(), 0, false});
+                    append(tape_type::begin_array, 0, pos);
+                    if (i < n && data_[idx[i]] == ']')
+                    {
+                        ++i;
+                        goto end_container;
+                    }
+                    goto value;
+                case '\"':
+                    ec = parse_string(pos, tape_type::string_value);
+                    break;
+                case '-':
+                case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                    ec = parse_number(pos);
+                    break;
+                case 't':
+                    ec = parse_literal(pos, "true", 4, tape_type::true_value);
+                    break;
+                case 'f':
+                    ec = parse_literal(pos, "false", 5, tape_type::false_value);
+                    break;
+                case 'n':
+                    ec = parse_literal(pos, "null", 4, tape_type::null_value);
+                    break;
+                default:
+                    return fail(json_errc::syntax_error, pos);
+            }
+            if (JSONCONS_UNLIKELY(ec != json_errc()))
+            {
+                return ec;
+            }
+
+        after_value:
+            if (stack_.empty())
+            {
+                if (i != n)
+                {
+                    return fail(json_errc::extra_character, idx[i]);
+                }
+                return json_errc();
+            }
+            ++stack_.back().count;
+            if (JSONCONS_UNLIKELY(i >= n))
+            {
+                return fail(json_errc::unexpected_eof, length_);
+            }
+            pos = idx[i++];
+            switch (data_[pos])
+            {
+                case ',':
+                    if (stack_.back().is_object)
+                    {
+                        goto object_key;
+                    }
+                    goto value;
+                case '}':
+                    if (JSONCONS_UNLIKELY(!stack_.back().is_object))
+                    {
+                        return fail(json_errc::expected_comma_or_rbracket, pos);
+                    }
+                    goto end_container;
+                case ']':
+                    if (JSONCONS_UNLIKELY(stack_.back().is_object))
+                    {
+                        return fail(json_errc::expected_comma_or_rbrace, pos);
+                    }
+                    goto end_container;
+                default:
+                    return fail(stack_.back().is_object ? json_errc::expected_comma_or_rbrace : json_errc::expected_comma_or_rbracket, pos);
+            }
+
+        object_key:
+            if (JSONCONS_UNLIKELY(i >= n))
+            {
+                return fail(json_errc::unexpected_eof, length_);
+            }
+            pos = idx[i++];
+            if (JSONCONS_UNLIKELY(data_[pos] != '\"'))
+            {
+                return fail(json_errc::expected_key, pos);
+            }
+            ec = parse_string(pos, tape_type::key);
+            if (JSONCONS_UNLIKELY(ec != json_errc()))
+            {
+                return ec;
+            }
+            if (JSONCONS_UNLIKELY(i >= n))
+            {
+                return fail(json_errc::unexpected_eof, length_);
+            }
+            pos = idx[i++];
+            if (JSONCONS_UNLIKELY(data_[pos] != ':'))
+            {
+                return fail(json_errc::expected_colon, pos);
+            }
+            goto value;
+
+        end_container:
+            {
+                frame f = stack_.back();
+                stack_.pop_back();
+                std::size_t end_index = tape_->words_.size();
+                append(f.is_object ? tape_type::end_object : tape_type::end_array, f.index, idx[i-1]);
+                std::size_t count = f.count < json_tape_type::max_count ? f.count : json_tape_type::max_count;
+                tape_->words_[f.index] |= static_cast<uint64_t>(end_index + 1) | (static_cast<uint64_t>(count) << 32);
+            }
+            goto after_value;
+        }
+
+        bool is_terminator(std::size_t pos) const
+        {
+            return jsoncons::detail::is_json_terminator(data_ + pos, data_ + length_);
+        }
+
+        json_errc parse_literal(std::size_t pos, const char* literal, std::size_t len, tape_type t)
+        {
+            if (length_ - pos < len || std::memcmp(data_ + pos, literal, len) != 0 || !is_terminator(pos + len))
+            {
+                return fail(json_errc::invalid_value, pos);
+            }
+            append(t, 0, pos);
+            return json_errc();
+        }
+
+        json_errc parse_number(std::size_t pos)
+        {
+            const char* first = data_ + pos;
+            const char* end = data_ + length_;
+            bool is_integer = false;
+            const char* cur = jsoncons::detail::scan_json_number(first, end, is_integer);
+            if (cur == nullptr)
+            {
+                return fail(json_errc::invalid_number, pos);
+            }
+            std::size_t length = static_cast<std::size_t>(cur - first);
+            if (!is_terminator(pos + length))
+            {
+                return fail(json_errc::invalid_number, pos);
+            }
+
+            if (is_integer)
+            {
+                if (*first == '-')
+                {
+                    int64_t val;
+                    if (jsoncons::detail::to_integer_unchecked(first, length, val))
+                    {
+                        append_value(tape_type::int64_value, static_cast<uint64_t>(val), pos);
+                        return json_errc();
+                    }
+                }
+                else
+                {
+                    uint64_t val;
+                    if (jsoncons::detail::to_integer_unchecked(first, length, val))
+                    {
+                        append_value(tape_type::uint64_value, val, pos);
+                        return json_errc();
+                    }
+                }
+                append_string(first, length, tape_type::bigint_value, pos);
+                return json_errc();
+            }
+
+            char decimal_point = to_double_.get_decimal_point();
+            if (options_.lossless_number())
+            {
+                std::size_t offset = append_string(first, length, tape_type::bigdec_value, pos);
+                if (decimal_point != '.')
+                {
+                    char* s = tape_->strings_.data() + offset;
+                    for (std::size_t k = 0; k < length; ++k)
+                    {
+                        if (s[k] == '.')
+                        {
+                            s[k] = decimal_point;
+                        }
+                    }
+                }
+                return json_errc();
+            }
+
+            double d;
+            if (!jsoncons::detail::decimal_to_double(first, length, '.', d))
+            {
+                number_buffer_.assign(first, length);
+                for (auto& c : number_buffer_)
+                {
+                    if (c == '.')
+                    {
+                        c = decimal_point;
+                    }
+                }
+                JSONCONS_TRY
+                {
+                    d = to_double_(number_buffer_.c_str(), number_buffer_.length());
+                }
+                JSONCONS_CATCH(...)
+                {
+                    return fail(json_errc::invalid_number, pos);
+                }
+            }
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(double));
+            append_value(tape_type::double_value, bits, pos);
+            return json_errc();
+        }
+
+        // Appends a length-prefixed string and its tape word, and returns the offset of its characters
+        std::size_t append_string(const char* s, std::size_t length, tape_type t, std::size_t pos)
+        {
+            auto& strings = tape_->strings_;
+            std::size_t header = strings.size();
+            uint32_t len = static_cast<uint32_t>(length);
+            strings.resize(header + sizeof(uint32_t));
+            std::memcpy(strings.data() + header, &len, sizeof(uint32_t));
+            strings.insert(strings.end(), s, s + length);
+            append(t, header, pos);
+            return header + sizeof(uint32_t);
+        }
+
+        json_errc parse_string(std::size_t pos, tape_type t)
+        {
+            auto& strings = tape_->strings_;
+            const char* first = data_ + pos + 1;
+            const char* end = data_ + length_;
+
+            // Strings without escapes are left in the source
+            const char* last = jsoncons::detail::find_string_special(first, end);
+            if (JSONCONS_LIKELY(last != end && *last == '\"'))
+            {
+                auto result = jsoncons::detail::fast_validate(first, static_cast<std::size_t>(last - first));
+                if (JSONCONS_UNLIKELY(result.ec != unicode_traits::conv_errc()))
+                {
+                    return fail(json_errc::illegal_codepoint, static_cast<std::size_t>(result.ptr - data_));
+                }
+                append(t, json_tape_type::source_string_flag | static_cast<uint64_t>(last - first), pos);
+                return json_errc();
+            }
+
+            std::size_t header = strings.size();
+            strings.resize(header + sizeof(uint32_t));
+
+            json_errc err = jsoncons::detail::unescape_json_string(first, end, strings, last);
+            if (JSONCONS_UNLIKELY(err != json_errc()))
+            {
+                return fail(err, static_cast<std::size_t>(last - data_));
+            }
+
+            uint32_t len = static_cast<uint32_t>(strings.size() - header - sizeof(uint32_t));
+            std::memcpy(strings.data() + header, &len, sizeof(uint32_t));
+            append(t, header, pos);
+
+            // The closing quote must be followed by whitespace, an operator or the end of input,
+            // anything else is caught by the grammar as the start of the next token
+            return json_errc();
+        }
+    };
+
+    using json_tape = basic_json_tape<std::allocator<char>>;
+    using json_tape_builder = basic_json_tape_builder<std::allocator<char>>;
+
+} // namespace jsoncons
+
+#endif
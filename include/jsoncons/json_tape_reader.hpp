@@ -0,0 +1,401 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_TAPE_READER_HPP
+#define JSONCONS_JSON_TAPE_READER_HPP
+
+#include <cmath> // std::nan
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <utility> // std::move
+#include <functional>
+#include <system_error>
+#include <jsoncons/source.hpp>
+#include <jsoncons/source_adaptor.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_tape.hpp>
+
+namespace jsoncons {
+
+    // basic_json_tape_reader
+    // Reads a complete JSON text held in memory in two stages, a SIMD structural index
+    // followed by a tape, and replays the tape to a basic_json_visitor. Input that is not
+    // RFC 8259 JSON (comments, errors) is handed to basic_json_parser, so events, error
+    // codes, positions and err_handler recovery are the same as for basic_json_reader.
+
+    template<class Source=jsoncons::string_source<char>,class TempAllocator=std::allocator<char>>
+    class basic_json_tape_reader
+    {
+    public:
+        using char_type = char;
+        using source_type = Source;
+        using string_view_type = jsoncons::basic_string_view<char>;
+        using temp_allocator_type = TempAllocator;
+
+        static_assert(sizeof(typename Source::value_type) == sizeof(char), "The source must provide UTF-8 text");
+    private:
+        using char_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<char>;
+
+        class tape_context : public ser_context
+        {
+            const char* data_;
+            std::size_t offset_;
+            // Line and mark (offset of the first character of the line) at scanned_
+            mutable std::size_t scanned_;
+            mutable std::size_t line_;
+            mutable std::size_t mark_;
+        public:
+            tape_context()
+                : data_(nullptr), offset_(0), scanned_(0), line_(1), mark_(0)
+            {
+            }
+
+            void reset(const char* data)
+            {
+                data_ = data;
+                offset_ = 0;
+                scanned_ = 0;
+                line_ = 1;
+                mark_ = 0;
+            }
+
+            void offset(std::size_t value)
+            {
+                offset_ = value;
+            }
+
+            std::size_t line() const override
+            {
+                scan();
+                return line_;
+            }
+
+            std::size_t column() const override
+            {
+                scan();
+                return (offset_ - mark_) + 1;
+            }
+
+            std::size_t position() const override
+            {
+                return offset_;
+            }
+
+            std::size_t end_position() const override
+            {
+                return offset_;
+            }
+        private:
+            // Counts line breaks as basic_json_parser does, treating \r\n as one
+            void scan() const
+            {
+                if (offset_ < scanned_)
+                {
+                    scanned_ = 0;
+                    line_ = 1;
+                    mark_ = 0;
+                }
+                for (; scanned_ < offset_; ++scanned_)
+                {
+                    if (data_[scanned_] == '\n')
+                    {
+                        ++line_;
+                        mark_ = scanned_ + 1;
+                    }
+                    else if (data_[scanned_] == '\r')
+                    {
+                        ++line_;
+                        if (scanned_ + 1 < offset_ && data_[scanned_ + 1] == '\n')
+                        {
+                            ++scanned_;
+                        }
+                        mark_ = scanned_ + 1;
+                    }
+                }
+            }
+        };
+
+        json_source_adaptor<Source> source_;
+        basic_default_json_visitor<char> default_visitor_;
+        basic_json_visitor<char>& visitor_;
+        basic_json_tape_builder<TempAllocator> builder_;
+        basic_json_tape<TempAllocator> tape_;
+        basic_json_parser<char,TempAllocator> parser_;
+        std::vector<std::pair<std::string,double>> string_double_map_;
+        std::vector<char,char_allocator_type> buffer_;
+        tape_context context_;
+        bool used_parser_;
+
+        // Noncopyable and nonmoveable
+        basic_json_tape_reader(const basic_json_tape_reader&) = delete;
+        basic_json_tape_reader& operator=(const basic_json_tape_reader&) = delete;
+
+    public:
+        template <class Sourceable>
+        explicit basic_json_tape_reader(Sourceable&& source, const TempAllocator& temp_alloc = TempAllocator())
+            : basic_json_tape_reader(std::forward<Sourceable>(source),
+                                     default_visitor_,
+                                     basic_json_decode_options<char>(),
+                                     default_json_parsing(),
+                                     temp_alloc)
+        {
+        }
+
+        template <class Sourceable>
+        basic_json_tape_reader(Sourceable&& source,
+                               basic_json_visitor<char>& visitor,
+                               const TempAllocator& temp_alloc = TempAllocator())
+            : basic_json_tape_reader(std::forward<Sourceable>(source),
+                                     visitor,
+                                     basic_json_decode_options<char>(),
+                                     default_json_parsing(),
+                                     temp_alloc)
+        {
+        }
+
+        template <class Sourceable>
+        basic_json_tape_reader(Sourceable&& source,
+                               basic_json_visitor<char>& visitor,
+                               const basic_json_decode_options<char>& options,
+                               const TempAllocator& temp_alloc = TempAllocator())
+            : basic_json_tape_reader(std::forward<Sourceable>(source),
+                                     visitor,
+                                     options,
+                                     options.err_handler(),
+                                     temp_alloc)
+        {
+        }
+
+        template <class Sourceable>
+        basic_json_tape_reader(Sourceable&& source,
+                               basic_json_visitor<char>& visitor,
+                               const basic_json_decode_options<char>& options,
+                               std::function<bool(json_errc,const ser_context&)> err_handler,
+                               const TempAllocator& temp_alloc = TempAllocator())
+           : source_(std::forward<Sourceable>(source)),
+             visitor_(visitor),
+             builder_(options, temp_alloc),
+             tape_(temp_alloc),
+             parser_(options, err_handler, temp_alloc),
+             buffer_(temp_alloc),
+             used_parser_(false)
+        {
+            if (options.enable_str_to_nan())
+            {
+                string_double_map_.emplace_back(options.nan_to_str(),std::nan(""));
+            }
+            if (options.enable_str_to_inf())
+            {
+                string_double_map_.emplace_back(options.inf_to_str(),std::numeric_limits<double>::infinity());
+            }
+            if (options.enable_str_to_neginf())
+            {
+                string_double_map_.emplace_back(options.neginf_to_str(),-std::numeric_limits<double>::infinity());
+            }
+        }
+
+        std::size_t line() const
+        {
+            return used_parser_ ? parser_.line() : context_.line();
+        }
+
+        std::size_t column() const
+        {
+            return used_parser_ ? parser_.column() : context_.column();
+        }
+
+        void read()
+        {
+            std::error_code ec;
+            read(ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line(),column()));
+            }
+        }
+
+        void read(std::error_code& ec)
+        {
+            if (source_.is_error())
+            {
+                ec = json_errc::source_error;
+                return;
+            }
+            used_parser_ = false;
+
+            span<const char> input = read_input(ec);
+            if (ec) return;
+            context_.reset(input.data());
+
+            std::error_code build_ec;
+            builder_.build(input.data(), input.size(), tape_, build_ec);
+            if (build_ec)
+            {
+                used_parser_ = true;
+                parse(input, ec);
+                return;
+            }
+            replay(ec);
+        }
+
+    private:
+        span<const char> read_input(std::error_code& ec)
+        {
+            auto s = source_.read_buffer(ec);
+            if (ec) return span<const char>();
+            if (source_.eof())
+            {
+                return span<const char>(reinterpret_cast<const char*>(s.data()), s.size());
+            }
+            // The source is not contiguous, collect it
+            buffer_.clear();
+            while (true)
+            {
+                const char* p = reinterpret_cast<const char*>(s.data());
+                buffer_.insert(buffer_.end(), p, p + s.size());
+                if (source_.eof())
+                {
+                    break;
+                }
+                s = source_.read_buffer(ec);
+                if (ec) return span<const char>();
+            }
+            return span<const char>(buffer_.data(), buffer_.size());
+        }
+
+        void parse(span<const char> input, std::error_code& ec)
+        {
+            parser_.reset();
+            parser_.update(input.data(), input.size());
+            while (!parser_.stopped())
+            {
+                bool eof = parser_.source_exhausted();
+                parser_.parse_some(visitor_, ec);
+                if (ec) return;
+                if (eof)
+                {
+                    if (parser_.enter())
+                    {
+                        break;
+                    }
+                    else if (!parser_.accept())
+                    {
+                        ec = json_errc::unexpected_eof;
+                        return;
+                    }
+                }
+            }
+            parser_.check_done(ec);
+        }
+
+        void replay(std::error_code& ec)
+        {
+            const std::size_t n = tape_.size();
+            bool more = true;
+            std::size_t i = 0;
+            while (i < n && more)
+            {
+                context_.offset(tape_.source_offset(i));
+                switch (tape_.type(i))
+                {
+                    case tape_type::begin_object:
+                    {
+                        std::size_t count = tape_.count(i);
+                        more = count < basic_json_tape<TempAllocator>::max_count
+                            ? visitor_.begin_object(count, semantic_tag::none, context_, ec)
+                            : visitor_.begin_object(semantic_tag::none, context_, ec);
+                        ++i;
+                        break;
+                    }
+                    case tape_type::end_object:
+                        more = visitor_.end_object(context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::begin_array:
+                    {
+                        std::size_t count = tape_.count(i);
+                        more = count < basic_json_tape<TempAllocator>::max_count
+                            ? visitor_.begin_array(count, semantic_tag::none, context_, ec)
+                            : visitor_.begin_array(semantic_tag::none, context_, ec);
+                        ++i;
+                        break;
+                    }
+                    case tape_type::end_array:
+                        more = visitor_.end_array(context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::key:
+                        more = visitor_.key(tape_.string(i), context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::string_value:
+                    {
+                        string_view_type sv = tape_.string(i);
+                        auto it = string_double_map_.begin();
+                        while (it != string_double_map_.end() && it->first != sv)
+                        {
+                            ++it;
+                        }
+                        more = it == string_double_map_.end()
+                            ? visitor_.string_value(sv, semantic_tag::none, context_, ec)
+                            : visitor_.double_value(it->second, semantic_tag::none, context_, ec);
+                        ++i;
+                        break;
+                    }
+                    case tape_type::bigint_value:
+                        more = visitor_.string_value(tape_.string(i), semantic_tag::bigint, context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::bigdec_value:
+                        more = visitor_.string_value(tape_.string(i), semantic_tag::bigdec, context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::int64_value:
+                        more = visitor_.int64_value(tape_.int64_value(i), semantic_tag::none, context_, ec);
+                        i += 2;
+                        break;
+                    case tape_type::uint64_value:
+                        more = visitor_.uint64_value(tape_.uint64_value(i), semantic_tag::none, context_, ec);
+                        i += 2;
+                        break;
+                    case tape_type::double_value:
+                        more = visitor_.double_value(tape_.double_value(i), semantic_tag::none, context_, ec);
+                        i += 2;
+                        break;
+                    case tape_type::true_value:
+                        more = visitor_.bool_value(true, semantic_tag::none, context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::false_value:
+                        more = visitor_.bool_value(false, semantic_tag::none, context_, ec);
+                        ++i;
+                        break;
+                    case tape_type::null_value:
+                        more = visitor_.null_value(semantic_tag::none, context_, ec);
+                        ++i;
+                        break;
+                    default:
+                        JSONCONS_UNREACHABLE();
+                        break;
+                }
+                if (ec) return;
+            }
+            if (i == n)
+            {
+                visitor_.flush();
+            }
+        }
+    };
+
+    using json_tape_reader = basic_json_tape_reader<jsoncons::string_source<char>>;
+
+} // namespace jsoncons
+
+#endif
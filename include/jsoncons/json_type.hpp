@@ -110,7 +110,10 @@ namespace jsoncons {
         array_value = 0x09,
         empty_object_value = 0x0a,
         object_value = 0x0b,
-        json_const_pointer = 0x0c
+        json_const_pointer = 0x0c,
+        string_view_value = 0x0d,
+        raw_number_value = 0x0e,
+        packed_array_value = 0x0f
     };
 
     template <class CharT>
@@ -129,6 +132,9 @@ namespace jsoncons {
         static constexpr const CharT* empty_object_value = JSONCONS_CSTRING_CONSTANT(CharT, "empty_object");
         static constexpr const CharT* object_value = JSONCONS_CSTRING_CONSTANT(CharT, "object");
         static constexpr const CharT* json_const_pointer = JSONCONS_CSTRING_CONSTANT(CharT, "json_const_pointer");
+        static constexpr const CharT* string_view_value = JSONCONS_CSTRING_CONSTANT(CharT, "string_view");
+        static constexpr const CharT* raw_number_value = JSONCONS_CSTRING_CONSTANT(CharT, "raw_number");
+        static constexpr const CharT* packed_array_value = JSONCONS_CSTRING_CONSTANT(CharT, "packed_array");
 
         switch (storage)
         {
@@ -197,6 +203,21 @@ namespace jsoncons {
                 os << json_const_pointer;
                 break;
             }
+            case json_storage_kind::string_view_value:
+            {
+                os << string_view_value;
+                break;
+            }
+            case json_storage_kind::raw_number_value:
+            {
+                os << raw_number_value;
+                break;
+            }
+            case json_storage_kind::packed_array_value:
+            {
+                os << packed_array_value;
+                break;
+            }
         }
         return os;
     }
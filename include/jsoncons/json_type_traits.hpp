@@ -31,6 +31,7 @@
 #include <bitset> // std::bitset
 #include <jsoncons/conv_error.hpp>
 #include <jsoncons/value_converter.hpp>
+#include <jsoncons/object_builder.hpp>
 
 #if defined(JSONCONS_HAS_STD_VARIANT)
   #include <variant>
@@ -529,7 +530,18 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
         static bool is(const Json& j) noexcept
         {
             bool result = j.is_array();
-            if (result)
+            if (result && j.storage_kind() == json_storage_kind::packed_array_value)
+            {
+                for (const auto& e : j.array_value_range())
+                {
+                    if (!e.template is<value_type>())
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+            else if (result)
             {
                 for (auto e : j.array_range())
                 {
@@ -553,9 +565,19 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             {
                 T result;
                 visit_reserve_(typename std::integral_constant<bool, extension_traits::has_reserve<T>::value>::type(),result,j.size());
-                for (const auto& item : j.array_range())
+                if (j.storage_kind() == json_storage_kind::packed_array_value && !std::is_same<value_type,Json>::value)
+                {
+                    for (const auto& item : j.array_value_range())
+                    {
+                        result.push_back(item.template as<value_type>());
+                    }
+                }
+                else
                 {
-                    result.push_back(item.template as<value_type>());
+                    for (const auto& item : j.array_range())
+                    {
+                        result.push_back(item.template as<value_type>());
+                    }
                 }
 
                 return result;
@@ -577,9 +599,19 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             {
                 T result;
                 visit_reserve_(typename std::integral_constant<bool, extension_traits::has_reserve<T>::value>::type(),result,j.size());
-                for (const auto& item : j.array_range())
+                if (j.storage_kind() == json_storage_kind::packed_array_value && !std::is_same<value_type,Json>::value)
+                {
+                    for (const auto& item : j.array_value_range())
+                    {
+                        result.push_back(item.template as<value_type>());
+                    }
+                }
+                else
                 {
-                    result.push_back(item.template as<value_type>());
+                    for (const auto& item : j.array_range())
+                    {
+                        result.push_back(item.template as<value_type>());
+                    }
                 }
 
                 return result;
@@ -989,46 +1021,47 @@ has_can_convert = extension_traits::is_detected<traits_can_convert_t, Json, T>;
             return result;
         }
 
+        // The names are in the order of the keys, not of their text, so the object is built in one step
         static Json to_json(const T& val) 
         {
-            Json j(json_object_arg);
-            j.reserve(val.size());
+            object_builder<Json> builder;
+            builder.reserve(val.size());
             for (const auto& item : val)
             {
                 auto temp = json_type_traits<Json,key_type>::to_json(item.first);
                 if (temp.is_string_view())
                 {
-                    j.try_emplace(typename Json::key_type(temp.as_string_view()), item.second);
+                    builder.append(temp.as_string_view(), item.second);
                 }
                 else
                 {
                     typename Json::key_type key;
                     temp.dump(key);
-                    j.try_emplace(std::move(key), item.second);
+                    builder.append(key, item.second);
                 }
             }
-            return j;
+            return builder.finish();
         }
 
         static Json to_json(const T& val, const allocator_type& alloc) 
         {
-            Json j(json_object_arg, semantic_tag::none, alloc);
-            j.reserve(val.size());
+            object_builder<Json> builder(alloc);
+            builder.reserve(val.size());
             for (const auto& item : val)
             {
                 auto temp = json_type_traits<Json, key_type>::to_json(item.first, alloc);
                 if (temp.is_string_view())
                 {
-                    j.try_emplace(typename Json::key_type(temp.as_string_view(), alloc), item.second);
+                    builder.append(temp.as_string_view(), item.second, alloc);
                 }
                 else
                 {
                     typename Json::key_type key(alloc);
                     temp.dump(key);
-                    j.try_emplace(std::move(key), item.second, alloc);
+                    builder.append(key, item.second, alloc);
                 }
             }
-            return j;
+            return builder.finish();
         }
     };
 
@@ -7,6 +7,7 @@
 #ifndef JSONCONS_JSON_VISITOR_HPP
 #define JSONCONS_JSON_VISITOR_HPP
 
+#include <algorithm> // std::find_if
 #include <iostream>
 #include <string>
 #include <utility>
@@ -17,9 +18,49 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/tag_type.hpp>
 #include <jsoncons/byte_string.hpp>
+#include <jsoncons/detail/parse_number.hpp>
 
 namespace jsoncons {
 
+namespace detail {
+
+    // Visits the text of a JSON number as an int64 or uint64 value, a bigint string if it is an integer that 
+    // overflows both, or a double
+    template <class CharT,class Visitor>
+    bool number_text_value(const jsoncons::basic_string_view<CharT>& text, 
+                           semantic_tag tag,
+                           Visitor& visitor,
+                           const ser_context& context,
+                           std::error_code& ec)
+    {
+        const CharT* s = text.data();
+        std::size_t length = text.size();
+        auto is_integer = std::find_if(s, s+length, [](CharT c){return c == '.' || c == 'e' || c == 'E';}) == s+length;
+        if (is_integer)
+        {
+            if (length > 0 && s[0] == '-')
+            {
+                int64_t val;
+                if (jsoncons::detail::to_integer_unchecked(s, length, val))
+                {
+                    return visitor.int64_value(val, tag, context, ec);
+                }
+            }
+            else
+            {
+                uint64_t val;
+                if (jsoncons::detail::to_integer_unchecked(s, length, val))
+                {
+                    return visitor.uint64_value(val, tag, context, ec);
+                }
+            }
+            return visitor.string_value(text, semantic_tag::bigint, context, ec);
+        }
+        return visitor.double_value(jsoncons::detail::number_text_to_double(s, length), tag, context, ec);
+    }
+
+} // namespace detail
+
     template <class CharT>
     class basic_json_visitor
     {
@@ -245,6 +286,20 @@ namespace jsoncons {
             return more;
         }
 
+        // The text of a JSON number, as it appeared in the input
+        bool number_value(const string_view_type& text, 
+                          semantic_tag tag = semantic_tag::none, 
+                          const ser_context& context=ser_context())
+        {
+            std::error_code ec;
+            bool more = visit_number(text, tag, context, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, context.line(), context.column()));
+            }
+            return more;
+        }
+
         bool begin_object(semantic_tag tag,
                           const ser_context& context,
                           std::error_code& ec)
@@ -360,6 +415,14 @@ namespace jsoncons {
             return visit_double(value, tag, context, ec);
         }
 
+        bool number_value(const string_view_type& text, 
+                          semantic_tag tag, 
+                          const ser_context& context,
+                          std::error_code& ec)
+        {
+            return visit_number(text, tag, context, ec);
+        }
+
         template <class T>
         bool typed_array(const jsoncons::span<T>& data, 
                          semantic_tag tag=semantic_tag::none,
@@ -701,6 +764,16 @@ namespace jsoncons {
                                const ser_context& context,
                                std::error_code& ec) = 0;
 
+        // By default converts the text the way the parser does, visitors that  
+        // keep or write the text itself override this
+        virtual bool visit_number(const string_view_type& text, 
+                                  semantic_tag tag,
+                                  const ser_context& context,
+                                  std::error_code& ec)
+        {
+            return jsoncons::detail::number_text_value(text, tag, *this, context, ec);
+        }
+
         virtual bool visit_typed_array(const jsoncons::span<const uint8_t>& s, 
                                     semantic_tag tag,
                                     const ser_context& context, 
@@ -1201,6 +1274,14 @@ namespace jsoncons {
             return more0 && more1;
         }
 
+        bool visit_number(const string_view_type& text, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+        {
+            bool more0 =  destination0_.number_value(text, tag, context, ec);
+            bool more1 =  destination1_.number_value(text, tag, context, ec);
+
+            return more0 && more1;
+        }
+
         bool visit_bool(bool value, semantic_tag tag, const ser_context& context, std::error_code& ec) override
         {
             bool more0 =  destination0_.bool_value(value, tag, context, ec);
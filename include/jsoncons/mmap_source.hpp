@@ -0,0 +1,357 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <algorithm> // std::min
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <string>
+#include <system_error>
+#include <type_traits> // std::enable_if
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/extension_traits.hpp>
+#include <jsoncons/source.hpp>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // mapped_file
+    // A read-only mapping of a whole file, with the system told that it will be read sequentially
+
+    class mapped_file
+    {
+        const void* data_;
+        std::size_t size_;
+
+        // Noncopyable
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+    public:
+        mapped_file() noexcept
+            : data_(nullptr), size_(0)
+        {
+        }
+
+        mapped_file(mapped_file&& other) noexcept
+            : data_(other.data_), size_(other.size_)
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            return *this;
+        }
+
+        ~mapped_file() noexcept
+        {
+            unmap();
+        }
+
+        const void* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        // An empty file is not mapped
+        void map(const std::string& path, std::error_code& ec)
+        {
+            unmap();
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                ec = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                return;
+            }
+            LARGE_INTEGER file_size;
+            if (!::GetFileSizeEx(file, &file_size))
+            {
+                ec = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                ::CloseHandle(file);
+                return;
+            }
+            if (file_size.QuadPart == 0)
+            {
+                ::CloseHandle(file);
+                return;
+            }
+            HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            ::CloseHandle(file);
+            if (mapping == nullptr)
+            {
+                ec = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                return;
+            }
+            const void* p = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping);
+            if (p == nullptr)
+            {
+                ec = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                return;
+            }
+            data_ = p;
+            size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                ::close(fd);
+                return;
+            }
+            if (st.st_size == 0)
+            {
+                ::close(fd);
+                return;
+            }
+            std::size_t size = static_cast<std::size_t>(st.st_size);
+            void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            // The mapping keeps the file open
+            ::close(fd);
+            if (p == MAP_FAILED)
+            {
+                ec = std::error_code(errno, std::generic_category());
+                return;
+            }
+            // Only advice, so a failure is ignored
+            ::madvise(p, size, MADV_SEQUENTIAL);
+            data_ = p;
+            size_ = size;
+#endif
+        }
+
+        void unmap() noexcept
+        {
+            if (data_ != nullptr)
+            {
+#if defined(_WIN32)
+                ::UnmapViewOfFile(data_);
+#else
+                ::munmap(const_cast<void*>(data_), size_);
+#endif
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+    };
+
+} // namespace detail
+
+    // basic_mmap_source
+    // Maps a file read-only and presents it as one contiguous sequence. It may be used as the Source of a reader
+    // or cursor, or, as it has data() and size(), passed wherever a string or byte sequence is accepted.
+
+    template <class CharT>
+    class basic_mmap_source
+    {
+    public:
+        using value_type = CharT;
+        using const_iterator = const value_type*;
+        using iterator = const_iterator;
+    private:
+        detail::mapped_file file_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+        bool is_error_;
+
+        // Noncopyable
+        basic_mmap_source(const basic_mmap_source&) = delete;
+        basic_mmap_source& operator=(const basic_mmap_source&) = delete;
+    public:
+        basic_mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr), is_error_(false)
+        {
+        }
+
+        explicit basic_mmap_source(const std::string& path)
+            : data_(nullptr), current_(nullptr), end_(nullptr), is_error_(false)
+        {
+            std::error_code ec;
+            open(path, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(std::system_error(ec, "Cannot map " + path));
+            }
+        }
+
+        basic_mmap_source(const std::string& path, std::error_code& ec)
+            : data_(nullptr), current_(nullptr), end_(nullptr), is_error_(false)
+        {
+            open(path, ec);
+        }
+
+        basic_mmap_source(basic_mmap_source&& other) noexcept
+            : file_(std::move(other.file_)), data_(other.data_), current_(other.current_), end_(other.end_), is_error_(other.is_error_)
+        {
+            other.data_ = other.current_ = other.end_ = nullptr;
+        }
+
+        basic_mmap_source& operator=(basic_mmap_source&& other) noexcept
+        {
+            file_ = std::move(other.file_);
+            std::swap(data_, other.data_);
+            std::swap(current_, other.current_);
+            std::swap(end_, other.end_);
+            std::swap(is_error_, other.is_error_);
+            return *this;
+        }
+
+        // The whole file
+
+        const value_type* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(end_ - data_);
+        }
+
+        const_iterator begin() const
+        {
+            return data_;
+        }
+
+        const_iterator end() const
+        {
+            return end_;
+        }
+
+        template <class T = CharT>
+        operator jsoncons::basic_string_view<typename std::enable_if<extension_traits::is_character<T>::value,T>::type>() const
+        {
+            return jsoncons::basic_string_view<T>(data_, size());
+        }
+
+        // Source interface
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        std::size_t position() const
+        {
+            return static_cast<std::size_t>(current_ - data_);
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if (std::size_t(end_ - current_) < count)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = count;
+            }
+            current_ += len;
+        }
+
+        char_result<value_type> peek()
+        {
+            return current_ < end_ ? char_result<value_type>{*current_, false} : char_result<value_type>{0, true};
+        }
+
+        span<const value_type> read_buffer()
+        {
+            const value_type* data = current_;
+            std::size_t length = end_ - current_;
+            current_ = end_;
+
+            return span<const value_type>(data, length);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if (std::size_t(end_ - current_) < length)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = length;
+            }
+            std::memcpy(p, current_, len*sizeof(value_type));
+            current_  += len;
+            return len;
+        }
+
+        // Returns the next length values, or as many as are left, without copying them
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(length, std::size_t(end_ - current_));
+            current_ += len;
+            return span<const value_type>(data, len);
+        }
+
+    private:
+        void open(const std::string& path, std::error_code& ec)
+        {
+            file_.map(path, ec);
+            if (ec)
+            {
+                is_error_ = true;
+                return;
+            }
+            data_ = current_ = static_cast<const value_type*>(file_.data());
+            end_ = data_ + file_.size()/sizeof(value_type);
+        }
+    };
+
+    using mmap_source = basic_mmap_source<char>;
+    using mmap_bytes_source = basic_mmap_source<uint8_t>;
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,85 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_OBJECT_BUILDER_HPP
+#define JSONCONS_OBJECT_BUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory> // std::allocator_traits
+#include <utility> // std::forward
+#include <vector>
+#include <jsoncons/tag_type.hpp>
+#include <jsoncons/json_object.hpp>
+
+namespace jsoncons {
+
+    // object_builder
+    // Collects members in any order and builds an object from them in one step, sorting
+    // and removing duplicate names once instead of searching the object on every insertion.
+
+    template <class Json>
+    class object_builder
+    {
+    public:
+        using json_type = Json;
+        using allocator_type = typename Json::allocator_type;
+        using key_type = typename Json::key_type;
+        using string_view_type = typename Json::string_view_type;
+    private:
+        using item_type = index_key_value<Json>;
+        using item_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<item_type>;
+
+        allocator_type alloc_;
+        std::vector<item_type,item_allocator_type> items_;
+    public:
+        explicit object_builder(const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), items_(item_allocator_type(alloc))
+        {
+        }
+
+        object_builder(const object_builder&) = delete;
+        object_builder(object_builder&&) = default;
+        object_builder& operator=(const object_builder&) = delete;
+        object_builder& operator=(object_builder&&) = default;
+
+        void reserve(std::size_t n)
+        {
+            items_.reserve(n);
+        }
+
+        // Number of members appended, including duplicates
+        std::size_t size() const noexcept
+        {
+            return items_.size();
+        }
+
+        // Appends a member, the value is constructed from args. If a name is appended
+        // more than once, the first value is kept, as with try_emplace.
+        template <class... Args>
+        void append(const string_view_type& name, Args&&... args)
+        {
+            items_.emplace_back(key_type(name.begin(), name.end(), alloc_),
+                static_cast<int64_t>(items_.size()), std::forward<Args>(args)...);
+        }
+
+        // Returns the object and leaves the builder empty
+        Json finish()
+        {
+            Json j(json_object_arg, semantic_tag::none, alloc_);
+            if (!items_.empty())
+            {
+                j.template cast<typename Json::object_storage>().value().uninitialized_init(
+                    items_.data(), items_.size());
+                items_.clear();
+            }
+            return j;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
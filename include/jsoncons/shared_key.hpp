@@ -0,0 +1,477 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SHARED_KEY_HPP
+#define JSONCONS_SHARED_KEY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional> // std::hash, std::equal_to
+#include <iterator> // std::iterator_traits
+#include <memory> // std::allocator
+#include <ostream>
+#include <string>
+#include <type_traits> // std::enable_if
+#include <unordered_map>
+#include <utility> // std::move, std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/heap_string.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // shared_key_count
+    // The reference count kept in the heap block of a basic_shared_key
+
+    class shared_key_count
+    {
+        mutable std::atomic<std::size_t> count_;
+    public:
+        shared_key_count() noexcept
+            : count_(1)
+        {
+        }
+
+        shared_key_count(const shared_key_count& other) noexcept
+            : count_(other.count_.load(std::memory_order_relaxed))
+        {
+        }
+
+        shared_key_count& operator=(const shared_key_count&) = delete;
+
+        void add_ref() const noexcept
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Returns true when the last reference is released
+        bool release() const noexcept
+        {
+            return count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        std::size_t use_count() const noexcept
+        {
+            return count_.load(std::memory_order_relaxed);
+        }
+    };
+
+} // namespace detail
+
+    // basic_shared_key
+    // An immutable string whose characters are held in one reference counted allocation, so that copies
+    // share it. Used as the member_key of shared_key_policy, it lets a decoder give every occurrence of
+    // an object member name the same allocation.
+
+    template <class CharT, class Traits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+    class basic_shared_key
+    {
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = const CharT&;
+        using reference = const_reference;
+        using const_pointer = const CharT*;
+        using pointer = const_pointer;
+        using const_iterator = const CharT*;
+        using iterator = const_iterator;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+    private:
+        using heap_string_factory_type = jsoncons::detail::heap_string_factory<CharT,detail::shared_key_count,Allocator>;
+        using heap_string_pointer = typename heap_string_factory_type::pointer;
+
+        heap_string_pointer ptr_;
+        allocator_type alloc_;
+    public:
+        basic_shared_key() noexcept
+            : ptr_(nullptr), alloc_()
+        {
+        }
+
+        explicit basic_shared_key(const Allocator& alloc) noexcept
+            : ptr_(nullptr), alloc_(alloc)
+        {
+        }
+
+        basic_shared_key(const CharT* s, size_type length, const Allocator& alloc = Allocator())
+            : ptr_(create(s, length, alloc)), alloc_(alloc)
+        {
+        }
+
+        explicit basic_shared_key(const CharT* s, const Allocator& alloc = Allocator())
+            : ptr_(create(s, Traits::length(s), alloc)), alloc_(alloc)
+        {
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        basic_shared_key(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+            : ptr_(create(first, last, alloc)), alloc_(alloc)
+        {
+        }
+
+        explicit basic_shared_key(const string_view_type& sv, const Allocator& alloc = Allocator())
+            : ptr_(create(sv.data(), sv.size(), alloc)), alloc_(alloc)
+        {
+        }
+
+        template <class SAllocator>
+        explicit basic_shared_key(const std::basic_string<CharT,Traits,SAllocator>& s, const Allocator& alloc = Allocator())
+            : ptr_(create(s.data(), s.size(), alloc)), alloc_(alloc)
+        {
+        }
+
+        basic_shared_key(const basic_shared_key& other) noexcept
+            : ptr_(other.ptr_), alloc_(other.alloc_)
+        {
+            add_ref();
+        }
+
+        // Shares the allocation when the allocators compare equal, otherwise copies it
+        basic_shared_key(const basic_shared_key& other, const Allocator& alloc)
+            : ptr_(nullptr), alloc_(alloc)
+        {
+            if (alloc == other.alloc_)
+            {
+                ptr_ = other.ptr_;
+                add_ref();
+            }
+            else
+            {
+                ptr_ = create(other.data(), other.size(), alloc);
+            }
+        }
+
+        basic_shared_key(basic_shared_key&& other) noexcept
+            : ptr_(other.ptr_), alloc_(other.alloc_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        basic_shared_key(basic_shared_key&& other, const Allocator& alloc)
+            : ptr_(nullptr), alloc_(alloc)
+        {
+            if (alloc == other.alloc_)
+            {
+                ptr_ = other.ptr_;
+                other.ptr_ = nullptr;
+            }
+            else
+            {
+                ptr_ = create(other.data(), other.size(), alloc);
+            }
+        }
+
+        ~basic_shared_key() noexcept
+        {
+            release();
+        }
+
+        basic_shared_key& operator=(const basic_shared_key& other) noexcept
+        {
+            basic_shared_key(other).swap(*this);
+            return *this;
+        }
+
+        basic_shared_key& operator=(basic_shared_key&& other) noexcept
+        {
+            basic_shared_key(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        void swap(basic_shared_key& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(alloc_, other.alloc_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        const CharT* data() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->data() : empty_string();
+        }
+
+        const CharT* c_str() const noexcept
+        {
+            return data();
+        }
+
+        size_type size() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->length() : 0;
+        }
+
+        size_type length() const noexcept
+        {
+            return size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        const_reference operator[](size_type pos) const
+        {
+            return data()[pos];
+        }
+
+        // The number of keys sharing this allocation, 0 for an empty key
+        size_type use_count() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->extra_.use_count() : 0;
+        }
+
+        // Bytes allocated for the characters, which may be shared with other keys
+        size_type allocated_bytes() const noexcept
+        {
+            return ptr_ != nullptr ? heap_string_factory_type::allocation_size(size()) : 0;
+        }
+
+        // Keys are immutable, so there is nothing to shrink
+        void shrink_to_fit() noexcept
+        {
+        }
+
+        int compare(const string_view_type& s) const noexcept
+        {
+            return string_view_type(data(), size()).compare(s);
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), size());
+        }
+
+        template <class SAllocator>
+        explicit operator std::basic_string<CharT,Traits,SAllocator>() const
+        {
+            return std::basic_string<CharT,Traits,SAllocator>(data(), size());
+        }
+
+        friend bool operator==(const basic_shared_key& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_ || lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator==(const basic_shared_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator==(const string_view_type& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) == 0;
+        }
+
+        friend bool operator!=(const basic_shared_key& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator!=(const basic_shared_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) != 0;
+        }
+
+        friend bool operator!=(const string_view_type& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) != 0;
+        }
+
+        friend bool operator<(const basic_shared_key& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend bool operator<(const basic_shared_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend bool operator<(const string_view_type& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) > 0;
+        }
+
+        friend bool operator<=(const basic_shared_key& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+
+        friend bool operator>(const basic_shared_key& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+
+        friend bool operator>=(const basic_shared_key& lhs, const basic_shared_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_shared_key& key)
+        {
+            os.write(key.data(), key.size());
+            return os;
+        }
+    private:
+        static const CharT* empty_string() noexcept
+        {
+            static const CharT s[1] = {0};
+            return s;
+        }
+
+        static heap_string_pointer create(const CharT* s, size_type length, const Allocator& alloc)
+        {
+            return length == 0 ? heap_string_pointer(nullptr) : heap_string_factory_type::create(s, length, detail::shared_key_count(), alloc);
+        }
+
+        static heap_string_pointer create(const CharT* first, const CharT* last, const Allocator& alloc)
+        {
+            return create(first, static_cast<size_type>(last - first), alloc);
+        }
+
+        template <class InputIt>
+        static heap_string_pointer create(InputIt first, InputIt last, const Allocator& alloc)
+        {
+            std::basic_string<CharT,Traits,Allocator> s(first, last, alloc);
+            return create(s.data(), s.size(), alloc);
+        }
+
+        void add_ref() const noexcept
+        {
+            if (ptr_ != nullptr)
+            {
+                ptr_->extra_.add_ref();
+            }
+        }
+
+        void release() noexcept
+        {
+            if (ptr_ != nullptr && ptr_->extra_.release())
+            {
+                heap_string_factory_type::destroy(ptr_);
+            }
+            ptr_ = nullptr;
+        }
+    };
+
+    template <class CharT, class Traits, class Allocator>
+    void swap(basic_shared_key<CharT,Traits,Allocator>& a, basic_shared_key<CharT,Traits,Allocator>& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    using shared_key = basic_shared_key<char>;
+    using wshared_key = basic_shared_key<wchar_t>;
+
+    // shared_key_policy
+    // Adapts an object policy, such as sorted_policy or order_preserving_policy, to use basic_shared_key
+    // for object member names
+
+    template <class Policy>
+    struct shared_key_policy : public Policy
+    {
+        template <class CharT, class CharTraits, class Allocator>
+        using member_key = basic_shared_key<CharT, CharTraits, Allocator>;
+    };
+
+    template <class Key>
+    struct is_shared_key : std::false_type
+    {
+    };
+
+    template <class CharT, class Traits, class Allocator>
+    struct is_shared_key<basic_shared_key<CharT,Traits,Allocator>> : std::true_type
+    {
+    };
+
+namespace detail {
+
+    // shared_key_table
+    // Maps member names to the shared keys a decoder has already made for them. It stops growing
+    // at max_size distinct names; after that, keys for new names are made but not remembered.
+
+    template <class Key, class TempAllocator>
+    class shared_key_table
+    {
+    public:
+        using key_type = Key;
+        using char_type = typename Key::value_type;
+        using allocator_type = typename Key::allocator_type;
+        using string_view_type = jsoncons::basic_string_view<char_type,typename Key::traits_type>;
+    private:
+        using value_type = std::pair<const string_view_type,key_type>;
+        using map_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<value_type>;
+
+        std::unordered_map<string_view_type,key_type,std::hash<string_view_type>,std::equal_to<string_view_type>,map_allocator_type> map_;
+        std::size_t max_size_;
+    public:
+        shared_key_table(std::size_t max_size, const TempAllocator& temp_alloc)
+            : map_(0, std::hash<string_view_type>(), std::equal_to<string_view_type>(), map_allocator_type(temp_alloc)),
+              max_size_(max_size)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return map_.size();
+        }
+
+        std::size_t max_size() const
+        {
+            return max_size_;
+        }
+
+        void max_size(std::size_t value)
+        {
+            max_size_ = value;
+        }
+
+        key_type get(const string_view_type& name, const allocator_type& alloc)
+        {
+            auto it = map_.find(name);
+            if (it != map_.end() && it->second.get_allocator() == alloc)
+            {
+                return it->second;
+            }
+            key_type key(name.data(), name.size(), alloc);
+            if (it == map_.end() && map_.size() < max_size_ && !key.empty())
+            {
+                // The map's key refers to the characters of the shared key it maps to
+                map_.emplace(string_view_type(key.data(), key.size()), key);
+            }
+            return key;
+        }
+
+        void clear()
+        {
+            map_.clear();
+        }
+    };
+
+} // namespace detail
+
+} // namespace jsoncons
+
+#endif
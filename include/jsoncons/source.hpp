@@ -7,6 +7,7 @@
 #ifndef JSONCONS_SOURCE_HPP
 #define JSONCONS_SOURCE_HPP
 
+#include <algorithm> // std::min
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -16,6 +17,7 @@
 #include <exception>
 #include <iterator>
 #include <type_traits> // std::enable_if
+#include <utility> // std::declval
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/byte_string.hpp> // jsoncons::byte_traits
 #include <jsoncons/extension_traits.hpp>
@@ -395,6 +397,15 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        // Returns the next length characters, or as many as are left, without copying them
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(length, std::size_t(end_ - current_));
+            current_ += len;
+            return span<const value_type>(data, len);
+        }
     };
 
     // iterator source
@@ -605,6 +616,15 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        // Returns the next length bytes, or as many as are left, without copying them
+        span<const value_type> read_span(std::size_t length)
+        {
+            const value_type* data = current_;
+            std::size_t len = (std::min)(length, std::size_t(end_ - current_));
+            current_ += len;
+            return span<const value_type>(data, len);
+        }
     };
 
     // binary_iterator source
@@ -720,12 +740,45 @@ namespace jsoncons {
         }
     };
 
+    // is_contiguous_source
+    // A source over one contiguous buffer, with read_span(length) returning a view of the next length values 
+
+    template <class Source>
+    using source_read_span_t = decltype(std::declval<Source&>().read_span(std::size_t()));
+
+    template <class Source>
+    using is_contiguous_source = extension_traits::is_detected_exact<span<const typename Source::value_type>,source_read_span_t,Source>;
+
     template <class Source>
     struct source_reader
     {
         using value_type = typename Source::value_type;
         static constexpr std::size_t max_buffer_length = 16384;
 
+        // Returns a view of the next length values. The view refers to the source if it is contiguous, 
+        // otherwise the values are read into v, which is cleared first. Fewer values are returned at the end.
+        template <class Container>
+        static
+        typename std::enable_if<is_contiguous_source<Source>::value && 
+                                sizeof(value_type) == sizeof(typename Container::value_type), 
+                                span<const typename Container::value_type>>::type
+        read_view(Source& source, Container&, std::size_t length)
+        {
+            auto s = source.read_span(length);
+            return span<const typename Container::value_type>(reinterpret_cast<const typename Container::value_type*>(s.data()), s.size());
+        }
+
+        template <class Container>
+        static
+        typename std::enable_if<!is_contiguous_source<Source>::value, 
+                                span<const typename Container::value_type>>::type
+        read_view(Source& source, Container& v, std::size_t length)
+        {
+            v.clear();
+            std::size_t n = read(source, v, length);
+            return span<const typename Container::value_type>(v.data(), n);
+        }
+
         template <class Container>
         static
         typename std::enable_if<std::is_convertible<value_type,typename Container::value_type>::value &&
@@ -55,6 +55,20 @@ struct json_object_arg_t
 
 constexpr json_object_arg_t json_object_arg{};
 
+struct packed_array_arg_t
+{
+    explicit packed_array_arg_t() = default; 
+};
+
+constexpr packed_array_arg_t packed_array_arg{};
+
+struct nan_boxed_array_arg_t
+{
+    explicit nan_boxed_array_arg_t() = default; 
+};
+
+constexpr nan_boxed_array_arg_t nan_boxed_array_arg{};
+
 struct byte_string_arg_t
 {
     explicit byte_string_arg_t() = default; 
@@ -68,6 +82,20 @@ struct json_const_pointer_arg_t
 };
 
 constexpr json_const_pointer_arg_t json_const_pointer_arg{};
+
+struct string_view_arg_t
+{
+    explicit string_view_arg_t() = default; 
+};
+
+constexpr string_view_arg_t string_view_arg{};
+
+struct number_text_arg_t
+{
+    explicit number_text_arg_t() = default; 
+};
+
+constexpr number_text_arg_t number_text_arg{};
  
 enum class semantic_tag : uint8_t 
 {
@@ -1255,6 +1255,7 @@ private:
                     break;
             }
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1285,6 +1286,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             std::memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1315,6 +1317,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint32_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(uint32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1345,6 +1348,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint64_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(uint64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1373,6 +1377,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int8_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int8_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1403,6 +1408,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int16_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1433,6 +1439,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int32_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1463,6 +1470,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int64_t));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(int64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1493,6 +1501,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             std::memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1523,6 +1532,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(float));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(float));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1553,6 +1563,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(double));
             std::memcpy(v.data(), data.data(), data.size()*sizeof(double));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
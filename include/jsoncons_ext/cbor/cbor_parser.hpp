@@ -20,6 +20,7 @@
 #include <jsoncons_ext/cbor/cbor_detail.hpp>
 #include <jsoncons_ext/cbor/cbor_options.hpp>
 #include <jsoncons/item_event_visitor.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
 
 namespace jsoncons { namespace cbor {
 
@@ -466,6 +467,36 @@ private:
             }
             case jsoncons::cbor::detail::cbor_major_type::text_string:
             {
+                // Outside a stringref namespace, a definite length string from a contiguous source 
+                // is passed on without copying
+                if (info != jsoncons::cbor::detail::additional_info::indefinite_length && stringref_map_stack_.empty())
+                {
+                    std::size_t length = get_size(ec);
+                    if (!more_)
+                    {
+                        return;
+                    }
+                    auto s = source_reader<Source>::read_view(source_, text_buffer_, length);
+                    if (s.size() != length)
+                    {
+                        ec = cbor_errc::unexpected_eof;
+                        more_ = false;
+                        return;
+                    }
+                    auto result = jsoncons::detail::fast_validate(s.data(),s.size());
+                    if (result.ec != unicode_traits::conv_errc())
+                    {
+                        ec = cbor_errc::invalid_utf8_text_string;
+                        more_ = false;
+                        return;
+                    }
+                    handle_string(visitor, jsoncons::basic_string_view<char>(s.data(),s.size()),ec);
+                    if (ec)
+                    {
+                        return;
+                    }
+                    break;
+                }
                 text_buffer_.clear();
 
                 read_text_string(text_buffer_, ec);
@@ -473,7 +504,7 @@ private:
                 {
                     return;
                 }
-                auto result = unicode_traits::validate(text_buffer_.data(),text_buffer_.size());
+                auto result = jsoncons::detail::fast_validate(text_buffer_.data(),text_buffer_.size());
                 if (result.ec != unicode_traits::conv_errc())
                 {
                     ec = cbor_errc::invalid_utf8_text_string;
@@ -30,6 +30,7 @@ namespace cbor {
                 const cbor_decode_options& options = cbor_decode_options())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_cbor_reader<jsoncons::bytes_source> reader(v, adaptor, options);
         reader.read();
@@ -64,6 +65,7 @@ namespace cbor {
                 const cbor_decode_options& options = cbor_decode_options())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         cbor_stream_reader reader(is, adaptor, options);
         reader.read();
@@ -97,6 +99,7 @@ namespace cbor {
                 const cbor_decode_options& options = cbor_decode_options())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_cbor_reader<binary_iterator_source<InputIt>> reader(binary_iterator_source<InputIt>(first, last), adaptor, options);
         reader.read();
@@ -134,6 +137,7 @@ namespace cbor {
                 const cbor_decode_options& options = cbor_decode_options())
     {
         json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_cbor_reader<jsoncons::bytes_source,TempAllocator> reader(v, adaptor, options, alloc_set.get_temp_allocator());
         reader.read();
@@ -170,6 +174,7 @@ namespace cbor {
                 const cbor_decode_options& options = cbor_decode_options())
     {
         json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_cbor_reader<jsoncons::binary_stream_source,TempAllocator> reader(is, adaptor, options, alloc_set.get_temp_allocator());
         reader.read();
@@ -2369,29 +2369,13 @@ namespace detail {
         using function_base_type = function_base<Json>;
         using selector_type = jsonpath_selector<Json,JsonReference>;
 
-        struct MyHash
-        {
-            std::uintmax_t operator()(string_type const& s) const noexcept
-            {
-                const int p = 31;
-                const int m = static_cast<int>(1e9) + 9;
-                std::uintmax_t hash_value = 0;
-                std::uintmax_t p_pow = 1;
-                for (char_type c : s) {
-                    hash_value = (hash_value + (c - 'a' + 1) * p_pow) % m;
-                    p_pow = (p_pow * p) % m;
-                }
-                return hash_value;   
-            }
-        };
-
         allocator_type alloc_;
         std::vector<std::unique_ptr<selector_type>> selectors_;
         std::vector<std::unique_ptr<Json>> temp_json_values_;
         std::vector<std::unique_ptr<unary_operator<Json,JsonReference>>> unary_operators_;
 
-        std::unordered_map<string_type,std::unique_ptr<function_base_type>,MyHash> functions_;
-        std::unordered_map<string_type,std::unique_ptr<function_base_type>,MyHash> custom_functions_;
+        std::unordered_map<string_type,std::unique_ptr<function_base_type>,jsoncons::detail::string_hash> functions_;
+        std::unordered_map<string_type,std::unique_ptr<function_base_type>,jsoncons::detail::string_hash> custom_functions_;
 
         static_resources(const allocator_type& alloc = allocator_type())
             : alloc_(alloc)
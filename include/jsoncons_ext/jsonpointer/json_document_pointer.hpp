@@ -0,0 +1,132 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONPOINTER_JSON_DOCUMENT_POINTER_HPP
+#define JSONCONS_JSONPOINTER_JSON_DOCUMENT_POINTER_HPP
+
+#include <string>
+#include <system_error> // system_error
+#include <type_traits> // std::enable_if
+#include <jsoncons/json_document.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+
+// jsonpointer get and contains for views of a json_document, kept apart from jsonpointer.hpp
+// so that basic_json users do not pull in the document and its parser
+
+namespace jsoncons { namespace jsonpointer {
+
+    // get
+
+    template<class Allocator>
+    basic_json_document_view<Allocator> get(basic_json_document_view<Allocator> root, 
+                                            const basic_json_pointer<char>& location, 
+                                            std::error_code& ec)
+    {
+        basic_json_document_view<Allocator> current = root;
+        for (const auto& buffer : location)
+        {
+            if (current.is_array())
+            {
+                if (buffer.size() == 1 && buffer[0] == '-')
+                {
+                    ec = jsonpointer_errc::index_exceeds_array_size;
+                    return current;
+                }
+                std::size_t index{0};
+                auto result = jsoncons::detail::to_integer_decimal(buffer.data(), buffer.length(), index);
+                if (!result)
+                {
+                    ec = jsonpointer_errc::invalid_index;
+                    return current;
+                }
+                if (index >= current.size())
+                {
+                    ec = jsonpointer_errc::index_exceeds_array_size;
+                    return current;
+                }
+                current = current.at(index);
+            }
+            else if (current.is_object())
+            {
+                auto it = current.find(buffer);
+                if (it == current.object_range().end())
+                {
+                    ec = jsonpointer_errc::key_not_found;
+                    return current;
+                }
+                current = it->value();
+            }
+            else
+            {
+                ec = jsonpointer_errc::expected_object_or_array;
+                return current;
+            }
+        }
+        return current;
+    }
+
+    template<class Allocator, class StringSource>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<char>>::value,basic_json_document_view<Allocator>>::type
+    get(basic_json_document_view<Allocator> root, 
+        const StringSource& location_str, 
+        std::error_code& ec)
+    {
+        auto jsonptr = basic_json_pointer<char>::parse(location_str, ec);
+        if (ec)
+        {
+            return root;
+        }
+        return get(root, jsonptr, ec);
+    }
+
+    template<class Allocator>
+    basic_json_document_view<Allocator> get(basic_json_document_view<Allocator> root, const basic_json_pointer<char>& location)
+    {
+        std::error_code ec;
+        auto j = get(root, location, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+        return j;
+    }
+
+    template<class Allocator, class StringSource>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<char>>::value,basic_json_document_view<Allocator>>::type
+    get(basic_json_document_view<Allocator> root, const StringSource& location_str)
+    {
+        std::error_code ec;
+        auto j = get(root, location_str, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(jsonpointer_error(ec));
+        }
+        return j;
+    }
+
+    // contains
+
+    template<class Allocator>
+    bool contains(basic_json_document_view<Allocator> root, const basic_json_pointer<char>& location)
+    {
+        std::error_code ec;
+        get(root, location, ec);
+        return !ec ? true : false;
+    }
+
+    template<class Allocator, class StringSource>
+    typename std::enable_if<std::is_convertible<StringSource,jsoncons::basic_string_view<char>>::value,bool>::type
+    contains(basic_json_document_view<Allocator> root, const StringSource& location_str)
+    {
+        std::error_code ec;
+        get(root, location_str, ec);
+        return !ec ? true : false;
+    }
+
+} // namespace jsonpointer
+} // namespace jsoncons
+
+#endif
@@ -15,6 +15,7 @@
 #include <jsoncons_ext/jsonschema/common/keyword_validator.hpp>
 #include <cassert>
 #include <set>
+#include <unordered_map>
 #include <sstream>
 #include <iostream>
 #include <cassert>
@@ -536,15 +537,22 @@ namespace jsonschema {
 
         static bool array_has_unique_items(const Json& a) 
         {
-            for (auto it = a.array_range().begin(); it != a.array_range().end(); ++it) 
+            // Equal items hash equal, so only items with the same hash are compared
+            json_hash_cache<Json> cache;
+            std::unordered_multimap<std::size_t,const Json*> seen;
+            seen.reserve(a.size());
+            for (const auto& item : a.array_range()) 
             {
-                for (auto jt = it+1; jt != a.array_range().end(); ++jt) 
+                std::size_t h = cache.hash(item);
+                auto range = seen.equal_range(h);
+                for (auto it = range.first; it != range.second; ++it)
                 {
-                    if (*it == *jt) 
+                    if (cache.deep_equal(*it->second, item))
                     {
                         return false; // contains duplicates 
                     }
                 }
+                seen.emplace(h, std::addressof(item));
             }
             return true; // elements are unique
         }
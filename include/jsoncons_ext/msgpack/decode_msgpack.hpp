@@ -29,6 +29,7 @@ namespace msgpack {
                    const msgpack_decode_options& options = msgpack_decode_options())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_msgpack_reader<jsoncons::bytes_source> reader(v, adaptor, options);
         reader.read();
@@ -63,6 +64,7 @@ namespace msgpack {
                    const msgpack_decode_options& options = msgpack_decode_options())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         msgpack_stream_reader reader(is, adaptor, options);
         reader.read();
@@ -96,6 +98,7 @@ namespace msgpack {
                 const msgpack_decode_options& options = msgpack_decode_options())
     {
         jsoncons::json_decoder<T> decoder;
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_msgpack_reader<binary_iterator_source<InputIt>> reader(binary_iterator_source<InputIt>(first, last), adaptor, options);
         reader.read();
@@ -133,6 +136,7 @@ namespace msgpack {
                    const msgpack_decode_options& options = msgpack_decode_options())
     {
         json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_msgpack_reader<jsoncons::bytes_source,TempAllocator> reader(v, adaptor, options, alloc_set.get_temp_allocator());
         reader.read();
@@ -169,6 +173,7 @@ namespace msgpack {
                    const msgpack_decode_options& options = msgpack_decode_options())
     {
         json_decoder<T,TempAllocator> decoder(alloc_set.get_allocator(), alloc_set.get_temp_allocator());
+        decoder.max_length_hint(options.max_length_hint());
         auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
         basic_msgpack_reader<jsoncons::binary_stream_source,TempAllocator> reader(is, adaptor, options, alloc_set.get_temp_allocator());
         reader.read();
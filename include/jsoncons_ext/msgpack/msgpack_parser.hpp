@@ -20,6 +20,7 @@
 #include <jsoncons_ext/msgpack/msgpack_error.hpp>
 #include <jsoncons_ext/msgpack/msgpack_options.hpp>
 #include <jsoncons/item_event_visitor.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
 
 namespace jsoncons { namespace msgpack {
 
@@ -234,23 +235,23 @@ private:
                 // fixstr
                 const size_t len = type & 0x1f;
 
-                text_buffer_.clear();
-
-                if (source_reader<Source>::read(source_,text_buffer_,len) != static_cast<std::size_t>(len))
+                // A view into a contiguous source, otherwise read into text_buffer_
+                auto s = source_reader<Source>::read_view(source_,text_buffer_,len);
+                if (s.size() != len)
                 {
                     ec = msgpack_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
 
-                auto result = unicode_traits::validate(text_buffer_.data(),text_buffer_.size());
+                auto result = jsoncons::detail::fast_validate(s.data(),s.size());
                 if (result.ec != unicode_traits::conv_errc())
                 {
                     ec = msgpack_errc::invalid_utf8_text_string;
                     more_ = false;
                     return;
                 }
-                more_ = visitor.string_value(jsoncons::basic_string_view<char>(text_buffer_.data(),text_buffer_.length()), semantic_tag::none, *this, ec);
+                more_ = visitor.string_value(jsoncons::basic_string_view<char>(s.data(),s.size()), semantic_tag::none, *this, ec);
             }
         }
         else if (type >= 0xe0) 
@@ -426,22 +427,22 @@ private:
                         return;
                     }
 
-                    text_buffer_.clear();
-                    if (source_reader<Source>::read(source_,text_buffer_,len) != static_cast<std::size_t>(len))
+                    auto s = source_reader<Source>::read_view(source_,text_buffer_,len);
+                    if (s.size() != len)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
 
-                    auto result = unicode_traits::validate(text_buffer_.data(),text_buffer_.size());
+                    auto result = jsoncons::detail::fast_validate(s.data(),s.size());
                     if (result.ec != unicode_traits::conv_errc())
                     {
                         ec = msgpack_errc::invalid_utf8_text_string;
                         more_ = false;
                         return;
                     }
-                    more_ = visitor.string_value(jsoncons::basic_string_view<char>(text_buffer_.data(),text_buffer_.length()), semantic_tag::none, *this, ec);
+                    more_ = visitor.string_value(jsoncons::basic_string_view<char>(s.data(),s.size()), semantic_tag::none, *this, ec);
                     break;
                 }
 
@@ -454,15 +455,15 @@ private:
                     {
                         return;
                     }
-                    bytes_buffer_.clear();
-                    if (source_reader<Source>::read(source_,bytes_buffer_,len) != static_cast<std::size_t>(len))
+                    auto b = source_reader<Source>::read_view(source_,bytes_buffer_,len);
+                    if (b.size() != len)
                     {
                         ec = msgpack_errc::unexpected_eof;
                         more_ = false;
                         return;
                     }
 
-                    more_ = visitor.byte_string_value(byte_string_view(bytes_buffer_.data(),bytes_buffer_.size()), 
+                    more_ = visitor.byte_string_value(byte_string_view(b.data(),b.size()), 
                                                       semantic_tag::none, 
                                                       *this,
                                                       ec);
@@ -574,15 +575,15 @@ private:
                     }
                     else
                     {
-                        bytes_buffer_.clear();
-                        if (source_reader<Source>::read(source_,bytes_buffer_,len) != static_cast<std::size_t>(len))
+                        auto b = source_reader<Source>::read_view(source_,bytes_buffer_,len);
+                        if (b.size() != len)
                         {
                             ec = msgpack_errc::unexpected_eof;
                             more_ = false;
                             return;
                         }
 
-                        more_ = visitor.byte_string_value(byte_string_view(bytes_buffer_.data(),bytes_buffer_.size()), 
+                        more_ = visitor.byte_string_value(byte_string_view(b.data(),b.size()), 
                                                           static_cast<uint8_t>(ext_type), 
                                                           *this,
                                                           ec);
@@ -469,21 +469,22 @@ private:
                 {
                     return;
                 }
-                text_buffer_.clear();
-                if (source_reader<Source>::read(source_,text_buffer_,length) != length)
+                // A view into a contiguous source, otherwise read into text_buffer_
+                auto s = source_reader<Source>::read_view(source_,text_buffer_,length);
+                if (s.size() != length)
                 {
                     ec = ubjson_errc::unexpected_eof;
                     more_ = false;
                     return;
                 }
-                auto result = unicode_traits::validate(text_buffer_.data(),text_buffer_.size());
+                auto result = unicode_traits::validate(s.data(),s.size());
                 if (result.ec != unicode_traits::conv_errc())
                 {
                     ec = ubjson_errc::invalid_utf8_text_string;
                     more_ = false;
                     return;
                 }
-                more_ = visitor.string_value(jsoncons::basic_string_view<char>(text_buffer_.data(),text_buffer_.length()), semantic_tag::none, *this, ec);
+                more_ = visitor.string_value(jsoncons::basic_string_view<char>(s.data(),s.size()), semantic_tag::none, *this, ec);
                 break;
             }
             case jsoncons::ubjson::ubjson_type::high_precision_number_type: 
@@ -856,22 +857,22 @@ private:
             more_ = false;
             return;
         }
-        text_buffer_.clear();
-        if (source_reader<Source>::read(source_,text_buffer_,length) != length)
+        auto s = source_reader<Source>::read_view(source_,text_buffer_,length);
+        if (s.size() != length)
         {
             ec = ubjson_errc::unexpected_eof;
             more_ = false;
             return;
         }
 
-        auto result = unicode_traits::validate(text_buffer_.data(),text_buffer_.size());
+        auto result = unicode_traits::validate(s.data(),s.size());
         if (result.ec != unicode_traits::conv_errc())
         {
             ec = ubjson_errc::invalid_utf8_text_string;
             more_ = false;
             return;
         }
-        more_ = visitor.key(jsoncons::basic_string_view<char>(text_buffer_.data(),text_buffer_.length()), *this, ec);
+        more_ = visitor.key(jsoncons::basic_string_view<char>(s.data(),s.size()), *this, ec);
     }
 };
 
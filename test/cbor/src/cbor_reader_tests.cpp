@@ -734,3 +734,56 @@ TEST_CASE("CBOR stringref tag 3")
 
     CHECK(expected == j);
 }
+
+TEST_CASE("cbor json_decoder length hints")
+{
+    json doc = json::parse(R"(
+{
+    "samples" : [1.5, 2.5, 3.5, 4.5],
+    "readings" : [{"id" : 1, "position" : [10, 20]}, {"id" : 2, "position" : [30, 40]}]
+}
+    )");
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(doc, data);
+
+    SECTION("lengths reserved and ignored")
+    {
+        json_decoder<json> decoder;
+        CHECK(decoder.max_length_hint() == json_decoder<json>::default_max_length_hint);
+        cbor::cbor_bytes_reader reader(data, decoder);
+        reader.read();
+        CHECK(decoder.get_result() == doc);
+
+        json_decoder<json> decoder2;
+        decoder2.max_length_hint(0);
+        cbor::cbor_bytes_reader reader2(data, decoder2);
+        reader2.read();
+        CHECK(decoder2.get_result() == doc);
+    }
+
+    SECTION("hostile length")
+    {
+        // An array announcing 2^32 items followed by one
+        std::vector<uint8_t> input = {0x9b,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x01};
+
+        json_decoder<json> decoder;
+        decoder.max_length_hint(16);
+        cbor::cbor_bytes_reader reader(input, decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec);
+        CHECK_FALSE(decoder.is_valid());
+    }
+
+    SECTION("max_length_hint option")
+    {
+        CHECK(cbor::cbor_options{}.max_length_hint() == json_decoder<json>::default_max_length_hint);
+
+        auto options = cbor::cbor_options{}.max_length_hint(0);
+        CHECK(options.max_length_hint() == 0);
+        CHECK(cbor::decode_cbor<json>(data, options) == doc);
+
+        std::vector<uint8_t> input = {0x9b,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x01};
+        CHECK_THROWS_AS(cbor::decode_cbor<json>(input, cbor::cbor_options{}.max_length_hint(16)), ser_error);
+    }
+}
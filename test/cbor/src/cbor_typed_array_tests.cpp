@@ -820,3 +820,29 @@ TEST_CASE("cbor typed array tests")
     }
 } 
 
+
+TEST_CASE("cbor typed array decodes to packed array")
+{
+    const std::vector<uint8_t> input = {
+        0xa1, // map(1)
+            0x61,0x61, // "a"
+            0xd8, // Tag
+                0x55, // Tag 85, float32, little endian, Typed Array
+            0x48, // Byte string value of length 8
+                0x00,0x00,0xc0,0x3f, // 1.5
+                0x00,0x00,0x20,0x40  // 2.5
+    };
+
+    json j = cbor::decode_cbor<json>(input);
+    REQUIRE(j["a"].storage_kind() == json_storage_kind::packed_array_value);
+    CHECK(j["a"].as_typed_array_view().type() == typed_array_type::float_value);
+    CHECK(j == json::parse(R"({"a":[1.5,2.5]})"));
+
+    std::vector<uint8_t> v;
+    cbor::cbor_options options;
+    options.use_typed_arrays(true);
+    cbor::encode_cbor(j, v, options);
+    json k = cbor::decode_cbor<json>(v);
+    CHECK(k == j);
+    CHECK(k["a"].as_typed_array_view().type() == typed_array_type::float_value);
+}
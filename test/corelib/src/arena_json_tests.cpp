@@ -0,0 +1,227 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/arena_json.hpp>
+#include <catch/catch.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace jsoncons;
+
+TEST_CASE("json_arena tests")
+{
+    SECTION("alignment")
+    {
+        json_arena arena(256);
+        void* p1 = arena.allocate(1, 1);
+        void* p2 = arena.allocate(sizeof(double), alignof(double));
+        void* p3 = arena.allocate(3, 1);
+        void* p4 = arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+
+        CHECK(p1 != p2);
+        CHECK(reinterpret_cast<std::uintptr_t>(p2) % alignof(double) == 0);
+        CHECK(p3 != p4);
+        CHECK(reinterpret_cast<std::uintptr_t>(p4) % alignof(uint64_t) == 0);
+        CHECK(arena.bytes_used() == 1 + sizeof(double) + 3 + sizeof(uint64_t));
+    }
+
+    SECTION("large allocation")
+    {
+        json_arena arena(256);
+        arena.allocate(16, 8);
+        char* p = static_cast<char*>(arena.allocate(100000, 8));
+        p[0] = 'a';
+        p[99999] = 'b';
+        CHECK(arena.bytes_reserved() >= 100000);
+        CHECK(arena.bytes_used() == 100016);
+
+        arena.release();
+        CHECK(arena.bytes_used() == 0);
+        CHECK(arena.bytes_reserved() == 0);
+    }
+
+    SECTION("large initial block")
+    {
+        // As made by parse for a long text, later blocks are no larger than 1 MB
+        const std::size_t max_block_size = 1024*1024;
+        json_arena arena(8*max_block_size);
+        arena.allocate(8*max_block_size, 8);
+        std::size_t reserved = arena.bytes_reserved();
+        CHECK(reserved >= 8*max_block_size);
+
+        arena.allocate(16, 8);
+        CHECK(arena.bytes_reserved() - reserved <= max_block_size + 64);
+    }
+
+    SECTION("arena_allocator")
+    {
+        json_arena arena1;
+        json_arena arena2;
+
+        arena_allocator<char> alloc1(arena1);
+        arena_allocator<double> alloc2(alloc1);
+        arena_allocator<char> alloc3(arena2);
+
+        CHECK(alloc1 == alloc2);
+        CHECK(alloc1 != alloc3);
+
+        double* p = alloc2.allocate(10);
+        CHECK(reinterpret_cast<std::uintptr_t>(p) % alignof(double) == 0);
+        alloc2.deallocate(p, 10);
+        CHECK(arena1.bytes_used() == 10*sizeof(double));
+        CHECK(arena2.bytes_used() == 0);
+    }
+}
+
+TEST_CASE("arena_json parse tests")
+{
+    std::string input = R"(
+{
+    "books" : [
+        {
+            "title" : "Pulp, A Novel of the Los Angeles Underworld",
+            "author" : "Charles Bukowski",
+            "price" : 22.48,
+            "tags" : ["fiction", "crime"]
+        },
+        {
+            "title" : "The Comedians",
+            "author" : "Graham Greene",
+            "price" : 15.74,
+            "tags" : []
+        }
+    ],
+    "count" : 2,
+    "available" : true,
+    "note" : null
+}
+    )";
+
+    json expected = json::parse(input);
+
+    SECTION("parse string")
+    {
+        arena_json doc = arena_json::parse(input);
+
+        CHECK(doc->size() == 4);
+        CHECK(doc->at("count").as<int>() == 2);
+        CHECK(doc->at("available").as<bool>());
+        CHECK(doc->at("note").is_null());
+        CHECK((*doc)["books"][0]["title"].as_string_view() == "Pulp, A Novel of the Los Angeles Underworld");
+        CHECK(doc.root()["books"][1]["price"].as<double>() == 15.74);
+        CHECK(doc->at("books").at(0).at("tags").size() == 2);
+
+        CHECK(doc.arena().bytes_used() > 0);
+        CHECK(doc.arena().bytes_reserved() >= doc.arena().bytes_used());
+
+        std::string s1;
+        doc->dump(s1);
+        std::string s2;
+        expected.dump(s2);
+        CHECK(s1 == s2);
+    }
+
+    SECTION("values are allocated from the document's arena")
+    {
+        arena_json doc = arena_json::parse(input);
+
+        CHECK(doc->get_allocator() == doc.get_allocator());
+        CHECK(doc->at("books").get_allocator() == doc.get_allocator());
+        CHECK(doc->at("books").at(0).get_allocator() == doc.get_allocator());
+    }
+
+    SECTION("parse stream")
+    {
+        std::istringstream is(input);
+        arena_ojson doc = arena_ojson::parse(is);
+
+        CHECK(doc->size() == 4);
+        CHECK(doc->object_range().begin()->key().compare("books") == 0);
+        CHECK(doc->at("books").at(1).at("author").as<std::string>() == "Graham Greene");
+    }
+
+    SECTION("parse scalar")
+    {
+        arena_json doc1 = arena_json::parse("\"A string too long to fit in short string storage\"");
+        CHECK(doc1->as_string_view() == "A string too long to fit in short string storage");
+
+        arena_json doc2 = arena_json::parse("10");
+        CHECK(doc2->as<int>() == 10);
+    }
+
+    SECTION("parse error")
+    {
+        REQUIRE_THROWS_AS(arena_json::parse("{\"a\":1,}"), ser_error);
+    }
+}
+
+TEST_CASE("arena_json modify tests")
+{
+    SECTION("default is an empty object")
+    {
+        arena_json doc;
+        CHECK(doc->is_object());
+        CHECK(doc->empty());
+    }
+
+    SECTION("insert and assign")
+    {
+        arena_json doc = arena_json::parse(R"({"first":1})");
+
+        doc->insert_or_assign("second", "A string too long to fit in short string storage");
+        doc->try_emplace("third", json_array_arg);
+        (*doc)["third"].push_back(1);
+        (*doc)["third"].emplace_back("A string too long to fit in short string storage");
+        (*doc)["fourth"] = arena_json::value_type(json_object_arg, semantic_tag::none, doc.get_allocator());
+        (*doc)["fourth"]["fifth"] = true;
+
+        CHECK(doc->size() == 4);
+        CHECK(doc->at("second").as_string_view() == "A string too long to fit in short string storage");
+        CHECK(doc->at("third").size() == 2);
+        CHECK(doc->at("third").at(1).get_allocator() == doc.get_allocator());
+        CHECK(doc->at("fourth").at("fifth").as<bool>());
+
+        doc->erase("first");
+        CHECK(doc->size() == 3);
+    }
+
+    SECTION("move")
+    {
+        arena_json doc1 = arena_json::parse(R"({"first":[1,2,3]})");
+        const arena_json::value_type* root = &doc1.root();
+
+        arena_json doc2(std::move(doc1));
+        CHECK(&doc2.root() == root);
+        CHECK(doc2->at("first").size() == 3);
+
+        arena_json doc3;
+        doc3 = std::move(doc2);
+        CHECK(&doc3.root() == root);
+        CHECK(doc3->at("first").at(2).as<int>() == 3);
+    }
+}
+
+TEST_CASE("json_decoder with arena allocator")
+{
+    using value_type = arena_json::value_type;
+
+    json_arena arena;
+    arena_json::allocator_type alloc{arena_allocator<char>(arena)};
+
+    json_decoder<value_type> decoder(alloc);
+    json_string_reader reader(R"({"a" : ["A string too long to fit in short string storage"], "b" : {"c" : 1}})", decoder);
+    reader.read();
+    REQUIRE(decoder.is_valid());
+
+    std::size_t used = arena.bytes_used();
+    CHECK(used > 0);
+
+    value_type j = decoder.get_result();
+    CHECK(j.at("a").at(0).as_string_view() == "A string too long to fit in short string storage");
+    CHECK(j.at("b").at("c").as<int>() == 1);
+    CHECK(j.at("b").get_allocator() == alloc);
+    CHECK(arena.bytes_used() == used);
+}
@@ -0,0 +1,355 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+    using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>>;
+    using cow_ojson = basic_json<char,copy_on_write_policy<order_preserving_policy>>;
+
+    // True if a and b are arrays or objects that share their elements
+    template <class Json>
+    bool shares_elements(const Json& a, const Json& b)
+    {
+        if (a.is_array() && b.is_array() && !a.empty())
+        {
+            return std::addressof(a[0]) == std::addressof(b[0]);
+        }
+        if (a.is_object() && b.is_object() && !a.empty())
+        {
+            return std::addressof(*a.object_range().begin()) == std::addressof(*b.object_range().begin());
+        }
+        return false;
+    }
+
+    // Records which allocator allocated each block, to check that blocks are freed by an equal allocator
+    std::map<void*,int> block_owners;
+
+    template <class T>
+    struct propagating_allocator
+    {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        int id;
+
+        explicit propagating_allocator(int id) noexcept
+            : id(id)
+        {
+        }
+
+        template <class U>
+        propagating_allocator(const propagating_allocator<U>& other) noexcept
+            : id(other.id)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            T* p = std::allocator<T>().allocate(n);
+            block_owners[p] = id;
+            return p;
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            CHECK(block_owners[p] == id);
+            block_owners.erase(p);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const propagating_allocator& lhs, const propagating_allocator& rhs) noexcept
+        {
+            return lhs.id == rhs.id;
+        }
+
+        friend bool operator!=(const propagating_allocator& lhs, const propagating_allocator& rhs) noexcept
+        {
+            return lhs.id != rhs.id;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("cow_vector allocator propagation tests")
+{
+    using vector_type = jsoncons::detail::cow_vector<int,propagating_allocator<int>>;
+
+    propagating_allocator<int> alloc1(1);
+    propagating_allocator<int> alloc2(2);
+
+    SECTION("swap")
+    {
+        vector_type v1({1, 2, 3}, alloc1);
+        vector_type v2({4, 5}, alloc2);
+        vector_type v3(v2);
+        v1.swap(v2);
+        CHECK(v1.get_allocator() == alloc2);
+        CHECK(v2.get_allocator() == alloc1);
+        CHECK(v1 == v3);
+        CHECK(v2 == vector_type({1, 2, 3}, alloc1));
+        v1.push_back(6);
+        v2.push_back(7);
+    }
+
+    SECTION("copy and move assignment")
+    {
+        vector_type v1({1, 2, 3}, alloc1);
+        vector_type v2({4, 5}, alloc2);
+        v1 = v2;
+        CHECK(v1.get_allocator() == alloc2);
+        CHECK(v1.use_count() == 2);
+
+        vector_type v3({6}, alloc1);
+        v3 = std::move(v2);
+        CHECK(v3.get_allocator() == alloc2);
+        CHECK(v3 == vector_type({4, 5}, alloc2));
+    }
+
+    CHECK(block_owners.empty());
+}
+
+TEST_CASE("cow_vector tests")
+{
+    using vector_type = jsoncons::detail::cow_vector<std::string,std::allocator<std::string>>;
+
+    SECTION("copies share elements until modified")
+    {
+        vector_type v;
+        v.push_back("one");
+        v.push_back("two");
+
+        vector_type w(v);
+        CHECK(v.use_count() == 2);
+        {
+            // Copies that hand out pointers through const access, and then keep the buffer for them if modified
+            vector_type t(v);
+            vector_type u(v);
+            CHECK(static_cast<const vector_type&>(t).data() == static_cast<const vector_type&>(u).data());
+        }
+
+        w.push_back("three");
+        CHECK(v.use_count() == 1);
+        CHECK(w.use_count() == 1);
+        CHECK(v.size() == 2);
+        REQUIRE(w.size() == 3);
+        CHECK(w[0] == "one");
+        CHECK(w[2] == "three");
+
+        vector_type x(v);
+        x.erase(x.cbegin());
+        CHECK(v.size() == 2);
+        REQUIRE(x.size() == 1);
+        CHECK(x[0] == "two");
+    }
+
+    SECTION("references obtained before a copy")
+    {
+        vector_type v{"one", "two"};
+        std::string& ref = v[0];
+        CHECK_FALSE(v.is_shareable());
+
+        vector_type w(v);
+        CHECK(v.use_count() == 1);
+        ref = "changed";
+        CHECK(v[0] == "changed");
+        CHECK(w[0] == "one");
+
+        v.clear();
+        CHECK(v.is_shareable());
+    }
+
+    SECTION("references obtained through const access")
+    {
+        vector_type v{"one", "A string too long for short string optimization"};
+        const vector_type& cv = v;
+        const std::string& ref = cv[1];
+        {
+            vector_type w(v);
+            CHECK(v.use_count() == 2);
+            v[0] = "changed";
+            // v keeps its share of the buffer that ref refers to
+            CHECK(w.use_count() == 2);
+            CHECK(v.use_count() == 1);
+        }
+        CHECK(ref == "A string too long for short string optimization");
+        CHECK_FALSE(v.is_shareable());
+
+        vector_type x(v);
+        CHECK(x.use_count() == 1);
+        v.clear();
+        CHECK(v.is_shareable());
+
+        vector_type y(x);
+        const std::string& ref2 = static_cast<const vector_type&>(y).front();
+        y.pop_back();
+        x.clear();
+        CHECK(ref2 == "changed");
+    }
+
+    SECTION("element of the container as argument")
+    {
+        vector_type v{"one"};
+        vector_type w(v);
+        const vector_type& cw = w;
+        w.push_back(cw[0]);
+        REQUIRE(w.size() == 2);
+        CHECK(w[1] == "one");
+        for (int i = 0; i < 10; ++i)
+        {
+            w.push_back(cw.back());
+        }
+        CHECK(w.size() == 12);
+        CHECK(v.size() == 1);
+    }
+}
+
+TEST_CASE("copy_on_write_policy array tests")
+{
+    cow_json a = cow_json::parse(R"([[1,2,3], {"x" : [4,5]}, "A string too long for short string optimization"])");
+
+    SECTION("copy shares and compares equal")
+    {
+        cow_json b = a;
+        CHECK(shares_elements(a, b));
+        CHECK(shares_elements(a[0], b[0]));
+        CHECK(a == b);
+    }
+
+    SECTION("modify a copy")
+    {
+        cow_json b = a;
+        b[0][1] = 20;
+        b.push_back(6);
+        CHECK(a[0][1] == 2);
+        CHECK(a.size() == 3);
+        CHECK(b[0][1] == 20);
+        CHECK(b.size() == 4);
+
+        // Unmodified nested values are still shared
+        const cow_json& ca = a;
+        const cow_json& cb = b;
+        CHECK(shares_elements(ca[1], cb[1]));
+        CHECK_FALSE(shares_elements(ca[0], cb[0]));
+        CHECK(a == cow_json::parse(R"([[1,2,3], {"x" : [4,5]}, "A string too long for short string optimization"])"));
+    }
+
+    SECTION("modify the original")
+    {
+        cow_json b = a;
+        a.erase(a.array_range().begin());
+        a[0]["x"].clear();
+        CHECK(b == cow_json::parse(R"([[1,2,3], {"x" : [4,5]}, "A string too long for short string optimization"])"));
+        CHECK(a == cow_json::parse(R"([{"x" : []}, "A string too long for short string optimization"])"));
+    }
+
+    SECTION("reference obtained before a copy")
+    {
+        cow_json& element = a[0];
+        cow_json b = a;
+        element.push_back(4);
+        CHECK(a[0].size() == 4);
+        CHECK(b[0].size() == 3);
+    }
+
+    SECTION("reference obtained through const access, then a copy")
+    {
+        const cow_json& ca = a;
+        const auto& e = ca[2];
+        {
+            cow_json k = a;
+            a[1] = 5;
+        }
+        CHECK(e.as<std::string>() == "A string too long for short string optimization");
+        CHECK(a[1] == 5);
+    }
+
+    SECTION("destroy copies in any order")
+    {
+        auto b = std::unique_ptr<cow_json>(new cow_json(a));
+        auto c = std::unique_ptr<cow_json>(new cow_json(*b));
+        (*c)[0].push_back(4);
+        b.reset();
+        CHECK(a[0].size() == 3);
+        a = cow_json();
+        CHECK((*c)[0].size() == 4);
+        CHECK((*c)[1]["x"][1] == 5);
+    }
+}
+
+TEST_CASE("copy_on_write_policy object tests")
+{
+    SECTION("sorted objects")
+    {
+        cow_json a = cow_json::parse(R"({"b" : {"c" : [1,2]}, "a" : 1})");
+        cow_json b = a;
+        CHECK(shares_elements(a, b));
+
+        b.insert_or_assign("d", 4);
+        b["b"]["c"].push_back(3);
+        CHECK(a.size() == 2);
+        CHECK(a["b"]["c"].size() == 2);
+        CHECK(b.size() == 3);
+        CHECK(b["b"]["c"].size() == 3);
+        CHECK(b.at("a") == 1);
+    }
+
+    SECTION("wide order preserving objects")
+    {
+        cow_ojson a(json_object_arg);
+        for (int i = 0; i < 100; ++i)
+        {
+            a.try_emplace("key" + std::to_string(i), i);
+        }
+        cow_ojson b = a;
+        b.erase("key0");
+        b.try_emplace("extra", -1);
+
+        CHECK(a.size() == 100);
+        CHECK(a.at("key0") == 0);
+        CHECK(a.at("key99") == 99);
+        CHECK_FALSE(a.contains("extra"));
+        CHECK(b.size() == 100);
+        CHECK_FALSE(b.contains("key0"));
+        CHECK(b.at("key99") == 99);
+        CHECK(b.at("extra") == -1);
+        CHECK(b.object_range().begin()->key() == "key1");
+    }
+
+    SECTION("parsed values can be shared")
+    {
+        cow_ojson a = cow_ojson::parse(R"({"z" : [1,2], "y" : {"x" : true}})");
+        cow_ojson b = a;
+        CHECK(shares_elements(a, b));
+        const cow_ojson& ca = a;
+        const cow_ojson& cb = b;
+        CHECK(shares_elements(ca["z"], cb["z"]));
+        CHECK(a.to_string() == b.to_string());
+    }
+}
+
+TEST_CASE("copy_on_write_policy deeply nested")
+{
+    cow_json a(json_array_arg);
+    for (int i = 0; i < 100000; ++i)
+    {
+        cow_json outer(json_array_arg);
+        outer.push_back(std::move(a));
+        a = std::move(outer);
+    }
+    cow_json b = a;
+    cow_json c = b;
+    b = cow_json();
+    a = cow_json();
+    CHECK(c.size() == 1);
+}
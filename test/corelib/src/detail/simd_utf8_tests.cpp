@@ -0,0 +1,80 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/simd_utf8.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    bool scalar_is_valid(const std::string& s)
+    {
+        return unicode_traits::validate(s.data(), s.size()).ec == unicode_traits::conv_errc();
+    }
+
+    bool fast_is_valid(const std::string& s)
+    {
+        return jsoncons::detail::fast_validate(s.data(), s.size()).ec == unicode_traits::conv_errc();
+    }
+}
+
+TEST_CASE("fast_validate utf8 tests")
+{
+    std::vector<std::string> valid = {"a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF", "\xEF\xBF\xBF", "\xF4\x8F\xBF\xBF"};
+    std::vector<std::string> invalid = {"\xC0\x80", "\xC1\xBF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\x80", "\xC3", "\xE2\x82", 
+                                        "\xF0\x9F\x98", "\xF8\x88\x80\x80\x80", "\xFF", "\xE0\x9F\xBF", "\xF0\x8F\xBF\xBF", "\xC3\xC3"};
+    std::string padding(40, 'x');
+
+    SECTION("valid sequences at every offset")
+    {
+        for (const auto& seq : valid)
+        {
+            for (std::size_t offset = 0; offset <= padding.size(); ++offset)
+            {
+                std::string s = padding.substr(0, offset) + seq + padding.substr(offset);
+                CHECK(scalar_is_valid(s));
+                CHECK(fast_is_valid(s));
+            }
+        }
+    }
+
+    SECTION("invalid sequences at every offset")
+    {
+        for (const auto& seq : invalid)
+        {
+            for (std::size_t offset = 0; offset <= padding.size(); ++offset)
+            {
+                std::string s = padding.substr(0, offset) + seq + padding.substr(offset);
+                auto expected = unicode_traits::validate(s.data(), s.size());
+                auto result = jsoncons::detail::fast_validate(s.data(), s.size());
+                CHECK_FALSE(scalar_is_valid(s));
+                CHECK(result.ec == expected.ec);
+                CHECK(result.ptr == expected.ptr);
+            }
+        }
+    }
+
+    SECTION("truncated at end of block")
+    {
+        std::string s(31, 'x');
+        s.append("\xE2\x82");
+        CHECK_FALSE(fast_is_valid(s));
+        s.push_back('\xAC');
+        CHECK(fast_is_valid(s));
+    }
+}
+
+TEST_CASE("json_parser invalid utf8 in long string")
+{
+    std::string input = "\"" + std::string(64, 'a') + "\xED\xA0\x80" + std::string(64, 'b') + "\"";
+
+    std::error_code ec;
+    json_decoder<json> decoder;
+    json_string_reader reader(input, decoder);
+    reader.read(ec);
+    CHECK(ec == json_errc::illegal_codepoint);
+}
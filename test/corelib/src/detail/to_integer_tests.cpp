@@ -162,3 +162,68 @@ TEST_CASE("detail::to_integer_unchecked tests")
     }
 }
 
+
+TEST_CASE("detail::to_integer eight digit runs")
+{
+    SECTION("all lengths match scalar accumulation")
+    {
+        std::string digits = "1234567890123456789";
+        for (std::size_t len = 1; len <= digits.size(); ++len)
+        {
+            std::string s = digits.substr(0, len);
+            uint64_t expected = 0;
+            for (auto c : s)
+            {
+                expected = expected*10 + static_cast<uint64_t>(c - '0');
+            }
+
+            uint64_t u1 = 0, u2 = 0, u3 = 0;
+            CHECK(jsoncons::detail::to_integer(s.data(), s.length(), u1));
+            CHECK(jsoncons::detail::to_integer_decimal(s.data(), s.length(), u2));
+            CHECK(jsoncons::detail::to_integer_unchecked(s.data(), s.length(), u3));
+            CHECK(u1 == expected);
+            CHECK(u2 == expected);
+            CHECK(u3 == expected);
+
+            std::string neg = "-" + s;
+            int64_t i1 = 0;
+            CHECK(jsoncons::detail::to_integer_unchecked(neg.data(), neg.length(), i1));
+            CHECK(i1 == -static_cast<int64_t>(expected));
+        }
+    }
+    SECTION("invalid digit inside a run of eight")
+    {
+        std::string s = "123456789012x456";
+        uint64_t val;
+        auto result = jsoncons::detail::to_integer_decimal(s.data(), s.length(), val);
+        REQUIRE_FALSE(result);
+        CHECK(result.ec == jsoncons::detail::to_integer_errc::invalid_digit);
+        CHECK(result.ptr == s.data() + 12);
+    }
+    SECTION("overflow of uint64_t and int64_t")
+    {
+        std::string s1 = "18446744073709551616";
+        uint64_t u;
+        auto r1 = jsoncons::detail::to_integer_unchecked(s1.data(), s1.length(), u);
+        REQUIRE_FALSE(r1);
+        CHECK(r1.ec == jsoncons::detail::to_integer_errc::overflow);
+
+        std::string s2 = "-92233720368547758080000";
+        int64_t i;
+        auto r2 = jsoncons::detail::to_integer_unchecked(s2.data(), s2.length(), i);
+        REQUIRE_FALSE(r2);
+        CHECK(r2.ec == jsoncons::detail::to_integer_errc::overflow);
+
+        std::string s3 = "4294967296";
+        uint32_t u32;
+        auto r3 = jsoncons::detail::to_integer_unchecked(s3.data(), s3.length(), u32);
+        REQUIRE_FALSE(r3);
+        CHECK(r3.ec == jsoncons::detail::to_integer_errc::overflow);
+
+        std::string s4 = "-2147483648";
+        int32_t i32;
+        auto r4 = jsoncons::detail::to_integer_unchecked(s4.data(), s4.length(), i32);
+        REQUIRE(r4);
+        CHECK(i32 == (std::numeric_limits<int32_t>::min)());
+    }
+}
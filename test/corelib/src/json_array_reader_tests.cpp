@@ -0,0 +1,194 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_array_reader.hpp>
+#include <jsoncons/detail/parallel_chunks.hpp>
+#include <catch/catch.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_array(std::size_t count)
+    {
+        std::string s = "[\n";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.append(",\r\n");
+            }
+            s.append("  {\"id\": ");
+            s.append(std::to_string(i));
+            s.append(", \"name\": \"item, [");
+            s.append(std::to_string(i));
+            s.append("]\", \"tags\": [\"a\", {\"b\": 1.5}]}");
+        }
+        s.append("\n]\n");
+        return s;
+    }
+
+    // The error reported by json_reader for the whole text
+    std::error_code read_sequentially(const std::string& input, std::size_t& line, std::size_t& column)
+    {
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder);
+        std::error_code ec;
+        reader.read(ec);
+        line = reader.line();
+        column = reader.column();
+        return ec;
+    }
+
+} // namespace
+
+TEST_CASE("json_array_reader results are in input order")
+{
+    std::string input = make_array(3000);
+    json expected = json::parse(input);
+
+    for (std::size_t threads : {1, 2, 4})
+    {
+        json_array_reader reader(input, threads);
+        reader.chunk_size(100).max_chunks_in_flight(3);
+
+        std::vector<json> values;
+        reader.read([&values](json&& j) {values.push_back(std::move(j));});
+
+        REQUIRE(values.size() == 3000);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(values[i] == expected[i]);
+        }
+
+        json_array_reader reader2(input, threads);
+        reader2.chunk_size(1000);
+        CHECK(reader2.read_array() == expected);
+    }
+}
+
+TEST_CASE("json_array_reader small texts")
+{
+    SECTION("empty arrays")
+    {
+        json_array_reader reader1("[]", 2);
+        CHECK(reader1.read_array() == json(json_array_arg));
+        json_array_reader reader2(" [ \n ] ", 2);
+        CHECK(reader2.read_array().empty());
+    }
+
+    SECTION("one element")
+    {
+        json_array_reader reader("[ \"a,]\" ]", 2);
+        CHECK(reader.read_array() == json::parse("[\"a,]\"]"));
+    }
+
+    SECTION("not an array")
+    {
+        json_array_reader reader1("{\"a\" : [1,2]}", 2);
+        CHECK(reader1.read_array() == json::parse("{\"a\" : [1,2]}"));
+
+        json_array_reader reader2(" 17 ", 2);
+        std::vector<json> values;
+        reader2.read([&values](json&& j) {values.push_back(std::move(j));});
+        REQUIRE(values.size() == 1);
+        CHECK(values[0] == json(17));
+    }
+
+    SECTION("ojson")
+    {
+        ojson_array_reader reader("[{\"b\":1,\"a\":2},{\"d\":3,\"c\":4}]", 2);
+        ojson result = reader.read_array();
+        REQUIRE(result.size() == 2);
+        CHECK(result[1].object_range().begin()->key() == "d");
+    }
+}
+
+TEST_CASE("json_array_reader errors")
+{
+    SECTION("positions are those of json_reader")
+    {
+        std::vector<std::string> inputs = {"[1,,2]", "[,1]", "[1,2", "[1,2] x", "[1 2]", "[1,\n  {\"a\" 2}]",
+            "[1,]", "[1,2,", "[\n1,\n2\n", "[1}]", "[1e,2]", "[1,\r\n tue]", "[1,\r\n\r\n  x]", "[\"a\",\n\\u]"};
+        for (const auto& input : inputs)
+        {
+            std::size_t line = 0;
+            std::size_t column = 0;
+            std::error_code expected = read_sequentially(input, line, column);
+            REQUIRE(expected);
+
+            for (std::size_t chunk_size : {1, 3, 1000})
+            {
+                json_array_reader reader(input, 2);
+                reader.chunk_size(chunk_size);
+                std::error_code ec;
+                reader.read([](json&&) {}, ec);
+                CHECK(ec == expected);
+                CHECK(reader.line() == line);
+                CHECK(reader.column() == column);
+            }
+        }
+    }
+
+    SECTION("in a large array")
+    {
+        std::string input = make_array(1000);
+        std::size_t pos = 0;
+        for (int i = 0; i < 700; ++i)
+        {
+            pos = input.find("\"id\"", pos) + 1;
+        }
+        input.insert(pos + 4, ",");
+
+        std::size_t line = 0;
+        std::size_t column = 0;
+        std::error_code expected = read_sequentially(input, line, column);
+        CHECK(line == 701);
+
+        json_array_reader reader(input, 4);
+        reader.chunk_size(64);
+        std::size_t count = 0;
+        JSONCONS_TRY
+        {
+            reader.read([&count](json&&) {++count;});
+            CHECK(false);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == expected);
+            CHECK(e.line() == line);
+            CHECK(e.column() == column);
+        }
+        CHECK(count == 699);
+    }
+
+    SECTION("callback throws")
+    {
+        std::string input = make_array(1000);
+        json_array_reader reader(input, 4);
+        reader.chunk_size(64);
+        std::size_t count = 0;
+        CHECK_THROWS_AS(reader.read([&count](json&&) {if (++count == 10) throw std::runtime_error("stop");}), std::runtime_error);
+        CHECK(count == 10);
+    }
+
+    SECTION("worker construction throws")
+    {
+        struct worker
+        {
+            void operator()(int&) {}
+        };
+        int chunks = 0;
+        int consumed = 0;
+        CHECK_THROWS_AS((jsoncons::detail::parse_chunks_in_order<int>(4, 8,
+            []() -> std::unique_ptr<worker> {throw std::bad_alloc();},
+            [&chunks](int& c) {c = chunks; return ++chunks <= 100;},
+            [&consumed](int&) {++consumed; return true;})), std::bad_alloc);
+        CHECK(consumed == 0);
+    }
+}
@@ -30,6 +30,17 @@ TEST_CASE("json constructor byte_string_arg tests")
     }
 }
 
+TEST_CASE("json value size")
+{
+    // A storage kind, a semantic tag and an 8 byte payload, whatever the policy. nan_boxed_policy 
+    // keeps the elements of arrays in 8 bytes, not the values themselves.
+    CHECK(sizeof(json) == 2*sizeof(uint64_t));
+    CHECK(sizeof(ojson) == 2*sizeof(uint64_t));
+    CHECK(sizeof(basic_json<char,small_array_policy<sorted_policy>>) == 2*sizeof(uint64_t));
+    CHECK(sizeof(basic_json<char,copy_on_write_policy<order_preserving_policy>>) == 2*sizeof(uint64_t));
+    CHECK(sizeof(basic_json<char,nan_boxed_policy<sorted_policy>>) == 2*sizeof(uint64_t));
+}
+
 TEST_CASE("json constructor tests")
 {
     SECTION("json json_object_arg")
@@ -0,0 +1,182 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_document.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json_document_view access")
+{
+    std::string input = R"(
+{
+    "name" : "Cobb",
+    "escaped" : "line\nbreak",
+    "scores" : [10, -2, 3.5, 18446744073709551615],
+    "address" : {"city" : "Toronto", "zip" : null},
+    "active" : true,
+    "big" : 123456789012345678901234567890
+}
+    )";
+
+    json_document doc = json_document::parse(input);
+    json_document_view root = doc.root();
+
+    SECTION("type queries")
+    {
+        CHECK(root.is_object());
+        CHECK(root.type() == json_type::object_value);
+        CHECK(root.size() == 6);
+        CHECK(root["scores"].is_array());
+        CHECK(root["scores"][0].is_uint64());
+        CHECK(root["scores"][1].is_int64());
+        CHECK(root["scores"][2].is_double());
+        CHECK(root["address"]["zip"].is_null());
+        CHECK(root["active"].is_bool());
+        CHECK(root["big"].is_string());
+        CHECK(root["big"].is_number());
+        CHECK(root["big"].tag() == semantic_tag::bigint);
+    }
+
+    SECTION("at, find and contains")
+    {
+        CHECK(root.at("address").at("city").as<std::string>() == "Toronto");
+        CHECK(root.contains("active"));
+        CHECK_FALSE(root.contains("missing"));
+        auto it = root.find("active");
+        REQUIRE(it != root.object_range().end());
+        CHECK(it->key() == "active");
+        CHECK(it->value().as<bool>());
+        CHECK(root.find("missing") == root.object_range().end());
+
+        CHECK_THROWS_AS(root.at("missing"), key_not_found);
+        CHECK_THROWS_AS(root["scores"].at(4), std::out_of_range);
+        CHECK_THROWS(root["name"].at("x"));
+        CHECK(root.at(1).as<std::string>() == "line\nbreak");
+    }
+
+    SECTION("strings without escapes refer to the input")
+    {
+        auto sv = root["name"].as<string_view>();
+        CHECK(sv == "Cobb");
+        CHECK(sv.data() >= input.data());
+        CHECK(sv.data() < input.data() + input.size());
+
+        auto escaped = root["escaped"].as_string_view();
+        CHECK(escaped == "line\nbreak");
+        CHECK((escaped.data() < input.data() || escaped.data() >= input.data() + input.size()));
+    }
+
+    SECTION("as")
+    {
+        CHECK(root["scores"][0].as<int>() == 10);
+        CHECK(root["scores"][1].as<int64_t>() == -2);
+        CHECK(root["scores"][2].as<double>() == 3.5);
+        CHECK(root["scores"][3].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(root["big"].as<std::string>() == "123456789012345678901234567890");
+        CHECK(root["scores"].as<std::vector<double>>() == std::vector<double>{10, -2, 3.5, 18446744073709551615.0});
+        auto m = root["address"].as<std::map<std::string,json>>();
+        CHECK(m.size() == 2);
+        CHECK(root.as<json>() == json::parse(input));
+        CHECK(root["address"].as<ojson>() == ojson::parse(R"({"city" : "Toronto", "zip" : null})"));
+        CHECK_THROWS(root["name"].as<bool>());
+    }
+
+    SECTION("iteration")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.emplace_back(member.key().data(), member.key().size());
+        }
+        CHECK(keys == std::vector<std::string>{"name","escaped","scores","address","active","big"});
+
+        std::vector<std::string> values;
+        for (const auto& item : root["scores"].array_range())
+        {
+            values.push_back(item.to_string());
+        }
+        CHECK(values == std::vector<std::string>{"10","-2","3.5","18446744073709551615"});
+    }
+
+    SECTION("dump")
+    {
+        std::string s;
+        root["address"].dump(s);
+        CHECK(s == R"({"city":"Toronto","zip":null})");
+
+        std::ostringstream os;
+        root["scores"].dump(os);
+        CHECK(os.str() == "[10,-2,3.5,18446744073709551615]");
+
+        CHECK(json::parse(root.to_string()) == json::parse(input));
+    }
+}
+
+TEST_CASE("json_document parse")
+{
+    SECTION("from a temporary string")
+    {
+        json_document doc = json_document::parse(std::string(R"(["a","b"])"));
+        CHECK(doc.root().size() == 2);
+        CHECK(doc.root()[1].as_string_view() == "b");
+    }
+
+    SECTION("from a stream")
+    {
+        std::istringstream is(R"({"a":[1,{"b":2}]})");
+        json_document doc = json_document::parse(is);
+        CHECK(doc.root()["a"][1]["b"].as<int>() == 2);
+    }
+
+    SECTION("moved document")
+    {
+        json_document doc1 = json_document::parse(std::string(R"({"key":"value"})"));
+        json_document doc2 = std::move(doc1);
+        CHECK(doc2.root()["key"].as_string_view() == "value");
+    }
+
+    SECTION("comments")
+    {
+        json_document doc = json_document::parse("// comment\n[1, /* two */ 2]");
+        CHECK(doc.root().to_string() == "[1,2]");
+    }
+
+    SECTION("errors")
+    {
+        std::string input = "[1,\n2,\n]";
+
+        json_decoder<json> decoder;
+        json_string_reader reader(input, decoder);
+        std::error_code ec;
+        reader.read(ec);
+        REQUIRE(ec == json_errc::extra_comma);
+
+        JSONCONS_TRY
+        {
+            json_document::parse(input);
+            CHECK(false);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::extra_comma);
+            CHECK(e.line() == reader.line());
+            CHECK(e.column() == reader.column());
+        }
+    }
+
+    SECTION("scalars and empty containers")
+    {
+        CHECK(json_document::parse("17").root().as<int>() == 17);
+        CHECK(json_document::parse("\"x\"").root().as<std::string>() == "x");
+        CHECK(json_document::parse("[]").root().empty());
+        CHECK(json_document::parse("{}").root().size() == 0);
+        json_document doc = json_document::parse("{}");
+        CHECK(doc.root().object_range().begin() == doc.root().object_range().end());
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace jsoncons;
+
+TEST_CASE("json_hash tests")
+{
+    SECTION("equal values hash equal")
+    {
+        CHECK(json_hash(json(1)) == json_hash(json(1u)));
+        CHECK(json_hash(json(1)) == json_hash(json(1.0)));
+        CHECK(json_hash(json(0.0)) == json_hash(json(-0.0)));
+        CHECK(json_hash(json("abc")) == json_hash(json(json::parse("\"abc\""))));
+        CHECK(json_hash(json::parse("{}")) == json_hash(json(json_object_arg)));
+
+        std::string long_string = "A string too long for short string optimization";
+        CHECK(json_hash(json(long_string)) == json_hash(json(long_string.c_str())));
+
+        json a = json::parse(R"({"first" : [1, 2.5, "three"], "second" : {"x" : null, "y" : true}})");
+        json b = json::parse(R"({"second" : {"y" : true, "x" : null}, "first" : [1.0, 2.5, "three"]})");
+        REQUIRE(a == b);
+        CHECK(json_hash(a) == json_hash(b));
+        CHECK(std::hash<json>()(a) == json_hash(a));
+    }
+
+    SECTION("object member order")
+    {
+        ojson a = ojson::parse(R"({"x" : 1, "y" : 2})");
+        ojson b = ojson::parse(R"({"y" : 2, "x" : 1})");
+        CHECK(json_hash(a) == json_hash(b));
+    }
+
+    SECTION("different values")
+    {
+        CHECK(json_hash(json(1)) != json_hash(json(2)));
+        CHECK(json_hash(json("1")) != json_hash(json(1)));
+        CHECK(json_hash(json(true)) != json_hash(json(false)));
+        CHECK(json_hash(json::null()) != json_hash(json(false)));
+        CHECK(json_hash(json::parse("[1,2]")) != json_hash(json::parse("[2,1]")));
+        CHECK(json_hash(json::parse("[[1],2]")) != json_hash(json::parse("[1,[2]]")));
+        CHECK(json_hash(json::parse(R"({"a":1,"b":2})")) != json_hash(json::parse(R"({"a":2,"b":1})")));
+        CHECK(json_hash(json::parse("[]")) != json_hash(json::parse("{}")));
+    }
+
+    SECTION("big numbers")
+    {
+        json big("1", semantic_tag::bigint);
+        CHECK(big == json("1"));
+        CHECK(json("1") == big);
+        CHECK(json_hash(big) == json_hash(json("1")));
+        std::unordered_set<json> set = {big, json("1")};
+        CHECK(set.size() == 1);
+    }
+
+    SECTION("distribution")
+    {
+        std::unordered_set<std::size_t> hashes;
+        for (int i = 0; i < 10000; ++i)
+        {
+            hashes.insert(json_hash(json(i)));
+            hashes.insert(json_hash(json("key" + std::to_string(i))));
+        }
+        CHECK(hashes.size() == 20000);
+    }
+}
+
+TEST_CASE("json in unordered containers")
+{
+    std::unordered_set<json> set;
+    set.insert(json::parse(R"({"a" : [1,2,3]})"));
+    set.insert(json::parse(R"({"a" : [1,2,3.0]})"));
+    set.insert(json::parse(R"({"a" : [1,2]})"));
+    CHECK(set.size() == 2);
+
+    std::unordered_map<json,int> map;
+    map[json("x")] = 1;
+    map[json(10)] = 2;
+    CHECK(map[json(10.0)] == 2);
+    CHECK(map.size() == 2);
+}
+
+TEST_CASE("json_hash_cache tests")
+{
+    json a = json::parse(R"([{"id" : 1, "tags" : ["x","y"]}, {"id" : 2, "tags" : ["z"]}, [1, [2, [3]]]])");
+    json b = json::parse(R"([{"id" : 1, "tags" : ["x","y"]}, {"id" : 2, "tags" : ["z"]}, [1, [2, [3]]]])");
+    json c = json::parse(R"([{"id" : 1, "tags" : ["x","y"]}, {"id" : 2, "tags" : ["w"]}, [1, [2, [3]]]])");
+
+    json_hash_cache<json> cache;
+
+    SECTION("hash")
+    {
+        CHECK(cache.hash(a) == json_hash(a));
+        std::size_t count = cache.size();
+        CHECK(count == 8);
+        CHECK(cache.hash(a) == json_hash(a));
+        CHECK(cache.hash(a[1]) == json_hash(a[1]));
+        CHECK(cache.size() == count);
+        CHECK(cache.hash(json(5)) == json_hash(json(5)));
+        CHECK(cache.size() == count);
+    }
+
+    SECTION("values that refer to another")
+    {
+        // Each value is at the same address
+        for (const json* p : {&a[2][1], &c[1], &a[1]})
+        {
+            json ref(json_const_pointer_arg, p);
+            CHECK(cache.hash(ref) == json_hash(*p));
+        }
+    }
+
+    SECTION("deep_equal")
+    {
+        CHECK(cache.deep_equal(a, b));
+        CHECK_FALSE(cache.deep_equal(a, c));
+        CHECK_FALSE(cache.deep_equal(a[2], c[1]));
+        CHECK(cache.deep_equal(a[0], c[0]));
+        CHECK(cache.deep_equal(json(1), json(1.0)));
+        CHECK(cache.deep_equal(json::parse("{}"), json(json_object_arg)));
+
+        cache.clear();
+        CHECK(cache.size() == 0);
+    }
+}
@@ -55,3 +55,35 @@ TEST_CASE("test_integer_limits")
     }
 }
 
+
+TEST_CASE("test_parse_integers_across_buffer_boundaries")
+{
+    std::string input = "[0,-0,7,-7,12345678,-123456789,1234567890123456,-1234567890123456789,18446744073709551615,"
+                        "18446744073709551616,-9223372036854775809,1.5,25e2]";
+
+    for (std::size_t i = 1; i <= input.length(); ++i)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_stream_reader reader(stream_source<char>(is,i), decoder);
+        reader.read();
+        REQUIRE(decoder.is_valid());
+        json j = decoder.get_result();
+        REQUIRE(j.size() == 13);
+        CHECK(j[0].as<uint64_t>() == 0);
+        CHECK(j[1].as<int64_t>() == 0);
+        CHECK(j[2].as<uint64_t>() == 7);
+        CHECK(j[3].as<int64_t>() == -7);
+        CHECK(j[4].as<uint64_t>() == 12345678);
+        CHECK(j[5].as<int64_t>() == -123456789);
+        CHECK(j[6].as<uint64_t>() == 1234567890123456);
+        CHECK(j[7].as<int64_t>() == -1234567890123456789);
+        CHECK(j[8].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(j[9].tag() == semantic_tag::bigint);
+        CHECK(j[9].as<std::string>() == "18446744073709551616");
+        CHECK(j[10].tag() == semantic_tag::bigint);
+        CHECK(j[10].as<std::string>() == "-9223372036854775809");
+        CHECK(j[11].as<double>() == 1.5);
+        CHECK(j[12].as<double>() == 2500);
+    }
+}
@@ -0,0 +1,225 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("json lazy_number tests")
+{
+    auto options = json_options{}.lazy_number(true);
+
+    SECTION("numbers keep their text")
+    {
+        std::string input = R"([1.10,-0.0,1E3,2.50e-3,17,-42,0.1])";
+
+        json j = json::parse(input, options);
+        REQUIRE(j.size() == 7);
+        for (const auto& item : j.array_range())
+        {
+            CHECK(item.storage_kind() == json_storage_kind::raw_number_value);
+        }
+
+        std::string output;
+        j.dump(output);
+        CHECK(output == input);
+        CHECK(j[0].as_string() == "1.10");
+    }
+
+    SECTION("types")
+    {
+        json j = json::parse(R"([17,-42,1.5,1e3])", options);
+
+        CHECK(j[0].type() == json_type::uint64_value);
+        CHECK(j[0].is_uint64());
+        CHECK(j[0].is_int64());
+        CHECK(j[0].is<int>());
+        CHECK(j[0].is_number());
+        CHECK_FALSE(j[0].is_double());
+        CHECK_FALSE(j[0].is_string());
+
+        CHECK(j[1].type() == json_type::int64_value);
+        CHECK(j[1].is_int64());
+        CHECK_FALSE(j[1].is_uint64());
+        CHECK_FALSE(j[1].is<unsigned>());
+
+        CHECK(j[2].type() == json_type::double_value);
+        CHECK(j[2].is_double());
+        CHECK_FALSE(j[2].is_int64());
+
+        CHECK(j[3].type() == json_type::double_value);
+    }
+
+    SECTION("conversions")
+    {
+        json j = json::parse(R"({"a":17,"b":-42,"c":2.50,"d":1e3,"e":0.1})", options);
+
+        CHECK(j["a"].as<int>() == 17);
+        CHECK(j["a"].as<uint64_t>() == 17);
+        CHECK(j["a"].as<bool>());
+        CHECK(j["b"].as<int64_t>() == -42);
+        CHECK(j["b"].as<double>() == -42.0);
+        CHECK(j["c"].as<double>() == 2.5);
+        CHECK(j["c"].as<int>() == 2);
+        CHECK(j["d"].as<double>() == 1000.0);
+        CHECK(j["e"].as<double>() == 0.1);
+    }
+
+    SECTION("comparison")
+    {
+        json j = json::parse(R"([17,-42,2.50,17])", options);
+
+        CHECK(j[0] == json(17));
+        CHECK(json(17) == j[0]);
+        CHECK(j[0] == j[3]);
+        CHECK(j[1] == json(-42));
+        CHECK(j[2] == json(2.5));
+        CHECK(j[1] < j[0]);
+        CHECK(j == json::parse(R"([17,-42,2.5,17])"));
+    }
+
+    SECTION("long numbers round trip")
+    {
+        std::string input = R"([3.14159265358979323846,0.30000000000000004,100000000000000000000.0,-1234567890.12345,123456789012345678])";
+
+        json j = json::parse(input, options);
+        std::string output;
+        j.dump(output);
+        CHECK(output == input);
+
+        CHECK(j[0].storage_kind() == json_storage_kind::raw_number_value);
+        CHECK(j[0].is_double());
+        CHECK(j[0].as<double>() == 3.14159265358979323846);
+        CHECK(j[1].as<double>() == 0.30000000000000004);
+        CHECK(j[2].as<double>() == 1e20);
+        CHECK(j[3].as<double>() == -1234567890.12345);
+        CHECK(j[4].storage_kind() == json_storage_kind::uint64_value);
+        CHECK(j[4].as<uint64_t>() == 123456789012345678);
+        CHECK(j == json::parse(input));
+
+        json j1(j[0]);
+        json j2 = json::parse("[1.5]", options);
+        j2[0] = j[1];
+        swap(j1, j2[0]);
+        CHECK(j1.to_string() == "0.30000000000000004");
+        CHECK(j2[0].to_string() == "3.14159265358979323846");
+        j1 = std::move(j2[0]);
+        CHECK(j1.to_string() == "3.14159265358979323846");
+
+        json_memory_stats stats = j.memory_stats();
+        CHECK(stats.raw_numbers == 4);
+        CHECK(stats.raw_number_bytes > 21 + 19 + 23);
+    }
+
+    SECTION("big integers")
+    {
+        json j = json::parse(R"([123456789012345678901234567890])", options);
+
+        CHECK(j[0].tag() == semantic_tag::bigint);
+        CHECK(j[0].as_string() == "123456789012345678901234567890");
+    }
+
+    SECTION("scalar")
+    {
+        json j = json::parse("1.250", options);
+        CHECK(j.storage_kind() == json_storage_kind::raw_number_value);
+        CHECK(j.as<double>() == 1.25);
+        CHECK(j.to_string() == "1.250");
+    }
+
+    SECTION("copy, assign and swap")
+    {
+        json j = json::parse(R"([1.50,"a string"])", options);
+
+        json j1(j[0]);
+        CHECK(j1.storage_kind() == json_storage_kind::raw_number_value);
+        CHECK(j1.to_string() == "1.50");
+
+        json j2 = "another string";
+        j2 = j[0];
+        CHECK(j2.to_string() == "1.50");
+
+        swap(j[0], j[1]);
+        CHECK(j[0].as<std::string>() == "a string");
+        CHECK(j[1].to_string() == "1.50");
+    }
+
+    SECTION("pretty print")
+    {
+        json j = json::parse(R"({"a":[1.0,2.00]})", options);
+
+        std::ostringstream os;
+        os << pretty_print(j);
+        CHECK(os.str().find("1.0") != std::string::npos);
+        CHECK(os.str().find("2.00") != std::string::npos);
+    }
+
+    SECTION("formatting options convert the number")
+    {
+        json j = json::parse(R"([2.50])", options);
+
+        std::string output;
+        j.dump(output, json_options{}.float_format(float_chars_format::fixed).precision(3));
+        CHECK(output == "[2.500]");
+    }
+}
+
+TEST_CASE("json lazy_number with encoder tests")
+{
+    SECTION("reader to encoder")
+    {
+        std::string input = R"({"a":1.10,"b":[1e3,-0.0,12345678901234567890123]})";
+
+        std::string output;
+        compact_json_string_encoder encoder(output, json_options{}.bigint_format(bigint_chars_format::number));
+        json_string_reader reader(input, encoder, json_options{}.lazy_number(true));
+        reader.read();
+
+        CHECK(output == input);
+    }
+
+    SECTION("bigint_format applies to big integers")
+    {
+        std::string output;
+        compact_json_string_encoder encoder(output);
+        json_string_reader reader(R"([1.10,12345678901234567890123])", encoder, json_options{}.lazy_number(true));
+        reader.read();
+
+        CHECK(output == R"([1.10,"12345678901234567890123"])");
+    }
+
+    SECTION("number_value default conversion")
+    {
+        json_decoder<json> decoder;
+        decoder.begin_array();
+        decoder.number_value("1.5");
+        decoder.number_value("-7");
+        decoder.number_value("123456789012345678901234567890");
+        decoder.end_array();
+        REQUIRE(decoder.is_valid());
+
+        json j = decoder.get_result();
+        CHECK(j[0].as<double>() == 1.5);
+        CHECK(j[1].as<int>() == -7);
+        CHECK(j[2].tag() == semantic_tag::bigint);
+    }
+
+    SECTION("wjson")
+    {
+        std::wstring input = L"[1.10,-42,3.14159265358979323846]";
+
+        wjson j = wjson::parse(input, wjson_options{}.lazy_number(true));
+        CHECK(j[0].storage_kind() == json_storage_kind::raw_number_value);
+        CHECK(j[0].as<double>() == 1.1);
+        CHECK(j[1].as<int>() == -42);
+        CHECK(j[2].as<double>() == 3.14159265358979323846);
+
+        std::wstring output;
+        j.dump(output);
+        CHECK(output == input);
+    }
+}
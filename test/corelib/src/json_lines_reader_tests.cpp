@@ -0,0 +1,129 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <catch/catch.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_lines(std::size_t count)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            s.append("{\"id\":");
+            s.append(std::to_string(i));
+            s.append(",\"name\":\"item ");
+            s.append(std::to_string(i));
+            s.append("\",\"tags\":[\"a\",\"b\"]}\n");
+        }
+        return s;
+    }
+
+} // namespace
+
+TEST_CASE("json_lines_reader results are in input order")
+{
+    std::string input = make_lines(5000);
+
+    for (std::size_t threads : {1, 2, 4})
+    {
+        json_lines_reader reader(input, threads);
+        reader.chunk_size(100).max_chunks_in_flight(3);
+
+        std::vector<json> values;
+        reader.read([&values](json&& j) {values.push_back(std::move(j));});
+
+        REQUIRE(values.size() == 5000);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(values[i]["id"].as<std::size_t>() == i);
+        }
+        CHECK(reader.line() == 5000);
+    }
+}
+
+TEST_CASE("json_lines_reader blank lines and last line")
+{
+    std::string input = "1\n\n  \r\n[2,3]\r\n{\"a\":4}";
+    json_lines_reader reader(input, 2);
+
+    std::vector<json> values;
+    reader.read([&values](json&& j) {values.push_back(std::move(j));});
+
+    REQUIRE(values.size() == 3);
+    CHECK(values[0] == json(1));
+    CHECK(values[1] == json::parse("[2,3]"));
+    CHECK(values[2]["a"].as<int>() == 4);
+    CHECK(reader.line() == 5);
+
+    std::vector<json> none;
+    json_lines_reader empty(string_view(), 2);
+    empty.read([&none](json&& j) {none.push_back(std::move(j));});
+    CHECK(none.empty());
+}
+
+TEST_CASE("json_lines_reader errors")
+{
+    std::string input = make_lines(1000);
+    std::size_t pos = 0;
+    for (int i = 0; i < 700; ++i)
+    {
+        pos = input.find('\n', pos) + 1;
+    }
+    input.insert(pos + 1, ",");  // line 701
+
+    SECTION("with error code")
+    {
+        json_lines_reader reader(input, 4);
+        reader.chunk_size(64);
+
+        std::size_t count = 0;
+        std::error_code ec;
+        reader.read([&count](json&&) {++count;}, ec);
+        CHECK(ec == json_errc::expected_key);
+        CHECK(count == 700);
+        CHECK(reader.line() == 701);
+        CHECK(reader.column() == 2);
+    }
+
+    SECTION("with exception")
+    {
+        json_lines_reader reader(input, 4);
+        JSONCONS_TRY
+        {
+            reader.read([](json&&) {});
+            CHECK(false);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::expected_key);
+            CHECK(e.line() == 701);
+        }
+    }
+
+    SECTION("callback throws")
+    {
+        json_lines_reader reader(input, 4);
+        reader.chunk_size(64);
+        std::size_t count = 0;
+        CHECK_THROWS_AS(reader.read([&count](json&&) {if (++count == 10) throw std::runtime_error("stop");}), std::runtime_error);
+        CHECK(count == 10);
+    }
+}
+
+TEST_CASE("ojson_lines_reader")
+{
+    std::string input = "{\"b\":1,\"a\":2}\n{\"d\":3,\"c\":4}\n";
+    ojson_lines_reader reader(input, 2);
+    std::vector<ojson> values;
+    reader.read([&values](ojson&& j) {values.push_back(std::move(j));});
+    REQUIRE(values.size() == 2);
+    CHECK(values[1].object_range().begin()->key() == "d");
+}
@@ -0,0 +1,145 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/shared_key.hpp>
+#include <catch/catch.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>>;
+    using shared_key_json = basic_json<char,shared_key_policy<sorted_policy>>;
+
+    const std::string long_string = "A string too long for short string optimization";
+
+} // namespace
+
+TEST_CASE("json memory_stats tests")
+{
+    SECTION("scalars")
+    {
+        json j(10.5);
+        json_memory_stats stats = j.memory_stats();
+        CHECK(stats.heap_bytes() == 0);
+        CHECK(j.memory_usage() == sizeof(json));
+    }
+
+    SECTION("strings")
+    {
+        json j(json_array_arg);
+        j.reserve(3);
+        j.push_back("short");
+        j.push_back(long_string);
+        j.emplace_back(byte_string_arg, std::vector<uint8_t>{1,2,3});
+
+        json_memory_stats stats = j.memory_stats();
+        CHECK(stats.short_strings == 1);
+        CHECK(stats.short_string_bytes == 5);
+        CHECK(stats.long_strings == 1);
+        CHECK(stats.long_string_bytes > long_string.size());
+        CHECK(stats.byte_strings == 1);
+        CHECK(stats.byte_string_bytes > 3);
+        CHECK(stats.arrays == 1);
+        CHECK(stats.array_bytes == sizeof(json::array) + 3*sizeof(json));
+        CHECK(stats.slack_bytes == 0);
+        CHECK(j.memory_usage() == sizeof(json) + stats.long_string_bytes + stats.byte_string_bytes + stats.array_bytes);
+    }
+
+    SECTION("objects and keys")
+    {
+        json j = json::parse(R"({"a":1,")" + long_string + R"(":{"b":[]}})");
+        json_memory_stats stats = j.memory_stats();
+        CHECK(stats.objects == 2);
+        CHECK(stats.arrays == 1);
+        CHECK(stats.key_bytes > long_string.size());
+        CHECK(stats.key_bytes < 2*long_string.size());
+        CHECK(stats.object_bytes >= 2*sizeof(json::object) + 3*sizeof(json::key_value_type));
+    }
+
+    SECTION("packed arrays")
+    {
+        std::vector<double> values(100, 1.5);
+        json j(packed_array_arg, jsoncons::span<const double>(values));
+        json_memory_stats stats = j.memory_stats();
+        CHECK(stats.packed_arrays == 1);
+        CHECK(stats.packed_array_bytes >= 100*sizeof(double));
+        CHECK(stats.packed_array_bytes < 100*sizeof(json));
+
+        const json& cj = j;
+        CHECK(cj[0] == 1.5);
+        CHECK(j.memory_stats().packed_array_bytes > 100*sizeof(json));
+        j.shrink_to_fit();
+        CHECK(j.memory_stats().packed_array_bytes == stats.packed_array_bytes);
+    }
+}
+
+TEST_CASE("json shrink_to_fit tests")
+{
+    json j(json_object_arg);
+    j.reserve(10);
+    json a(json_array_arg);
+    a.reserve(100);
+    a.push_back(1);
+    json inner(json_array_arg);
+    inner.reserve(50);
+    inner.push_back(long_string);
+    a.push_back(std::move(inner));
+    j.try_emplace("a", std::move(a));
+
+    json_memory_stats before = j.memory_stats();
+    CHECK(before.slack_bytes == 9*sizeof(json::key_value_type) + 98*sizeof(json) + 49*sizeof(json));
+
+    j.shrink_to_fit();
+    json_memory_stats after = j.memory_stats();
+    CHECK(after.slack_bytes == 0);
+    CHECK(after.heap_bytes() == before.heap_bytes() - before.slack_bytes);
+    CHECK(j == json::parse(R"({"a":[1,[")" + long_string + R"("]]})"));
+}
+
+TEST_CASE("json memory_stats of shared memory")
+{
+    SECTION("copy_on_write_policy copies")
+    {
+        cow_json a = cow_json::parse(R"([[1,2,3],{"x":[")" + long_string + R"("]}])");
+        std::size_t alone = a.memory_stats().heap_bytes();
+
+        // A copy reports the memory it shares
+        cow_json b = a;
+        CHECK(a.memory_stats().heap_bytes() == alone);
+        CHECK(b.memory_stats().heap_bytes() == alone);
+
+        // Memory shared within a value is counted once
+        cow_json doc(json_array_arg);
+        doc.push_back(a);
+        doc.push_back(b);
+        json_memory_stats stats = doc.memory_stats();
+        CHECK(stats.arrays == 5);
+        CHECK(stats.long_strings == 1);
+        CHECK(stats.heap_bytes() < 2*alone);
+
+        // Compacting a copy does not copy the shared elements
+        b.shrink_to_fit();
+        CHECK(doc.memory_stats().heap_bytes() == stats.heap_bytes());
+    }
+
+    SECTION("shared keys")
+    {
+        std::string input = "[";
+        for (int i = 0; i < 100; ++i)
+        {
+            input.append(i == 0 ? "" : ",");
+            input.append(R"({"a member name that is shared":1})");
+        }
+        input.push_back(']');
+
+        shared_key_json j = shared_key_json::parse(input);
+        std::size_t key_bytes = j.memory_stats().key_bytes;
+        CHECK(key_bytes > 0);
+        CHECK(key_bytes == shared_key("a member name that is shared").allocated_bytes());
+    }
+}
@@ -0,0 +1,199 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_ondemand.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("json_ondemand_value access")
+{
+    std::string input = R"(
+{
+    "user" : {"name" : "Cobb", "id" : 12345678901, "tags" : ["a", "b"]},
+    "escaped" : "line\nbreak",
+    "scores" : [10, -2, 3.5, 18446744073709551615],
+    "address" : {"city" : "Toronto", "zip" : null},
+    "active" : true,
+    "big" : 123456789012345678901234567890,
+    "escaped key" : 1
+}
+    )";
+
+    json_ondemand_document doc = json_ondemand_document::parse(input);
+
+    SECTION("navigation")
+    {
+        CHECK(doc["user"]["id"].get_uint64() == 12345678901);
+        CHECK(doc["user"]["name"].get_string_view() == "Cobb");
+        CHECK(doc["user"]["tags"][1].get_string() == "b");
+        CHECK(doc["scores"][1].get_int64() == -2);
+        CHECK(doc["scores"][2].get_double() == 3.5);
+        CHECK(doc["scores"][3].get_uint64() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(doc["address"]["zip"].is_null());
+        CHECK(doc["active"].get_bool());
+        CHECK(doc["escaped"].get_string() == "line\nbreak");
+        CHECK(doc["escaped key"].get_int64() == 1);
+    }
+
+    SECTION("type queries")
+    {
+        json_ondemand_value root = doc.root();
+        CHECK(root.type() == json_type::object_value);
+        CHECK(root.size() == 7);
+        CHECK(root["scores"].type() == json_type::array_value);
+        CHECK(root["scores"][0].type() == json_type::uint64_value);
+        CHECK(root["scores"][1].type() == json_type::int64_value);
+        CHECK(root["scores"][2].type() == json_type::double_value);
+        CHECK(root["big"].type() == json_type::string_value);
+        CHECK(root["big"].is_number());
+        CHECK(root["active"].type() == json_type::bool_value);
+        CHECK(root["address"]["zip"].type() == json_type::null_value);
+        CHECK_FALSE(root["address"].empty());
+    }
+
+    SECTION("lookup errors")
+    {
+        json_ondemand_value root = doc.root();
+        CHECK(root.contains("active"));
+        CHECK_FALSE(root.contains("missing"));
+        CHECK_THROWS_AS(root.at("missing"), key_not_found);
+        CHECK_THROWS_AS(root["scores"].at(4), std::out_of_range);
+        CHECK_THROWS(root["user"]["name"].at("x"));
+        CHECK_THROWS(root["user"]["name"].get_int64());
+        CHECK_THROWS(root["scores"][2].get_int64());
+        CHECK_THROWS(root["scores"][1].get_uint64());
+        CHECK_THROWS(root["active"].get_string());
+    }
+
+    SECTION("strings without escapes refer to the input")
+    {
+        auto sv = doc["user"]["name"].get_string_view();
+        CHECK(sv.data() >= input.data());
+        CHECK(sv.data() < input.data() + input.size());
+
+        auto escaped = doc["escaped"].get_string_view();
+        CHECK((escaped.data() < input.data() || escaped.data() >= input.data() + input.size()));
+        auto escaped2 = doc["escaped"].get_string_view();
+        CHECK(escaped == "line\nbreak");
+        CHECK(escaped2 == "line\nbreak");
+    }
+
+    SECTION("iteration")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : doc.root().object_range())
+        {
+            keys.emplace_back(member.key().data(), member.key().size());
+        }
+        CHECK(keys == std::vector<std::string>{"user","escaped","scores","address","active","big","escaped key"});
+
+        std::vector<std::string> values;
+        for (const auto& item : doc["scores"].array_range())
+        {
+            values.emplace_back(item.raw_json().data(), item.raw_json().size());
+        }
+        CHECK(values == std::vector<std::string>{"10","-2","3.5","18446744073709551615"});
+
+        auto it = doc.root().find("address");
+        REQUIRE(it != doc.root().object_range().end());
+        CHECK(it->value()["city"].get_string() == "Toronto");
+        CHECK(doc.root().find("missing") == doc.root().object_range().end());
+    }
+
+    SECTION("raw_json and as")
+    {
+        CHECK(doc["address"].raw_json() == R"({"city" : "Toronto", "zip" : null})");
+        CHECK(doc["escaped"].raw_json() == R"("line\nbreak")");
+        CHECK(doc["scores"].as<std::vector<double>>() == std::vector<double>{10, -2, 3.5, 18446744073709551615.0});
+        CHECK(doc["user"]["tags"].as<std::vector<std::string>>() == std::vector<std::string>{"a","b"});
+        CHECK(doc["address"].as<ojson>() == ojson::parse(R"({"city" : "Toronto", "zip" : null})"));
+        CHECK(doc.root().as<json>() == json::parse(input));
+        CHECK(doc["scores"][0].as<int>() == 10);
+        CHECK(doc["active"].as<bool>());
+        CHECK(doc["big"].as<std::string>() == "123456789012345678901234567890");
+    }
+}
+
+TEST_CASE("json_ondemand_document skips unread values")
+{
+    // The value of "bad" is not valid JSON, but it is never read
+    std::string input = R"({"bad" : [tru, {"x" : 1e}, "\q"], "good" : 1, "worse" : fals})";
+    json_ondemand_document doc = json_ondemand_document::parse(input);
+
+    CHECK(doc["good"].get_int64() == 1);
+    CHECK(doc["bad"].size() == 3);
+    CHECK_THROWS_AS(doc["bad"][0].get_bool(), ser_error);
+    CHECK_THROWS_AS(doc["bad"][1]["x"].get_double(), ser_error);
+    CHECK_THROWS_AS(doc["bad"][2].get_string(), ser_error);
+    CHECK_THROWS_AS(doc["worse"].get_bool(), ser_error);
+}
+
+TEST_CASE("json_ondemand_document parse")
+{
+    SECTION("from a temporary string")
+    {
+        json_ondemand_document doc = json_ondemand_document::parse(std::string(R"(["a","b"])"));
+        CHECK(doc.root().size() == 2);
+        CHECK(doc[1].get_string_view() == "b");
+    }
+
+    SECTION("from a stream")
+    {
+        std::istringstream is(R"({"a":[1,{"b":2}]})");
+        json_ondemand_document doc = json_ondemand_document::parse(is);
+        CHECK(doc["a"][1]["b"].get_int64() == 2);
+    }
+
+    SECTION("moved document")
+    {
+        json_ondemand_document doc1 = json_ondemand_document::parse(std::string(R"({"key":"value"})"));
+        json_ondemand_document doc2 = std::move(doc1);
+        CHECK(doc2["key"].get_string_view() == "value");
+    }
+
+    SECTION("scalars and empty containers")
+    {
+        CHECK(json_ondemand_document::parse("17").root().get_int64() == 17);
+        CHECK(json_ondemand_document::parse(" \"x\" ").root().get_string() == "x");
+        CHECK(json_ondemand_document::parse("[]").root().empty());
+        CHECK(json_ondemand_document::parse("{}").root().size() == 0);
+        json_ondemand_document doc = json_ondemand_document::parse("{}");
+        CHECK(doc.root().object_range().begin() == doc.root().object_range().end());
+    }
+
+    SECTION("structural errors")
+    {
+        CHECK_THROWS_AS(json_ondemand_document::parse("[1,2"), ser_error);
+        CHECK_THROWS_AS(json_ondemand_document::parse("[1,2}"), ser_error);
+        CHECK_THROWS_AS(json_ondemand_document::parse("[1] 2"), ser_error);
+        CHECK_THROWS_AS(json_ondemand_document::parse("\"abc"), ser_error);
+        CHECK_THROWS_AS(json_ondemand_document::parse(""), ser_error);
+
+        json_ondemand_document doc = json_ondemand_document::parse("{\"a\" : [1,\n2,\n]}");
+        JSONCONS_TRY
+        {
+            doc["a"].size();
+            CHECK(false);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::extra_comma);
+            CHECK(e.line() == 3);
+            CHECK(e.column() == 2);
+        }
+    }
+
+    SECTION("nesting depth")
+    {
+        json_options options;
+        options.max_nesting_depth(2);
+        CHECK_THROWS_AS(json_ondemand_document::parse("[[[1]]]", options), ser_error);
+        CHECK(json_ondemand_document::parse("[[1]]", options)[0][0].get_int64() == 1);
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("json::parse_insitu tests")
+{
+    SECTION("strings refer to the buffer")
+    {
+        std::string input = R"({"first" : "no escapes", "second" : ["a\tbé😀", "\"quoted\""]})";
+        json expected = json::parse(input);
+
+        std::string buffer = input;
+        json j = json::parse_insitu(buffer);
+        CHECK(j == expected);
+
+        const char* first = buffer.data();
+        const char* last = buffer.data() + buffer.size();
+        const json& cj = j;
+        for (const json* s : {&cj["first"], &cj["second"][0], &cj["second"][1]})
+        {
+            CHECK(s->storage_kind() == json_storage_kind::string_view_value);
+            CHECK(s->as_string_view().data() >= first);
+            CHECK(s->as_string_view().data() < last);
+            CHECK(std::string(s->as_cstring()) == s->as<std::string>());
+        }
+        CHECK(j["second"][0].as<std::string>() == "a\tb\xC3\xA9\xF0\x9F\x98\x80");
+        CHECK(j["second"][1].as<std::string>() == "\"quoted\"");
+    }
+
+    SECTION("root string")
+    {
+        std::string buffer = R"("a\nb")";
+        json j = json::parse_insitu(buffer);
+        CHECK(j.storage_kind() == json_storage_kind::string_view_value);
+        CHECK(j.as<std::string>() == "a\nb");
+    }
+
+    SECTION("other values")
+    {
+        std::string input = R"([1, -2, 3.5, 123456789012345678901234567890, true, null, {}, []])";
+        std::string buffer = input;
+        CHECK(json::parse_insitu(buffer) == json::parse(input));
+    }
+
+    SECTION("lossless numbers are copied")
+    {
+        auto options = json_options{}.lossless_number(true);
+        std::string buffer = "[1.5,2.25]";
+        json j = json::parse_insitu(buffer, options);
+        CHECK(j[0].storage_kind() == json_storage_kind::short_string_value);
+        CHECK(j[0].as<std::string>() == "1.5");
+        CHECK(j[1].as<std::string>() == "2.25");
+    }
+
+    SECTION("ojson")
+    {
+        std::string buffer = R"({"b" : "x", "a" : "y"})";
+        ojson j = ojson::parse_insitu(buffer);
+        CHECK(j.object_range().begin()->key() == "b");
+        CHECK(j["a"].as_string_view().data() > buffer.data());
+    }
+
+    SECTION("errors")
+    {
+        std::string buffer = R"({"a" : "b",})";
+        CHECK_THROWS_AS(json::parse_insitu(buffer), ser_error);
+    }
+}
@@ -227,3 +227,36 @@ TEST_CASE("json_parser position")
     }
 }
 
+
+TEST_CASE("json_parser line and column after long runs of whitespace")
+{
+    std::string indent(70, ' ');
+    std::string input = "[\n" + indent + "1,\n\t\t\t\t" + indent + "\t2,\n" + indent + "  x]";
+
+    SECTION("whole input")
+    {
+        json_parser parser;
+        default_json_visitor visitor;
+        std::error_code ec;
+        parser.update(input.data(), input.size());
+        parser.finish_parse(visitor, ec);
+        CHECK(ec == json_errc::expected_value);
+        CHECK(parser.line() == 4);
+        CHECK(parser.column() == indent.size() + 3);
+    }
+
+    SECTION("one character at a time")
+    {
+        json_parser parser;
+        default_json_visitor visitor;
+        std::error_code ec;
+        for (std::size_t i = 0; i < input.size() && !ec; ++i)
+        {
+            parser.update(input.data() + i, 1);
+            parser.parse_some(visitor, ec);
+        }
+        CHECK(ec == json_errc::expected_value);
+        CHECK(parser.line() == 4);
+        CHECK(parser.column() == indent.size() + 3);
+    }
+}
@@ -29,5 +29,34 @@ TEST_CASE("json storage tests")
     CHECK(json_storage_kind::object_value == var8.storage_kind());
     json var9(123456789.9, semantic_tag::none);
     CHECK(json_storage_kind::double_value == var9.storage_kind());
+    json var10(string_view_arg, "Refers to a string literal", semantic_tag::none);
+    CHECK(json_storage_kind::string_view_value == var10.storage_kind());
+}
+
+TEST_CASE("json string_view storage tests")
+{
+    std::string s = "A string that is not copied";
+    json j(string_view_arg, s);
+
+    CHECK(j.is_string());
+    CHECK(j.as_string_view().data() == s.data());
+    CHECK(j.as_cstring() == s.c_str());
+    CHECK(j == json(s));
+    CHECK(json(s) == j);
+    CHECK_FALSE(j.empty());
+
+    json copy(j);
+    CHECK(json_storage_kind::string_view_value == copy.storage_kind());
+    CHECK(copy.as_string_view().data() == s.data());
+
+    json other(1);
+    other.swap(copy);
+    CHECK(copy == json(1));
+    CHECK(other.as_string_view().data() == s.data());
+
+    json arr(json_array_arg);
+    arr.push_back(j);
+    arr.emplace_back(string_view_arg, s);
+    CHECK(arr.to_string() == "[\"A string that is not copied\",\"A string that is not copied\"]");
 }
 
@@ -0,0 +1,273 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_tape_reader.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string read_with_tape(const std::string& input,
+                               const json_options& options = json_options())
+    {
+        std::string output;
+        compact_json_string_encoder encoder(output, options);
+        json_tape_reader reader(input, encoder, options);
+        reader.read();
+        return output;
+    }
+
+    std::string read_with_parser(const std::string& input,
+                                 const json_options& options = json_options())
+    {
+        std::string output;
+        compact_json_string_encoder encoder(output, options);
+        json_string_reader reader(input, encoder, options);
+        reader.read();
+        return output;
+    }
+
+    void check_same_error(const std::string& input)
+    {
+        std::error_code ec1;
+        json_decoder<json> decoder1;
+        json_string_reader reader1(input, decoder1);
+        reader1.read(ec1);
+
+        std::error_code ec2;
+        json_decoder<json> decoder2;
+        json_tape_reader reader2(input, decoder2);
+        reader2.read(ec2);
+
+        INFO(input);
+        CHECK(ec1);
+        CHECK(ec2 == ec1);
+        CHECK(reader2.line() == reader1.line());
+        CHECK(reader2.column() == reader1.column());
+    }
+
+} // namespace
+
+TEST_CASE("json_tape_reader same events as json_reader")
+{
+    std::vector<std::string> inputs = {
+        "0", "-1", "true", "false", "null", "\"\"", "[]", "{}", "[[]]", "[{}]",
+        "  \r\n\t 17 \n ",
+        "[1,-2,3.5,-0.0,1e10,1E-10,2.5e+3,18446744073709551615,-9223372036854775808]",
+        "[123456789012345678901234567890,-123456789012345678901234567890]",
+        R"({"a":1,"b":[true,false,null],"c":{"d":"e"},"":""})",
+        R"(["\"\\\/\b\f\n\r\t","\u0041\u00e9\u4e2d\uD83D\uDE00","caf\u00c3\u00a9"])",
+        "[\"\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\"]",
+        R"({"key with spaces" : [ 1 , 2 , { "x" : [ ] } ] , "k2":{}})"
+    };
+
+    for (const auto& input : inputs)
+    {
+        CHECK(read_with_tape(input) == read_with_parser(input));
+        CHECK(json::parse(input) == decode_json<json>(read_with_tape(input)));
+    }
+}
+
+TEST_CASE("json_tape_reader strings across blocks")
+{
+    SECTION("strings and escapes at every offset")
+    {
+        for (std::size_t n = 0; n < 140; ++n)
+        {
+            std::string s(n, 'x');
+            std::string input = "[\"" + s + "\",\"" + s + "\\\"" + s + "\\\\\",\"\\\\\\\\" + s + "\",{\"" + s + "\":" + std::to_string(n) + "}]";
+            CHECK(read_with_tape(input) == read_with_parser(input));
+        }
+    }
+
+    SECTION("runs of backslashes ending at a block boundary")
+    {
+        for (std::size_t pad = 0; pad < 70; ++pad)
+        {
+            for (std::size_t count = 1; count < 8; ++count)
+            {
+                std::string input = "[" + std::string(pad, ' ') + "\"" + std::string(2*count, '\\') + "\", \"" + std::string(2*count, '\\') + "\\\"\"]";
+                CHECK(read_with_tape(input) == read_with_parser(input));
+            }
+        }
+    }
+
+    SECTION("structural characters inside strings")
+    {
+        std::string input = R"(["{[,:]}", {"{":"}", "[":"]"}, ":,", "\"{\\"])";
+        CHECK(read_with_tape(input) == read_with_parser(input));
+    }
+}
+
+TEST_CASE("json_tape_reader deep nesting")
+{
+    std::string input;
+    for (int i = 0; i < 500; ++i)
+    {
+        input += (i % 2 == 0) ? "[" : "{\"a\":";
+    }
+    input += "0";
+    for (int i = 499; i >= 0; --i)
+    {
+        input += (i % 2 == 0) ? "]" : "}";
+    }
+    CHECK(read_with_tape(input) == read_with_parser(input));
+
+    json_options options;
+    options.max_nesting_depth(100);
+    std::string output;
+    compact_json_string_encoder encoder(output);
+    json_tape_reader reader(input, encoder, options);
+    std::error_code ec;
+    reader.read(ec);
+    CHECK(ec == json_errc::max_nesting_depth_exceeded);
+}
+
+TEST_CASE("json_tape_reader options")
+{
+    SECTION("lossless_number")
+    {
+        json_options options;
+        options.lossless_number(true);
+        std::string input = "[1.10,-2.5e-3,100]";
+        CHECK(read_with_tape(input, options) == read_with_parser(input, options));
+    }
+    SECTION("nan, inf and -inf replacements")
+    {
+        json_options options;
+        options.nan_to_str("NaN").inf_to_str("Inf").neginf_to_str("-Inf");
+        std::string input = R"(["NaN","Inf","-Inf","other"])";
+
+        json_decoder<json> decoder;
+        json_tape_reader reader(input, decoder, options);
+        reader.read();
+        json j = decoder.get_result();
+        REQUIRE(j.size() == 4);
+        CHECK(std::isnan(j[0].as<double>()));
+        CHECK(j[1].as<double>() == std::numeric_limits<double>::infinity());
+        CHECK(j[2].as<double>() == -std::numeric_limits<double>::infinity());
+        CHECK(j[3].as<std::string>() == "other");
+    }
+}
+
+TEST_CASE("json_tape_reader falls back to json_parser")
+{
+    SECTION("errors")
+    {
+        std::vector<std::string> inputs = {
+            "[", "]", "{", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "{1:2}",
+            "tru", "nul", "falsey", "01", "-", "1.", "1e", "[\"abc", "\"\\x\"", "\"\\uD800\"",
+            "\"\x01\"", "\"\xff\"", "[1]x", "{\"a\":1}}", "[\n1,\n2,\n]"
+        };
+        for (const auto& input : inputs)
+        {
+            check_same_error(input);
+        }
+    }
+
+    SECTION("comments")
+    {
+        std::string input = "// comment\n[1, /* two */ 2]";
+        CHECK(read_with_tape(input) == "[1,2]");
+    }
+
+    SECTION("read() throws ser_error")
+    {
+        std::string input = "[1,\n2,\n}";
+        json_decoder<json> decoder;
+        json_tape_reader reader(input, decoder);
+        REQUIRE_THROWS_AS(reader.read(), ser_error);
+    }
+}
+
+TEST_CASE("json_tape_reader stream source")
+{
+    std::string input = R"({"a":[1,2,3],"b":"some text"})";
+    std::istringstream is(input);
+
+    json_decoder<json> decoder;
+    basic_json_tape_reader<stream_source<char>> reader(is, decoder);
+    reader.read();
+    CHECK(decoder.get_result() == json::parse(input));
+}
+
+TEST_CASE("json_tape_reader line and column")
+{
+    std::string input = "[\n  1,\r\n  {\"a\" : true}\r  ]";
+
+    struct position_visitor : public default_json_visitor
+    {
+        std::vector<std::pair<std::size_t,std::size_t>> positions;
+
+        bool visit_uint64(uint64_t, semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            positions.emplace_back(context.line(), context.column());
+            return true;
+        }
+        bool visit_bool(bool, semantic_tag, const ser_context& context, std::error_code&) override
+        {
+            positions.emplace_back(context.line(), context.column());
+            return true;
+        }
+        bool visit_end_array(const ser_context& context, std::error_code&) override
+        {
+            positions.emplace_back(context.line(), context.column());
+            return true;
+        }
+    };
+
+    position_visitor visitor;
+    json_tape_reader reader(input, visitor);
+    reader.read();
+    REQUIRE(visitor.positions.size() == 3);
+    CHECK(visitor.positions[0] == std::make_pair<std::size_t,std::size_t>(2,3));
+    CHECK(visitor.positions[1] == std::make_pair<std::size_t,std::size_t>(3,10));
+    CHECK(visitor.positions[2] == std::make_pair<std::size_t,std::size_t>(4,3));
+}
+
+TEST_CASE("json_tape")
+{
+    std::string input = R"({"a":[1,2.5,"x"],"b":{},"c":-3})";
+
+    json_tape tape;
+    json_tape_builder builder;
+    std::error_code ec;
+    builder.build(input.data(), input.size(), tape, ec);
+    REQUIRE_FALSE(ec);
+
+    REQUIRE(tape.type(0) == tape_type::begin_object);
+    CHECK(tape.count(0) == 3);
+    CHECK(tape.end_of(0) == tape.size() - 1);
+    CHECK(tape.type(tape.end_of(0)) == tape_type::end_object);
+
+    REQUIRE(tape.type(1) == tape_type::key);
+    CHECK(tape.string(1) == "a");
+    REQUIRE(tape.type(2) == tape_type::begin_array);
+    CHECK(tape.count(2) == 3);
+    CHECK(tape.source_offset(2) == 5);
+
+    // next skips the whole array
+    std::size_t i = tape.next(2);
+    REQUIRE(tape.type(i) == tape_type::key);
+    CHECK(tape.string(i) == "b");
+    i = tape.next(i);
+    REQUIRE(tape.type(i) == tape_type::begin_object);
+    CHECK(tape.count(i) == 0);
+    i = tape.next(i);
+    CHECK(tape.string(i) == "c");
+    i = tape.next(i);
+    REQUIRE(tape.type(i) == tape_type::int64_value);
+    CHECK(tape.int64_value(i) == -3);
+
+    CHECK(tape.type(3) == tape_type::uint64_value);
+    CHECK(tape.uint64_value(3) == 1);
+    CHECK(tape.type(tape.next(3)) == tape_type::double_value);
+    CHECK(tape.double_value(tape.next(3)) == 2.5);
+}
@@ -0,0 +1,180 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("mmap_source tests")
+{
+    std::string path = "./corelib/input/address-book.json";
+    json expected;
+    {
+        std::ifstream is(path);
+        expected = json::parse(is);
+    }
+
+    SECTION("contiguous sequence")
+    {
+        mmap_source source(path);
+        REQUIRE(source.size() > 0);
+        CHECK(source.data()[0] == '{');
+        CHECK(std::string(source.begin(), source.end()).find("address-book") != std::string::npos);
+        CHECK(source.position() == 0);
+        CHECK_FALSE(source.eof());
+    }
+
+    SECTION("json::parse")
+    {
+        mmap_source source(path);
+        CHECK(json::parse(source) == expected);
+        CHECK(decode_json<json>(source) == expected);
+    }
+
+    SECTION("as the source of a reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source> reader(mmap_source(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json cursors")
+    {
+        mmap_source source(path);
+        json_stream_cursor cursor1(source);
+        json_string_cursor cursor2(source);
+        for (auto* cursor : {static_cast<basic_staj_cursor<char>*>(&cursor1), static_cast<basic_staj_cursor<char>*>(&cursor2)})
+        {
+            std::size_t names = 0;
+            for (; !cursor->done(); cursor->next())
+            {
+                if (cursor->current().event_type() == staj_event_type::key && cursor->current().get<std::string>() == "name")
+                {
+                    ++names;
+                }
+            }
+            CHECK(names == 2);
+        }
+    }
+
+    SECTION("source interface")
+    {
+        mmap_source source(path);
+        std::size_t size = source.size();
+        char c;
+        CHECK(source.read(&c, 1) == 1);
+        CHECK(c == '{');
+        source.ignore(2);
+        CHECK(source.position() == 3);
+        auto buffer = source.read_buffer();
+        CHECK(buffer.size() == size - 3);
+        CHECK(source.eof());
+        CHECK(source.peek().eof);
+    }
+
+    SECTION("move")
+    {
+        mmap_source source1(path);
+        const char* data = source1.data();
+        mmap_source source2(std::move(source1));
+        CHECK(source2.data() == data);
+        CHECK(source1.size() == 0);
+        mmap_source source3;
+        source3 = std::move(source2);
+        CHECK(source3.data() == data);
+    }
+}
+
+TEST_CASE("mmap_source errors and empty files")
+{
+    SECTION("missing file")
+    {
+        CHECK_THROWS_AS(mmap_source("./corelib/input/no-such-file.json"), std::system_error);
+
+        std::error_code ec;
+        mmap_source source("./corelib/input/no-such-file.json", ec);
+        CHECK(ec);
+        CHECK(source.is_error());
+        CHECK(source.eof());
+    }
+
+    SECTION("empty file")
+    {
+        {
+            std::ofstream os("./corelib/output/empty.json", std::ios::binary | std::ios::out);
+        }
+        mmap_source source("./corelib/output/empty.json");
+        CHECK(source.size() == 0);
+        CHECK(source.eof());
+        CHECK_FALSE(source.is_error());
+        CHECK_THROWS_AS(json::parse(source), ser_error);
+    }
+}
+
+TEST_CASE("mmap_bytes_source tests")
+{
+    ojson j = ojson::parse(R"({"a" : [1, 2.5, "three"], "b" : {"c" : true}})");
+    {
+        std::ofstream os("./corelib/output/mmap.cbor", std::ios::binary | std::ios::out);
+        cbor::encode_cbor(j, os);
+    }
+
+    SECTION("decode_cbor")
+    {
+        mmap_bytes_source source("./corelib/output/mmap.cbor");
+        CHECK(cbor::decode_cbor<ojson>(source) == j);
+    }
+
+    SECTION("cbor_bytes_cursor")
+    {
+        mmap_bytes_source source("./corelib/output/mmap.cbor");
+        cbor::cbor_bytes_cursor cursor(source);
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            ++count;
+        }
+        CHECK(count == 13);
+    }
+
+    SECTION("as the source of a cursor")
+    {
+        cbor::basic_cbor_cursor<mmap_bytes_source> cursor(mmap_bytes_source("./corelib/output/mmap.cbor"));
+        CHECK(cursor.current().event_type() == staj_event_type::begin_object);
+    }
+}
+
+TEST_CASE("mmap_source with csv")
+{
+    mmap_source source("./csv/input/countries.csv");
+
+    csv::csv_options options;
+    options.assume_header(true);
+
+    SECTION("csv_string_reader")
+    {
+        json_decoder<json> decoder;
+        csv::csv_string_reader reader(source, decoder, options);
+        reader.read();
+        json result = decoder.get_result();
+        REQUIRE(result.size() == 4);
+        CHECK(result[1]["name"].as<std::string>() == "FRENCH SOUTHERN TERRITORIES, D.R. OF");
+    }
+
+    SECTION("as the source of a reader")
+    {
+        json_decoder<json> decoder;
+        csv::basic_csv_reader<char,mmap_source> reader(mmap_source("./csv/input/countries.csv"), decoder, options);
+        reader.read();
+        CHECK(decoder.get_result().size() == 4);
+    }
+}
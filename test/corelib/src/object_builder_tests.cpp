@@ -0,0 +1,76 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("object_builder tests")
+{
+    SECTION("json")
+    {
+        object_builder<json> builder;
+        builder.reserve(4);
+        builder.append("c", 3);
+        builder.append("a", 1);
+        builder.append("b", "two");
+        builder.append("a", 4);
+        CHECK(builder.size() == 4);
+
+        json j = builder.finish();
+        CHECK(builder.size() == 0);
+
+        CHECK(j == json::parse(R"({"a":1,"b":"two","c":3})"));
+        CHECK(j.object_range().begin()->key() == "a");
+    }
+
+    SECTION("ojson")
+    {
+        object_builder<ojson> builder;
+        builder.append("c", 3);
+        builder.append("a", 1);
+        builder.append("c", 5);
+        builder.append("b", json_array_arg);
+
+        ojson j = builder.finish();
+        CHECK(j.to_string() == R"({"c":3,"a":1,"b":[]})");
+    }
+
+    SECTION("empty")
+    {
+        object_builder<json> builder;
+        json j = builder.finish();
+        CHECK(j.is_object());
+        CHECK(j.empty());
+    }
+
+    SECTION("many members")
+    {
+        object_builder<json> builder;
+        for (int i = 9999; i >= 0; --i)
+        {
+            builder.append(std::to_string(i), i);
+        }
+        json j = builder.finish();
+
+        REQUIRE(j.size() == 10000);
+        CHECK(j.object_range().begin()->key() == "0");
+        CHECK((j.object_range().end()-1)->key() == "9999");
+        CHECK(j.at("4321").as<int>() == 4321);
+    }
+}
+
+TEST_CASE("object_builder map with non-string keys")
+{
+    std::map<int,std::string> m = {{2,"two"},{10,"ten"},{1,"one"}};
+
+    json j(m);
+    CHECK(j.to_string() == R"({"1":"one","10":"ten","2":"two"})");
+
+    ojson o(m);
+    CHECK(o.to_string() == R"({"1":"one","2":"two","10":"ten"})");
+    CHECK((o.as<std::map<int,std::string>>() == m));
+}
@@ -332,6 +332,182 @@ TEST_CASE("test_ojson_merge_or_update_move")
     }
 }
 
+TEST_CASE("ojson wide object tests")
+{
+    // Wide enough for lookups to go through the hash index
+    const std::size_t n = 1000;
+
+    ojson doc;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        doc.insert_or_assign("key" + std::to_string(i), i);
+    }
+
+    SECTION("find preserves insertion order")
+    {
+        REQUIRE(doc.size() == n);
+        CHECK(doc.object_range().begin()->key() == "key0");
+        CHECK((doc.object_range().end()-1)->key() == "key999");
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            CHECK(doc.at("key" + std::to_string(i)).as<std::size_t>() == i);
+        }
+        CHECK_FALSE(doc.contains("key1000"));
+    }
+
+    SECTION("insert_or_assign and try_emplace existing keys")
+    {
+        auto result = doc.insert_or_assign("key500", "five hundred");
+        CHECK_FALSE(result.second);
+        CHECK(doc.try_emplace("key501", "ignored").second == false);
+        CHECK(doc.try_emplace("key1000", 1000).second);
+
+        CHECK(doc.size() == n + 1);
+        CHECK(doc["key500"].as<std::string>() == "five hundred");
+        CHECK(doc["key501"].as<int>() == 501);
+        CHECK(doc["key1000"].as<int>() == 1000);
+    }
+
+    SECTION("erase")
+    {
+        doc.erase("key0");
+        doc.erase(doc.object_range().begin() + 100, doc.object_range().begin() + 200);
+        doc.erase(doc.find("key999"));
+
+        REQUIRE(doc.size() == n - 102);
+        CHECK_FALSE(doc.contains("key0"));
+        CHECK_FALSE(doc.contains("key150"));
+        CHECK_FALSE(doc.contains("key999"));
+        CHECK(doc.at("key100").as<int>() == 100);
+        CHECK(doc.at("key201").as<int>() == 201);
+        CHECK(doc.object_range().begin()->key() == "key1");
+
+        doc.insert_or_assign("key0", 0);
+        CHECK((doc.object_range().end()-1)->key() == "key0");
+        CHECK(doc.at("key0").as<int>() == 0);
+    }
+
+    SECTION("merge and merge_or_update")
+    {
+        ojson source;
+        source.insert_or_assign("key10", "ten");
+        source.insert_or_assign("extra", true);
+
+        ojson merged(doc);
+        merged.merge(source);
+        CHECK(merged.size() == n + 1);
+        CHECK(merged.at("key10").as<int>() == 10);
+        CHECK(merged.at("extra").as<bool>());
+
+        doc.merge_or_update(std::move(source));
+        CHECK(doc.size() == n + 1);
+        CHECK(doc.at("key10").as<std::string>() == "ten");
+        CHECK(doc.at("extra").as<bool>());
+    }
+
+    SECTION("copy, move, swap and clear")
+    {
+        ojson copy(doc);
+        CHECK(copy.at("key777").as<int>() == 777);
+
+        ojson moved(std::move(copy));
+        CHECK(moved.at("key778").as<int>() == 778);
+
+        ojson other = ojson::parse(R"({"a":1})");
+        swap(moved, other);
+        CHECK(other.at("key779").as<int>() == 779);
+        CHECK(moved.at("a").as<int>() == 1);
+
+        other.clear();
+        CHECK_FALSE(other.contains("key779"));
+        other.insert_or_assign("key779", 1);
+        CHECK(other.at("key779").as<int>() == 1);
+    }
+
+    SECTION("parse with duplicate keys")
+    {
+        std::string input = "{";
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            input.append("\"key" + std::to_string(i % 400) + "\":" + std::to_string(i) + ",");
+        }
+        input.append("\"last\":true}");
+
+        ojson j = ojson::parse(input);
+        REQUIRE(j.size() == 401);
+        CHECK(j.object_range().begin()->key() == "key0");
+        CHECK(j.at("key399").as<int>() == 399);
+        CHECK(j.at("last").as<bool>());
+    }
+}
+
+namespace {
+
+    // Fails to allocate the member index, the only std::size_t buffer an object makes
+    template <class T>
+    struct index_failing_allocator
+    {
+        using value_type = T;
+
+        index_failing_allocator() = default;
+
+        template <class U>
+        index_failing_allocator(const index_failing_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            if (std::is_same<T,std::size_t>::value)
+            {
+                throw std::bad_alloc();
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const index_failing_allocator&, const index_failing_allocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const index_failing_allocator&, const index_failing_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("ojson wide object without an index")
+{
+    using index_failing_ojson = basic_json<char,order_preserving_policy,index_failing_allocator<char>>;
+
+    const std::size_t n = 100;
+
+    index_failing_ojson doc;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        doc.insert_or_assign("key" + std::to_string(i), i);
+    }
+
+    REQUIRE(doc.size() == n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        CHECK(doc.at("key" + std::to_string(i)).as<std::size_t>() == i);
+    }
+    CHECK_FALSE(doc.contains("key100"));
+
+    doc.erase("key0");
+    CHECK_FALSE(doc.contains("key0"));
+    CHECK(doc.try_emplace("key0", 0).second);
+    CHECK((doc.object_range().end()-1)->key() == "key0");
+}
+
 #if defined(JSONCONS_HAS_STATEFUL_ALLOCATOR)
 
 #include <common/FreeListAllocator.hpp>
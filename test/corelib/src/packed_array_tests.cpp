@@ -0,0 +1,343 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("packed array tests")
+{
+    std::vector<double> values = {1.5, 2.5, 3.5};
+    json j(packed_array_arg, jsoncons::span<const double>(values));
+
+    SECTION("read as an array")
+    {
+        CHECK(j.storage_kind() == json_storage_kind::packed_array_value);
+        CHECK(j.type() == json_type::array_value);
+        CHECK(j.is_array());
+        REQUIRE(j.size() == 3);
+        CHECK_FALSE(j.empty());
+
+        const json& cj = j;
+        CHECK(cj[0] == 1.5);
+        CHECK(cj.at(2) == 3.5);
+        CHECK_THROWS_AS(cj.at(3), std::out_of_range);
+        CHECK(cj.as<std::vector<double>>() == values);
+        double sum = 0;
+        for (const auto& item : cj.array_range())
+        {
+            sum += item.as<double>();
+        }
+        CHECK(sum == 7.5);
+        CHECK(j.storage_kind() == json_storage_kind::packed_array_value);
+        CHECK(j.to_string() == "[1.5,2.5,3.5]");
+    }
+
+    SECTION("compare with arrays")
+    {
+        json a = json::parse("[1.5,2.5,3.5]");
+        CHECK(j == a);
+        CHECK(a == j);
+        CHECK(j == json(j));
+        CHECK(j < json::parse("[1.5,2.5,4]"));
+        CHECK(json::parse("[1.5,2.5]") < j);
+        CHECK(j != json::parse(R"({"a":1})"));
+        CHECK(j != json(null_type()));
+    }
+
+    SECTION("modify")
+    {
+        json k = j;
+        k.push_back(4.5);
+        CHECK(k.storage_kind() == json_storage_kind::array_value);
+        CHECK(k == json::parse("[1.5,2.5,3.5,4.5]"));
+        CHECK(j.size() == 3);
+
+        json m = j;
+        m[1] = "two";
+        CHECK(m == json::parse(R"([1.5,"two",3.5])"));
+
+        json n = j;
+        n.clear();
+        CHECK(n.is_array());
+        CHECK(n.empty());
+    }
+
+    SECTION("references obtained through const access")
+    {
+        const json& cj = j;
+        const json* first = std::addressof(cj[0]);
+        j.erase(j.array_range().begin() + 1);
+        CHECK(j.storage_kind() == json_storage_kind::array_value);
+        CHECK(std::addressof(j[0]) == first);
+        CHECK(j == json::parse("[1.5,3.5]"));
+    }
+
+    SECTION("as_typed_array_view")
+    {
+        typed_array_view v = j.as_typed_array_view();
+        REQUIRE(v.type() == typed_array_type::double_value);
+        REQUIRE(v.size() == 3);
+        CHECK(v.data(double_array_arg)[1] == 2.5);
+
+        CHECK_THROWS(json::parse("[1,2]").as_typed_array_view());
+    }
+}
+
+TEST_CASE("packed array reads in place")
+{
+    std::vector<int32_t> values = {1, 2, 3};
+    json j(packed_array_arg, jsoncons::span<const int32_t>(values));
+    const json& cj = j;
+    const std::size_t usage = cj.memory_usage();
+
+    SECTION("array_value_range")
+    {
+        int64_t sum = 0;
+        for (const auto& item : cj.array_value_range())
+        {
+            CHECK(item.is_int64());
+            sum += item.as<int64_t>();
+        }
+        CHECK(sum == 6);
+        auto it = cj.array_value_range().begin();
+        CHECK(it->as<int>() == 1);
+        CHECK((*++it).as<int>() == 2);
+        CHECK(cj.memory_usage() == usage);
+    }
+
+    SECTION("compare, hash, dump and as")
+    {
+        json a = json::parse("[1,2,3]");
+        CHECK(cj == a);
+        CHECK(json_hash(cj) == json_hash(a));
+        json_hash_cache<json> cache;
+        CHECK(cache.deep_equal(cj, a));
+        CHECK(cj.to_string() == "[1,2,3]");
+        CHECK(cj.as<std::vector<int>>() == std::vector<int>{1, 2, 3});
+        CHECK(cj.is<std::vector<int>>());
+        CHECK(cj.memory_usage() == usage);
+    }
+
+    SECTION("access by reference builds the elements")
+    {
+        CHECK(cj.as<std::vector<json>>()[2] == 3);
+        CHECK(cj.memory_usage() > usage);
+        j.shrink_to_fit();
+        CHECK(cj.memory_usage() == usage);
+    }
+}
+
+TEST_CASE("packed array element types")
+{
+    SECTION("integers")
+    {
+        std::vector<int16_t> values = {-1, 0, (std::numeric_limits<int16_t>::max)()};
+        json j(packed_array_arg, jsoncons::span<const int16_t>(values));
+        const json& cj = j;
+        CHECK(cj[0].is_int64());
+        CHECK(cj[0] == -1);
+        CHECK(cj[2].as<int16_t>() == (std::numeric_limits<int16_t>::max)());
+        CHECK(j.to_string() == "[-1,0,32767]");
+    }
+
+    SECTION("unsigned integers")
+    {
+        std::vector<uint64_t> values = {0, (std::numeric_limits<uint64_t>::max)()};
+        json j(packed_array_arg, jsoncons::span<const uint64_t>(values), semantic_tag::none);
+        CHECK(j == json::parse("[0,18446744073709551615]"));
+    }
+
+    SECTION("half precision")
+    {
+        std::vector<uint16_t> values = {0x3c00, 0x4000};
+        json j(packed_array_arg, half_arg, jsoncons::span<const uint16_t>(values));
+        const json& cj = j;
+        CHECK(cj[0].storage_kind() == json_storage_kind::half_value);
+        CHECK(cj[1].as<double>() == 2.0);
+        CHECK(j.as_typed_array_view().type() == typed_array_type::half_value);
+    }
+
+    SECTION("empty")
+    {
+        std::vector<float> values;
+        json j(packed_array_arg, jsoncons::span<const float>(values));
+        CHECK(j.is_array());
+        CHECK(j.empty());
+        CHECK(j == json(json_array_arg));
+        CHECK(j.to_string() == "[]");
+    }
+}
+
+TEST_CASE("json decoder min_packed_array_length")
+{
+    json_options options;
+    options.min_packed_array_length(3);
+
+    SECTION("numbers of one kind")
+    {
+        json j = json::parse(R"({"d":[1.5,2.5,3.5],"i":[1,-2,3],"u":[1,2,18446744073709551615]})", options);
+        CHECK(j["d"].as_typed_array_view().type() == typed_array_type::double_value);
+        CHECK(j["i"].as_typed_array_view().type() == typed_array_type::int64_value);
+        CHECK(j["u"].as_typed_array_view().type() == typed_array_type::uint64_value);
+        CHECK(j.to_string() == R"({"d":[1.5,2.5,3.5],"i":[1,-2,3],"u":[1,2,18446744073709551615]})");
+    }
+
+    SECTION("arrays that are not packed")
+    {
+        json j = json::parse(R"({"short":[1,2],"mixed":[1,2.5,3],"large":[-1,2,18446744073709551615],"strings":[1,"2",3]})", options);
+        for (const auto& member : j.object_range())
+        {
+            CHECK(member.value().storage_kind() == json_storage_kind::array_value);
+        }
+    }
+
+    SECTION("default")
+    {
+        json j = json::parse("[1,2,3,4]");
+        CHECK(j.storage_kind() == json_storage_kind::array_value);
+    }
+}
+
+TEST_CASE("array_value_range tests")
+{
+    SECTION("an ordinary array")
+    {
+        json b = json::parse(R"([1,"two",[3]])");
+        const json& cb = b;
+        std::vector<json> items;
+        for (const auto& item : cb.array_value_range())
+        {
+            items.push_back(item);
+        }
+        REQUIRE(items.size() == 3);
+        CHECK(items[0] == 1);
+        CHECK(items[1] == "two");
+        CHECK(items[2] == json::parse("[3]"));
+        CHECK(json_hash(cb) == json_hash(json::parse(R"([1,"two",[3]])")));
+        CHECK_THROWS_AS(json(1).array_value_range(), std::domain_error);
+    }
+}
+
+TEST_CASE("nan boxed packed arrays")
+{
+    using boxed_json = basic_json<char,nan_boxed_policy<sorted_policy>>;
+
+    SECTION("elements that fit in a word")
+    {
+        std::string input = R"([null,true,false,-140737488355328,140737488355327,281474976710655,1.5,-0.0,1e308])";
+        boxed_json j = boxed_json::parse(input);
+        REQUIRE(j.storage_kind() == json_storage_kind::packed_array_value);
+        CHECK(j.is_array());
+        REQUIRE(j.size() == 9);
+        CHECK(j.to_string() == json::parse(input).to_string());
+        boxed_json unboxed = j;
+        unboxed.reserve(unboxed.size());
+        REQUIRE(unboxed.storage_kind() == json_storage_kind::array_value);
+        CHECK(j == unboxed);
+        CHECK(unboxed == j);
+        CHECK(json_hash(j) == json_hash(unboxed));
+
+        const boxed_json& cj = j;
+        std::vector<json_storage_kind> kinds;
+        for (const auto& item : cj.array_value_range())
+        {
+            kinds.push_back(item.storage_kind());
+        }
+        CHECK(kinds == std::vector<json_storage_kind>{json_storage_kind::null_value, json_storage_kind::bool_value,
+            json_storage_kind::bool_value, json_storage_kind::int64_value, json_storage_kind::uint64_value,
+            json_storage_kind::uint64_value, json_storage_kind::double_value, json_storage_kind::double_value, 
+            json_storage_kind::double_value});
+        json_memory_stats stats = j.memory_stats();
+        CHECK(stats.packed_arrays == 1);
+        CHECK(stats.arrays == 0);
+        CHECK(stats.heap_bytes() < json::parse(input).memory_stats().heap_bytes());
+        CHECK_THROWS_AS(j.as_typed_array_view(), std::domain_error);
+
+        CHECK(cj[3].as<int64_t>() == -140737488355328);
+        CHECK(std::signbit(cj[7].as<double>()));
+    }
+
+    SECTION("elements kept beside the words")
+    {
+        std::string input = R"([1,2,3,4,5,"a string that is not short",[6,7],-9223372036854775808])";
+        boxed_json j = boxed_json::parse(input);
+        REQUIRE(j.storage_kind() == json_storage_kind::packed_array_value);
+        CHECK(j.to_string() == input);
+        CHECK(json_hash(j) == json_hash(json::parse(input)));
+
+        const boxed_json& cj = j;
+        CHECK(cj[5].as<std::string>() == "a string that is not short");
+        CHECK(cj[6].at(1) == 7);
+        CHECK(cj[7].as<int64_t>() == (std::numeric_limits<int64_t>::min)());
+        CHECK(cj[6].storage_kind() == json_storage_kind::packed_array_value);
+        CHECK(cj[6][0].storage_kind() == json_storage_kind::uint64_value);
+        json_hash_cache<boxed_json> cache;
+        CHECK(cache.hash(j) == json_hash(j));
+        CHECK(cache.deep_equal(j, boxed_json(j)));
+
+        std::vector<boxed_json> items = cj.as<std::vector<boxed_json>>();
+        boxed_json copy(j);
+        j.clear();
+        CHECK(items[6] == boxed_json(json_array_arg, {6, 7}));
+        CHECK(copy.to_string() == input);
+
+        json_memory_stats stats = copy.memory_stats();
+        CHECK(stats.packed_arrays == 2);
+        CHECK(stats.long_strings == 1);
+        CHECK(stats.arrays == 0);
+    }
+
+    SECTION("modify")
+    {
+        boxed_json j = boxed_json::parse(R"([1,"a string that is not short",3])");
+        REQUIRE(j.storage_kind() == json_storage_kind::packed_array_value);
+        const boxed_json& cj = j;
+        const boxed_json* second = std::addressof(cj[1]);
+        j.erase(j.array_range().begin() + 2);
+        CHECK(j.storage_kind() == json_storage_kind::array_value);
+        CHECK(std::addressof(j[1]) == second);
+        CHECK(j[1].storage_kind() == json_storage_kind::long_string_value);
+        j.push_back(4);
+        CHECK(j == boxed_json::parse(R"([1,"a string that is not short",4])"));
+
+        boxed_json k = boxed_json::parse(R"([1,"a string that is not short",3])");
+        k[1] = 2;
+        CHECK(k == boxed_json::parse("[1,2,3]"));
+        k.shrink_to_fit();
+        CHECK(k.storage_kind() == json_storage_kind::packed_array_value);
+    }
+
+    SECTION("half the memory")
+    {
+        std::string input = "[";
+        for (int i = 0; i < 1000; ++i)
+        {
+            input += i == 0 ? "" : ",";
+            input += i % 3 == 0 ? std::to_string(i) : (i % 3 == 1 ? std::to_string(i + 0.5) : "true");
+        }
+        input += "]";
+        std::size_t boxed_bytes = boxed_json::parse(input).memory_stats().heap_bytes();
+        std::size_t bytes = json::parse(input).memory_stats().heap_bytes();
+        CHECK(boxed_bytes < bytes/2 + 128);
+    }
+
+    SECTION("arrays that are not boxed")
+    {
+        boxed_json j = boxed_json::parse(R"({"strings":["a","b","c"],"objects":[{"a":1},{"b":2}],"half":[1,"a","b",2]})");
+        for (const auto& member : j.object_range())
+        {
+            CHECK(member.value().storage_kind() == json_storage_kind::array_value);
+        }
+        json k = json::parse("[1,2,3]");
+        k.shrink_to_fit();
+        CHECK(k.storage_kind() == json_storage_kind::array_value);
+    }
+}
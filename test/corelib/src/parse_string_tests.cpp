@@ -124,3 +124,41 @@ TEST_CASE("test_parse_big_string2")
 }
 
 
+
+TEST_CASE("test_parse_long_string_with_escapes")
+{
+    std::string text = "The quick brown fox jumps over the lazy dog, 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    std::string input = "[\"" + text + "\\\"" + text + "\\u00e9\\ud83d\\ude00" + text + "\\n\", \"" + text + "\"]";
+    std::string expected = text + "\"" + text + "\xC3\xA9\xF0\x9F\x98\x80" + text + "\n";
+
+    for (std::size_t i = 1; i < input.length(); ++i)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        JSONCONS_TRY
+        {
+            json_stream_reader reader(stream_source<char>(is,i), decoder);
+            reader.read();
+        }
+        JSONCONS_CATCH (const std::exception&)
+        {
+        }
+        REQUIRE(decoder.is_valid());
+        json j = decoder.get_result();
+        CHECK(j[0].as<std::string>() == expected);
+        CHECK(j[1].as<std::string>() == text);
+    }
+}
+
+TEST_CASE("test_parse_long_string_with_control_character")
+{
+    std::string text(100, 'a');
+    std::string input = "\"" + text + "\x01" + text + "\"";
+
+    std::error_code ec;
+    json_decoder<json> decoder;
+    json_string_reader reader(input, decoder);
+    reader.read(ec);
+    CHECK(ec == json_errc::illegal_control_character);
+    CHECK(reader.column() == text.size() + 3);
+}
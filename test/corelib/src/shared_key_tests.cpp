@@ -0,0 +1,145 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/shared_key.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    using shared_key_json = basic_json<char,shared_key_policy<sorted_policy>>;
+    using shared_key_ojson = basic_json<char,shared_key_policy<order_preserving_policy>>;
+
+    std::string make_records(std::size_t count)
+    {
+        std::string s = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s.append(R"({"identifier":)");
+            s.append(std::to_string(i));
+            s.append(R"(,"measurement_name":"temperature","unit_of_measure":"celsius"})");
+        }
+        s.push_back(']');
+        return s;
+    }
+
+} // namespace
+
+TEST_CASE("shared_key tests")
+{
+    SECTION("copies share the characters")
+    {
+        shared_key key1("a member name");
+        CHECK(key1.use_count() == 1);
+        shared_key key2(key1);
+        CHECK(key2.data() == key1.data());
+        CHECK(key1.use_count() == 2);
+        {
+            shared_key key3;
+            key3 = key2;
+            CHECK(key1.use_count() == 3);
+        }
+        CHECK(key1.use_count() == 2);
+
+        shared_key key4(std::move(key2));
+        CHECK(key2.empty());
+        CHECK(key4.data() == key1.data());
+        CHECK(key1.use_count() == 2);
+    }
+
+    SECTION("comparisons")
+    {
+        shared_key key("b");
+        CHECK(key == shared_key("b"));
+        CHECK(key == "b");
+        CHECK("b" == key);
+        CHECK(key == std::string("b"));
+        CHECK(key != "c");
+        CHECK(shared_key("a") < key);
+        CHECK(key < string_view("c"));
+        CHECK(key.compare("a") > 0);
+        CHECK(std::string(key) == "b");
+        string_view sv = key;
+        CHECK(sv == "b");
+    }
+
+    SECTION("empty")
+    {
+        shared_key key("");
+        CHECK(key.empty());
+        CHECK(key.use_count() == 0);
+        CHECK(*key.c_str() == 0);
+        CHECK(key == shared_key());
+    }
+}
+
+TEST_CASE("json_decoder interns shared keys")
+{
+    std::string input = make_records(100);
+
+    SECTION("sorted")
+    {
+        shared_key_json j = shared_key_json::parse(input);
+        REQUIRE(j.size() == 100);
+        const char* name = j[0].object_range().begin()->key().data();
+        for (const auto& item : j.array_range())
+        {
+            CHECK(item.object_range().begin()->key().data() == name);
+        }
+        CHECK(j[0].object_range().begin()->key().use_count() == 100);
+        CHECK(j.to_string() == json::parse(input).to_string());
+    }
+
+    SECTION("order preserving")
+    {
+        shared_key_ojson j = shared_key_ojson::parse(input);
+        REQUIRE(j.size() == 100);
+        CHECK(j[99].object_range().begin()->key() == "identifier");
+        CHECK(j[99].object_range().begin()->key().data() == j[0].object_range().begin()->key().data());
+        CHECK(j.to_string() == ojson::parse(input).to_string());
+    }
+
+    SECTION("bounded by options")
+    {
+        auto options = json_options{}.max_interned_keys(1);
+        shared_key_json j = shared_key_json::parse(input, options);
+        CHECK(j[0]["identifier"] == j[0]["identifier"]);
+        CHECK(j[0].object_range().begin()->key().data() == j[1].object_range().begin()->key().data());
+        auto it0 = j[0].object_range().begin() + 1;
+        auto it1 = j[1].object_range().begin() + 1;
+        CHECK(it0->key() == it1->key());
+        CHECK(it0->key().data() != it1->key().data());
+
+        shared_key_json j2 = decode_json<shared_key_json>(input, json_options{}.max_interned_keys(0));
+        CHECK(j2[0].object_range().begin()->key().data() != j2[1].object_range().begin()->key().data());
+        CHECK(j2 == j);
+    }
+
+    SECTION("modifying")
+    {
+        shared_key_json j = shared_key_json::parse(R"({"b":1,"a":2})");
+        j.insert_or_assign("c", 3);
+        j.try_emplace("a", 4);
+        j["d"] = 5;
+        CHECK(j.contains("c"));
+        CHECK(j.at("a") == 2);
+        j.erase("b");
+        CHECK(j.to_string() == R"({"a":2,"c":3,"d":5})");
+
+        shared_key_ojson oj = shared_key_ojson::parse(R"({"b":1,"a":2})");
+        oj.insert_or_assign("c", 3);
+        oj.erase("b");
+        CHECK(oj.to_string() == R"({"a":2,"c":3})");
+
+        std::map<std::string,int> m = j.as<std::map<std::string,int>>();
+        CHECK(m["d"] == 5);
+    }
+}
@@ -0,0 +1,288 @@
+// Copyright 2013-2023 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::size_t allocation_count = 0;
+
+    template <class T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <class U>
+        counting_allocator(const counting_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            ++allocation_count;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+
+    // Records which allocator allocated each block, to check that blocks are freed by an equal allocator
+    std::map<void*,int> block_owners;
+
+    template <class T>
+    struct propagating_allocator
+    {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        int id;
+
+        explicit propagating_allocator(int id) noexcept
+            : id(id)
+        {
+        }
+
+        template <class U>
+        propagating_allocator(const propagating_allocator<U>& other) noexcept
+            : id(other.id)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            T* p = std::allocator<T>().allocate(n);
+            block_owners[p] = id;
+            return p;
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            CHECK(block_owners[p] == id);
+            block_owners.erase(p);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const propagating_allocator& lhs, const propagating_allocator& rhs) noexcept
+        {
+            return lhs.id == rhs.id;
+        }
+
+        friend bool operator!=(const propagating_allocator& lhs, const propagating_allocator& rhs) noexcept
+        {
+            return lhs.id != rhs.id;
+        }
+    };
+
+    using small_array_json = basic_json<char,small_array_policy<sorted_policy,2>>;
+    using small_array_ojson = basic_json<char,small_array_policy<order_preserving_policy>>;
+
+} // namespace
+
+TEST_CASE("small_vector tests")
+{
+    using vector_type = jsoncons::detail::small_vector<std::string,std::allocator<std::string>,2>;
+
+    SECTION("grow past inline capacity")
+    {
+        vector_type v;
+        v.push_back("A string too long for short string optimization");
+        v.emplace_back("b");
+        CHECK(v.is_inline());
+        CHECK(v.capacity() == 2);
+
+        v.emplace_back(v[0]);
+        CHECK_FALSE(v.is_inline());
+        REQUIRE(v.size() == 3);
+        CHECK(v[0] == "A string too long for short string optimization");
+        CHECK(v[2] == "A string too long for short string optimization");
+
+        v.pop_back();
+        v.shrink_to_fit();
+        CHECK(v.is_inline());
+        CHECK(v[1] == "b");
+    }
+
+    SECTION("insert and erase")
+    {
+        vector_type v{"a", "c"};
+        v.emplace(v.begin() + 1, "b");
+        REQUIRE(v.size() == 3);
+        CHECK(v[0] == "a");
+        CHECK(v[1] == "b");
+        CHECK(v[2] == "c");
+
+        std::vector<std::string> more = {"x", "y"};
+        auto it = v.insert(v.begin(), more.begin(), more.end());
+        CHECK(it == v.begin());
+        REQUIRE(v.size() == 5);
+        CHECK(v[1] == "y");
+        CHECK(v[2] == "a");
+
+        it = v.erase(v.begin() + 1, v.begin() + 3);
+        REQUIRE(v.size() == 3);
+        CHECK(*it == "b");
+        CHECK(v == vector_type({"x", "b", "c"}));
+    }
+
+    SECTION("move and swap")
+    {
+        vector_type v1{"a"};
+        vector_type v2{"b", "c", "d"};
+
+        v1.swap(v2);
+        CHECK(v1 == vector_type({"b", "c", "d"}));
+        CHECK(v2 == vector_type({"a"}));
+        CHECK(v2.is_inline());
+
+        vector_type v3(std::move(v2));
+        CHECK(v3 == vector_type({"a"}));
+        CHECK(v2.empty());
+
+        vector_type v4(std::move(v1));
+        CHECK(v4.size() == 3);
+        CHECK(v1.empty());
+        CHECK(v1.is_inline());
+    }
+}
+
+TEST_CASE("small_vector allocator propagation tests")
+{
+    using vector_type = jsoncons::detail::small_vector<int,propagating_allocator<int>,2>;
+
+    propagating_allocator<int> alloc1(1);
+    propagating_allocator<int> alloc2(2);
+
+    SECTION("swap heap and heap")
+    {
+        vector_type v1({1, 2, 3}, alloc1);
+        vector_type v2({4, 5, 6, 7}, alloc2);
+        v1.swap(v2);
+        CHECK(v1.get_allocator() == alloc2);
+        CHECK(v2.get_allocator() == alloc1);
+        CHECK(v1 == vector_type({4, 5, 6, 7}, alloc1));
+        CHECK(v2 == vector_type({1, 2, 3}, alloc1));
+    }
+
+    SECTION("swap heap and inline")
+    {
+        vector_type v1({1, 2, 3}, alloc1);
+        vector_type v2({4}, alloc2);
+        v1.swap(v2);
+        CHECK(v1.get_allocator() == alloc2);
+        CHECK(v2.get_allocator() == alloc1);
+        CHECK(v1.is_inline());
+        CHECK(v1 == vector_type({4}, alloc1));
+        CHECK(v2 == vector_type({1, 2, 3}, alloc1));
+
+        v2.push_back(8);
+        v1.push_back(9);
+        v1.push_back(10);
+        CHECK_FALSE(v1.is_inline());
+    }
+
+    SECTION("copy assignment")
+    {
+        vector_type v1({1, 2, 3}, alloc1);
+        vector_type v2({4, 5, 6, 7}, alloc2);
+        v1 = v2;
+        CHECK(v1.get_allocator() == alloc2);
+        CHECK(v1 == v2);
+    }
+
+    CHECK(block_owners.empty());
+}
+
+TEST_CASE("small_array_policy tests")
+{
+    std::string input = R"(
+{
+    "type" : "LineString",
+    "coordinates" : [[102.0, 0.0], [103.0, 1.0], [104.0, 0.0], [105.0, 1.0]],
+    "tags" : ["road", "paved", "two-lane"]
+}
+    )";
+
+    SECTION("parse")
+    {
+        small_array_json j = small_array_json::parse(input);
+
+        CHECK(j["coordinates"].size() == 4);
+        CHECK(j["coordinates"][1][0].as<double>() == 103.0);
+        CHECK(j["tags"].size() == 3);
+        CHECK(j["tags"][2].as<std::string>() == "two-lane");
+        CHECK(j.to_string() == json::parse(input).to_string());
+    }
+
+    SECTION("modify")
+    {
+        small_array_ojson j = small_array_ojson::parse(input);
+
+        j["tags"].push_back("lit");
+        j["tags"].erase(j["tags"].array_range().begin());
+        j["coordinates"][0].insert(j["coordinates"][0].array_range().begin(), 1.5);
+
+        CHECK(j["tags"] == small_array_ojson::parse(R"(["paved", "two-lane", "lit"])"));
+        CHECK(j["coordinates"][0] == small_array_ojson::parse("[1.5, 102.0, 0.0]"));
+    }
+
+    SECTION("copy, move and swap")
+    {
+        small_array_json j = small_array_json::parse(input);
+
+        small_array_json copy(j);
+        CHECK(copy == j);
+
+        small_array_json moved(std::move(copy));
+        CHECK(moved == j);
+
+        swap(moved["coordinates"][0], moved["tags"]);
+        CHECK(moved["coordinates"][0].size() == 3);
+        CHECK(moved["tags"].size() == 2);
+    }
+}
+
+TEST_CASE("small_array_policy allocations")
+{
+    using vector_json = basic_json<char,sorted_policy,counting_allocator<char>>;
+    using pair_json = basic_json<char,small_array_policy<sorted_policy,2>,counting_allocator<char>>;
+
+    std::string input = "[[1.5,2.5],[3.5,4.5],[5.5,6.5]]";
+
+    allocation_count = 0;
+    vector_json j1 = vector_json::parse(input);
+    std::size_t vector_count = allocation_count;
+
+    allocation_count = 0;
+    pair_json j2 = pair_json::parse(input);
+    std::size_t pair_count = allocation_count;
+
+    CHECK(j1.size() == 3);
+    CHECK(j2.size() == 3);
+    // One allocation saved for each of the three inner arrays
+    CHECK(vector_count - pair_count == 3);
+}
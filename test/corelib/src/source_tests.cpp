@@ -531,3 +531,38 @@ TEST_CASE("binary_iterator_stream source tests")
         CHECK(source.position() == 9);
     }
 }
+
+TEST_CASE("contiguous sources")
+{
+    CHECK(jsoncons::is_contiguous_source<jsoncons::string_source<char>>::value);
+    CHECK(jsoncons::is_contiguous_source<jsoncons::bytes_source>::value);
+    CHECK_FALSE(jsoncons::is_contiguous_source<jsoncons::stream_source<char>>::value);
+    CHECK_FALSE(jsoncons::is_contiguous_source<jsoncons::binary_stream_source>::value);
+
+    SECTION("read_view refers to the source")
+    {
+        std::vector<uint8_t> data = {'a','b','c','d','e'};
+        jsoncons::bytes_source source(data);
+        std::string buffer;
+        auto s = jsoncons::source_reader<jsoncons::bytes_source>::read_view(source, buffer, 3);
+        CHECK(s.size() == 3);
+        CHECK(reinterpret_cast<const uint8_t*>(s.data()) == data.data());
+        CHECK(buffer.empty());
+        CHECK(source.position() == 3);
+
+        s = jsoncons::source_reader<jsoncons::bytes_source>::read_view(source, buffer, 3);
+        CHECK(s.size() == 2);
+        CHECK(source.eof());
+    }
+
+    SECTION("read_view reads a stream into the buffer")
+    {
+        std::istringstream is("abcde");
+        jsoncons::stream_source<char> source(is, 2);
+        std::string buffer = "xyz";
+        auto s = jsoncons::source_reader<jsoncons::stream_source<char>>::read_view(source, buffer, 4);
+        CHECK(s.size() == 4);
+        CHECK(s.data() == buffer.data());
+        CHECK(buffer == "abcd");
+    }
+}
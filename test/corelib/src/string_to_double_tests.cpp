@@ -9,6 +9,7 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cmath>
 #include <catch/catch.hpp>
 
 using namespace jsoncons;
@@ -53,3 +54,48 @@ TEST_CASE("test_exponent")
 
 }
 
+
+TEST_CASE("test_decimal_to_double")
+{
+    jsoncons::detail::chars_to reader;
+
+    SECTION("matches chars_to")
+    {
+        std::vector<std::string> inputs = {"0","-0.0","1","-1","0.1","1.7976931348623157e308","2.2250738585072014e-308",
+                                           "5e-324","4.9406564584124654e-324","9007199254740993","9007199254740993.000000001",
+                                           "123456789012345678901234567890","0.000000000000000000000000000001234",
+                                           "1234567890123456789012e-22","7.2057594037927933e16","89255.0e-22",
+                                           "2.4703282292062327e-324","1e400","-1e400","1e-400","1E+2","3.14159265358979323846264338327950288"};
+        for (const auto& s : inputs)
+        {
+            double expected = reader(s.c_str(), s.length());
+            double d = 0;
+            if (jsoncons::detail::decimal_to_double(s.data(), s.length(), reader.get_decimal_point(), d))
+            {
+                CHECK(std::signbit(d) == std::signbit(expected));
+                CHECK(d == expected);
+            }
+            json j = json::parse(s);
+            CHECK(std::signbit(j.as<double>()) == std::signbit(expected));
+            CHECK(j.as<double>() == expected);
+        }
+    }
+
+    SECTION("rejects other forms")
+    {
+        std::vector<std::string> inputs = {"","-","1.","-.5",".5","1e","1e+","+1","0x10","1.5f"," 1","nan","inf"};
+        for (const auto& s : inputs)
+        {
+            double d = 0;
+            CHECK_FALSE(jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', d));
+        }
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring s = L"-1.25e-3";
+        double d = 0;
+        REQUIRE(jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', d));
+        CHECK(d == -1.25e-3);
+    }
+}
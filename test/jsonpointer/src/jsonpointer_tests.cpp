@@ -6,6 +6,7 @@
 #endif
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+#include <jsoncons_ext/jsonpointer/json_document_pointer.hpp>
 #include <catch/catch.hpp>
 #include <iostream>
 #include <sstream>
@@ -741,3 +742,38 @@ TEST_CASE("jsonpointer get with stateful allocator")
 }
 
 #endif
+
+TEST_CASE("jsonpointer get with json_document_view")
+{
+    std::string input = R"(
+    {
+       "foo": ["bar", "baz"],
+       "": 0,
+       "a/b": 1,
+       "m~n": 8,
+       "nested": {"list": [{"x": "y"}]}
+    }
+    )";
+    json_document doc = json_document::parse(input);
+    json_document_view root = doc.root();
+
+    CHECK(jsonpointer::get(root, "").is_object());
+    CHECK(jsonpointer::get(root, "/foo/1").as_string_view() == "baz");
+    CHECK(jsonpointer::get(root, "/").as<int>() == 0);
+    CHECK(jsonpointer::get(root, "/a~1b").as<int>() == 1);
+    CHECK(jsonpointer::get(root, "/m~0n").as<int>() == 8);
+    CHECK(jsonpointer::get(root, jsonpointer::json_pointer("/nested/list/0/x")).as<std::string>() == "y");
+    CHECK(jsonpointer::contains(root, "/nested/list/0"));
+    CHECK_FALSE(jsonpointer::contains(root, "/nested/list/1"));
+
+    std::error_code ec;
+    jsonpointer::get(root, "/foo/2", ec);
+    CHECK(ec == jsonpointer::jsonpointer_errc::index_exceeds_array_size);
+    ec = std::error_code();
+    jsonpointer::get(root, "/missing", ec);
+    CHECK(ec == jsonpointer::jsonpointer_errc::key_not_found);
+    ec = std::error_code();
+    jsonpointer::get(root, "/foo/0/x", ec);
+    CHECK(ec == jsonpointer::jsonpointer_errc::expected_object_or_array);
+    CHECK_THROWS_AS(jsonpointer::get(root, "/foo/x"), jsonpointer::jsonpointer_error);
+}
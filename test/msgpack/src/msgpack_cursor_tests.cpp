@@ -386,3 +386,26 @@ TEMPLATE_TEST_CASE("msgpack_cursor reset test", "",
         CHECK(cursor.done());
     }
 }
+
+TEST_CASE("msgpack_bytes_cursor strings refer to the input")
+{
+    json j = json::parse(R"({"name" : "Cobb", "tags" : ["a", "long enough to be a str8, not a fixstr, value"]})");
+    std::vector<uint8_t> data;
+    msgpack::encode_msgpack(j, data);
+
+    msgpack::msgpack_bytes_cursor cursor(data);
+    std::size_t count = 0;
+    for (; !cursor.done(); cursor.next())
+    {
+        const auto& event = cursor.current();
+        if (event.event_type() == staj_event_type::string_value || event.event_type() == staj_event_type::key)
+        {
+            auto sv = event.get<jsoncons::string_view>();
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(sv.data());
+            CHECK(p >= data.data());
+            CHECK(p + sv.size() <= data.data() + data.size());
+            ++count;
+        }
+    }
+    CHECK(count == 5);
+}